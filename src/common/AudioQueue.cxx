@@ -17,42 +17,49 @@
 
 #include "AudioQueue.hxx"
 
-using std::mutex;
-using std::lock_guard;
+#include <thread>
+
+using std::memory_order_relaxed;
+using std::memory_order_acquire;
+using std::memory_order_release;
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 AudioQueue::AudioQueue(uInt32 fragmentSize, uInt32 capacity, bool isStereo)
   : myFragmentSize(fragmentSize),
     myIsStereo(isStereo),
-    myFragmentQueue(capacity),
-    myAllFragments(capacity + 2)
+    myCapacity(capacity),
+    myQueue(capacity),
+    myFreeFragments(capacity + 3)
 {
   const uInt8 sampleSize = myIsStereo ? 2 : 1;
 
-  myFragmentBuffer = make_unique<Int16[]>(myFragmentSize * sampleSize * (capacity + 2));
+  // Besides the queued fragments, the producer and the consumer hold one
+  // fragment each, and the consumer briefly holds a second one while it
+  // returns the played fragment.  All others are free.
+  const uInt32 fragments = capacity + 3;
+
+  myFragmentBuffer = make_unique<Int16[]>(myFragmentSize * sampleSize * fragments);
 
-  for (uInt32 i = 0; i < capacity; ++i)
-    myFragmentQueue[i] = myAllFragments[i] = myFragmentBuffer.get() + i * sampleSize * myFragmentSize;
+  for (uInt32 i = 0; i < fragments - 2; ++i)
+    myFreeFragments.push(myFragmentBuffer.get() + i * sampleSize * myFragmentSize);
 
-  myAllFragments[capacity] = myFirstFragmentForEnqueue =
-    myFragmentBuffer.get() + capacity * sampleSize * myFragmentSize;
+  myFirstFragmentForEnqueue =
+    myFragmentBuffer.get() + (fragments - 2) * sampleSize * myFragmentSize;
 
-  myAllFragments[capacity + 1] = myFirstFragmentForDequeue =
-    myFragmentBuffer.get() + (capacity + 1) * sampleSize * myFragmentSize;
+  myFirstFragmentForDequeue =
+    myFragmentBuffer.get() + (fragments - 1) * sampleSize * myFragmentSize;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 uInt32 AudioQueue::capacity() const
 {
-  return uInt32(myFragmentQueue.size());
+  return myCapacity;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 uInt32 AudioQueue::size()
 {
-  lock_guard<mutex> guard(myMutex);
-
-  return mySize;
+  return myQueue.size();
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -70,8 +77,6 @@ uInt32 AudioQueue::fragmentSize() const
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 Int16* AudioQueue::enqueue(Int16* fragment)
 {
-  lock_guard<mutex> guard(myMutex);
-
   Int16* newFragment;
 
   if (!fragment) {
@@ -83,40 +88,44 @@ Int16* AudioQueue::enqueue(Int16* fragment)
     return newFragment;
   }
 
-  const uInt8 capacity = uInt8(myFragmentQueue.size());
-  const uInt8 fragmentIndex = (myNextFragment + mySize) % capacity;
+  newFragment = nullptr;
 
-  newFragment = myFragmentQueue.at(fragmentIndex);
-  myFragmentQueue.at(fragmentIndex) = fragment;
+  if (!myQueue.push(fragment)) {
+    // The queue is full -> drop the oldest fragment and fill it next. If the
+    // consumer is just taking a fragment, its slot becomes available as soon
+    // as it is done.
+    if (myQueue.pop(newFragment) && !myIgnoreOverflows.load(memory_order_relaxed))
+      myOverflowLogger.log();
 
-  if (mySize < capacity) ++mySize;
-  else {
-    myNextFragment = (myNextFragment + 1) % capacity;
-    if (!myIgnoreOverflows) myOverflowLogger.log();
+    while (!myQueue.push(fragment))
+      std::this_thread::yield();
   }
 
+  if (!newFragment && !myFreeFragments.pop(newFragment))
+    throw runtime_error("no free audio fragment");
+
   return newFragment;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 Int16* AudioQueue::dequeue(Int16* fragment)
 {
-  lock_guard<mutex> guard(myMutex);
+  if (!fragment && !myFirstFragmentForDequeue) {
+    if (myQueue.size() > 0) throw runtime_error("dequeue called empty");
 
-  if (mySize == 0) return nullptr;
+    return nullptr;
+  }
 
-  if (!fragment) {
-    if (!myFirstFragmentForDequeue) throw runtime_error("dequeue called empty");
+  Int16* nextFragment;
+  if (!myQueue.pop(nextFragment)) return nullptr;
 
+  if (!fragment) {
     fragment = myFirstFragmentForDequeue;
     myFirstFragmentForDequeue = nullptr;
   }
 
-  Int16* nextFragment = myFragmentQueue.at(myNextFragment);
-  myFragmentQueue.at(myNextFragment) = fragment;
-
-  --mySize;
-  myNextFragment = (myNextFragment + 1) % myFragmentQueue.size();
+  if (!myFreeFragments.push(fragment))
+    throw runtime_error("audio fragment pool overflow");
 
   return nextFragment;
 }
@@ -124,8 +133,6 @@ Int16* AudioQueue::dequeue(Int16* fragment)
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void AudioQueue::closeSink(Int16* fragment)
 {
-  lock_guard<mutex> guard(myMutex);
-
   if (myFirstFragmentForDequeue && fragment)
     throw runtime_error("attempt to return unknown buffer on closeSink");
 
@@ -136,5 +143,63 @@ void AudioQueue::closeSink(Int16* fragment)
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void AudioQueue::ignoreOverflows(bool shouldIgnoreOverflows)
 {
-  myIgnoreOverflows = shouldIgnoreOverflows;
+  myIgnoreOverflows.store(shouldIgnoreOverflows, memory_order_relaxed);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+AudioQueue::FragmentRing::FragmentRing(uInt32 size)
+  : mySlots(make_unique<Slot[]>(size)),
+    mySize(size)
+{
+  for (uInt32 i = 0; i < size; ++i)
+    mySlots[i].sequence.store(2 * uInt64(i), memory_order_relaxed);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool AudioQueue::FragmentRing::push(Int16* fragment)
+{
+  const uInt64 position = myPushPosition.load(memory_order_relaxed);
+  Slot& slot = mySlots[position % mySize];
+
+  // The fragment of the previous round has not been taken out (yet)
+  if (slot.sequence.load(memory_order_acquire) != 2 * position) return false;
+
+  slot.fragment = fragment;
+  slot.sequence.store(2 * position + 1, memory_order_release);
+  myPushPosition.store(position + 1, memory_order_release);
+
+  return true;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool AudioQueue::FragmentRing::pop(Int16*& fragment)
+{
+  uInt64 position = myPopPosition.load(memory_order_relaxed);
+
+  for (;;) {
+    Slot& slot = mySlots[position % mySize];
+    const uInt64 sequence = slot.sequence.load(memory_order_acquire);
+
+    if (sequence < 2 * position + 1) return false;  // not filled yet -> empty
+
+    if (sequence > 2 * position + 1)
+      // Another thread took this fragment -> try the next one
+      position = myPopPosition.load(memory_order_relaxed);
+    else if (myPopPosition.compare_exchange_weak(position, position + 1,
+                                                 memory_order_relaxed)) {
+      fragment = slot.fragment;
+      slot.sequence.store(2 * (position + mySize), memory_order_release);
+
+      return true;
+    }
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+uInt32 AudioQueue::FragmentRing::size() const
+{
+  const uInt64 popPosition = myPopPosition.load(memory_order_acquire);
+  const uInt64 pushPosition = myPushPosition.load(memory_order_acquire);
+
+  return pushPosition > popPosition ? uInt32(pushPosition - popPosition) : 0;
 }
@@ -18,7 +18,7 @@
 #ifndef AUDIO_QUEUE_HXX
 #define AUDIO_QUEUE_HXX
 
-#include <mutex>
+#include <atomic>
 
 #include "bspf.hxx"
 #include "StaggeredLogger.hxx"
@@ -33,6 +33,15 @@
   The queue needs to be threadsafe as the (SDL) audio driver runs on a
   separate thread. Samples are stored as signed 16 bit integers
   (platform endian).
+
+  There is exactly one producer (the emulation) and one consumer (the
+  sound driver), so the queue is implemented without locks: queued
+  fragments are kept in one ring, and the fragments returned by the
+  consumer in a second ring from which the producer draws. Every slot of
+  a ring carries a sequence number which tells whether it is filled for
+  the current round, so a slot is never refilled before the thread taking
+  a fragment from it has finished. On overflow, the producer drops the
+  oldest fragment by taking it from the ring just like the consumer does.
 */
 class AudioQueue
 {
@@ -96,6 +105,59 @@ class AudioQueue
      */
     void ignoreOverflows(bool shouldIgnoreOverflows);
 
+  private:
+
+    /**
+      A bounded ring of fragment pointers, filled by a single thread and
+      drained by any number of threads.  Each slot carries a sequence
+      number: the slot for position 'pos' may be filled when its number is
+      2 * pos, and holds a fragment when it is 2 * pos + 1.  Taking the
+      fragment out sets it to 2 * (pos + size), the next position using
+      the slot.
+    */
+    class FragmentRing
+    {
+      public:
+        explicit FragmentRing(uInt32 size);
+
+        /**
+          Add a fragment.  Fails if the ring is full, or if the oldest slot
+          is still being emptied by another thread.
+        */
+        bool push(Int16* fragment);
+
+        /**
+          Take the oldest fragment.  Fails if the ring is empty.
+        */
+        bool pop(Int16*& fragment);
+
+        /**
+          The number of fragments in the ring.
+        */
+        uInt32 size() const;
+
+      private:
+        struct Slot {
+          std::atomic<uInt64> sequence{0};
+          Int16* fragment{nullptr};
+        };
+
+        unique_ptr<Slot[]> mySlots;
+        uInt32 mySize{0};
+
+        // Positions of the next push and pop. They live on separate cache
+        // lines to avoid false sharing between the threads.
+        alignas(64) std::atomic<uInt64> myPushPosition{0};
+        alignas(64) std::atomic<uInt64> myPopPosition{0};
+
+      private:
+        FragmentRing() = delete;
+        FragmentRing(const FragmentRing&) = delete;
+        FragmentRing(FragmentRing&&) = delete;
+        FragmentRing& operator=(const FragmentRing&) = delete;
+        FragmentRing& operator=(FragmentRing&&) = delete;
+    };
+
   private:
 
     // The size of an individual fragment (in stereo / mono samples)
@@ -104,31 +166,25 @@ class AudioQueue
     // Are we using stereo samples?
     bool myIsStereo{false};
 
-    // The fragment queue
-    vector<Int16*> myFragmentQueue;
+    // The number of fragments that can be queued
+    uInt32 myCapacity{0};
 
-    // All fragments, including the two fragments that are in circulation.
-    vector<Int16*> myAllFragments;
+    // The queued fragments
+    FragmentRing myQueue;
+
+    // The fragments returned by the consumer, ready to be filled again
+    FragmentRing myFreeFragments;
 
     // We allocate a consecutive slice of memory for the fragments.
     unique_ptr<Int16[]> myFragmentBuffer;
 
-    // The nubmer if queued fragments
-    uInt32 mySize{0};
-
-    // The next fragment.
-    uInt32 myNextFragment{0};
-
-    // We need a mutex for thread safety.
-    std::mutex myMutex;
-
     // The first (empty) enqueue call returns this fragment.
     Int16* myFirstFragmentForEnqueue{nullptr};
     // The first (empty) dequeue call replaces the returned fragment with this fragment.
     Int16* myFirstFragmentForDequeue{nullptr};
 
     // Log overflows?
-    bool myIgnoreOverflows{true};
+    std::atomic<bool> myIgnoreOverflows{true};
 
     StaggeredLogger myOverflowLogger{"audio buffer overflow", Logger::Level::INFO};
 
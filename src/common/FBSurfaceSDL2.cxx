@@ -167,15 +167,35 @@ bool FBSurfaceSDL2::render()
 {
   if (!myBlitter) reinitializeBlitter();
 
+  const uInt32 dirtyTop = myDirtyTop, dirtyBottom = myDirtyBottom;
+
+  // Unless told otherwise, the next render has to upload everything
+  myDirtyTop = 0;
+  myDirtyBottom = UINT32_MAX;
+
   if(myIsVisible && myBlitter)
   {
-    myBlitter->blit(*mySurface);
+    myBlitter->blit(*mySurface, dirtyTop, dirtyBottom);
+    myMissedRender = false;
 
     return true;
   }
+  // The changes of this frame were not uploaded, so they must not get lost
+  myMissedRender = true;
+
   return false;
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void FBSurfaceSDL2::setDirtyRows(uInt32 top, uInt32 bottom)
+{
+  if(!myMissedRender)
+  {
+    myDirtyTop = top;
+    myDirtyBottom = bottom;
+  }
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void FBSurfaceSDL2::invalidate()
 {
@@ -57,6 +57,7 @@ class FBSurfaceSDL2 : public FBSurface
 
     void translateCoords(Int32& x, Int32& y) const override;
     bool render() override;
+    void setDirtyRows(uInt32 top, uInt32 bottom) override;
     void invalidate() override;
     void invalidateRect(uInt32 x, uInt32 y, uInt32 w, uInt32 h) override;
 
@@ -128,6 +129,11 @@ class FBSurfaceSDL2 : public FBSurface
     SDL_Surface* mySurface{nullptr};
     SDL_Rect mySrcR{-1, -1, -1, -1}, myDstR{-1, -1, -1, -1};
 
+    // The rows changed since the last render (see setDirtyRows()), and
+    // whether the last render didn't reach the screen
+    uInt32 myDirtyTop{0}, myDirtyBottom{UINT32_MAX};
+    bool myMissedRender{false};
+
     bool myIsVisible{true};
     bool myIsStatic{false};
 
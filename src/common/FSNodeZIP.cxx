@@ -35,6 +35,8 @@ FilesystemNodeZIP::FilesystemNodeZIP(const string& p)
 
   _zipFile = p.substr(0, pos+4);
 
+  std::lock_guard<std::mutex> lock(myZipMutex);
+
   // Open file at least once to initialize the virtual file count
   try
   {
@@ -132,6 +134,7 @@ bool FilesystemNodeZIP::exists() const
   if(_realNode && _realNode->exists())
   {
     // We need to inspect the actual path, not just the ZIP file itself
+    std::lock_guard<std::mutex> lock(myZipMutex);
     myZipHandler->open(_zipFile);
     while(myZipHandler->hasNext())
       if(BSPF::startsWithIgnoreCase(myZipHandler->next(), _virtualPath))
@@ -149,6 +152,7 @@ bool FilesystemNodeZIP::getChildren(AbstractFSList& myList, ListMode mode) const
     return false;
 
   std::set<string> dirs;
+  std::lock_guard<std::mutex> lock(myZipMutex);
   myZipHandler->open(_zipFile);
   while(myZipHandler->hasNext())
   {
@@ -190,6 +194,7 @@ size_t FilesystemNodeZIP::read(ByteBuffer& image) const
     case zip_error::NO_ROMS:      throw runtime_error("ZIP file doesn't contain any ROMs");
   }
 
+  std::lock_guard<std::mutex> lock(myZipMutex);
   myZipHandler->open(_zipFile);
 
   bool found = false;
@@ -240,5 +245,6 @@ AbstractFSNodePtr FilesystemNodeZIP::getParent() const
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 unique_ptr<ZipHandler> FilesystemNodeZIP::myZipHandler = make_unique<ZipHandler>();
+std::mutex FilesystemNodeZIP::myZipMutex;
 
 #endif  // ZIP_SUPPORT
@@ -20,6 +20,8 @@
 #ifndef FS_NODE_ZIP_HXX
 #define FS_NODE_ZIP_HXX
 
+#include <mutex>
+
 #include "ZipHandler.hxx"
 #include "FSNode.hxx"
 
@@ -107,6 +109,10 @@ class FilesystemNodeZIP : public AbstractFSNode
     // ZipHandler static reference variable responsible for accessing ZIP files
     static unique_ptr<ZipHandler> myZipHandler;
 
+    // The handler is shared, so it may only be used by one thread at a time
+    // (e.g. the ROM scanner's background threads)
+    static std::mutex myZipMutex;
+
     // Get last component of path
     static const char* lastPathComponent(const string& str)
     {
@@ -86,6 +86,11 @@ class LinkedObjectPool
       return idx;
     }
 
+    /**
+      Return an iterator to the node that 'current' points to.
+    */
+    const_iter currentIter() const { return myCurrent; }
+
     /**
       Does the 'current' iterator point to a valid node in the active list?
       This must be called before 'current()' is called.
@@ -149,6 +154,8 @@ class LinkedObjectPool
     /**
       Canonical iterators from C++ STL.
     */
+    iter begin()              { return myList.begin();  }
+    iter end()                { return myList.end();    }
     const_iter cbegin() const { return myList.cbegin(); }
     const_iter cend() const   { return myList.cend();   }
 
@@ -19,6 +19,7 @@
 #define LOGGER_HXX
 
 #include <functional>
+#include <mutex>
 
 #include "bspf.hxx"
 
@@ -61,6 +62,10 @@ class Logger {
     // The list of log messages
     string myLogMessages;
 
+    // Messages may be logged from several threads (emulation worker,
+    // parallel profiling runs)
+    std::mutex myMutex;
+
   private:
     void logMessage(const string& message, Level level);
 
@@ -17,6 +17,12 @@
 
 #include "PhosphorHandler.hxx"
 
+#if defined(BSPF_SIMD_SSE2)
+  #include <emmintrin.h>
+#elif defined(BSPF_SIMD_NEON)
+  #include <arm_neon.h>
+#endif
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 bool PhosphorHandler::initialize(bool enable, int blend)
 {
@@ -41,9 +47,80 @@ bool PhosphorHandler::initialize(bool enable, int blend)
     for(int c = 255; c >= 0; --c)
       for(int p = 255; p >= 0; --p)
         ourPhosphorLUT[c][p] = getPhosphor(uInt8(c), uInt8(p));
+
+    // Look for a fixed point factor, which yields the same decayed values
+    // as the floating point calculation above
+    ourPhosphorFactor = 0;
+    const int approx = static_cast<int>(myPhosphorPercent * 0x10000);
+    for(int factor = std::max(approx - 2, 1);
+        factor <= std::min(approx + 2, 0xffff) && !ourPhosphorFactor; ++factor)
+    {
+      int p = 255;
+      while(p >= 0 && ourPhosphorLUT[0][p] == (p * factor) >> 16)
+        --p;
+      if(p < 0)
+        ourPhosphorFactor = static_cast<uInt16>(factor);
+    }
   }
   return true;
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void PhosphorHandler::getPixels(const uInt32* c, uInt32* p, size_t n)
+{
+  size_t i = 0;
+
+#if defined(BSPF_SIMD_SSE2)
+  if(ourPhosphorFactor)
+  {
+    const __m128i zero = _mm_setzero_si128(),
+                  factor = _mm_set1_epi16(static_cast<Int16>(ourPhosphorFactor)),
+                  rgbMask = _mm_set1_epi32(0x00ffffff);
+
+    for(; i + 4 <= n; i += 4)
+    {
+      const __m128i cur = _mm_loadu_si128(reinterpret_cast<const __m128i*>(c + i)),
+                    prev = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i));
+
+      // Decay all color components of the previous frame...
+      const __m128i decayed = _mm_packus_epi16(
+        _mm_mulhi_epu16(_mm_unpacklo_epi8(prev, zero), factor),
+        _mm_mulhi_epu16(_mm_unpackhi_epi8(prev, zero), factor));
+      // ...and use the maximum of them and the current ones
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(p + i),
+                       _mm_and_si128(_mm_max_epu8(cur, decayed), rgbMask));
+    }
+  }
+#elif defined(BSPF_SIMD_NEON)
+  if(ourPhosphorFactor)
+  {
+    const uint32x4_t rgbMask = vdupq_n_u32(0x00ffffff);
+    const auto decay = [](uint16x8_t v) {
+      return vcombine_u16(
+        vshrn_n_u32(vmull_n_u16(vget_low_u16(v), ourPhosphorFactor), 16),
+        vshrn_n_u32(vmull_n_u16(vget_high_u16(v), ourPhosphorFactor), 16));
+    };
+
+    for(; i + 4 <= n; i += 4)
+    {
+      const uint8x16_t cur = vreinterpretq_u8_u32(vld1q_u32(c + i)),
+                       prev = vreinterpretq_u8_u32(vld1q_u32(p + i));
+
+      // Decay all color components of the previous frame...
+      const uint8x16_t decayed = vcombine_u8(
+        vmovn_u16(decay(vmovl_u8(vget_low_u8(prev)))),
+        vmovn_u16(decay(vmovl_u8(vget_high_u8(prev)))));
+      // ...and use the maximum of them and the current ones
+      vst1q_u32(p + i, vandq_u32(vreinterpretq_u32_u8(vmaxq_u8(cur, decayed)),
+                                 rgbMask));
+    }
+  }
+#endif
+
+  for(; i < n; ++i)
+    p[i] = getPixel(c[i], p[i]);
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 PhosphorHandler::PhosphorLUT PhosphorHandler::ourPhosphorLUT;
+uInt16 PhosphorHandler::ourPhosphorFactor = 0;
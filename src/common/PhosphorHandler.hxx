@@ -52,6 +52,16 @@ class PhosphorHandler
               ourPhosphorLUT[bc][bp];
     }
 
+    /**
+      Does the same as 'getPixel' for a whole row of pixels, using SIMD
+      instructions where available.
+
+      @param c  RGB colors of the current frame
+      @param p  RGB colors of the previous frame, receives the averaged colors
+      @param n  The number of pixels
+    */
+    static void getPixels(const uInt32* c, uInt32* p, size_t n);
+
   private:
     // Use phosphor effect
     bool myUsePhosphor{false};
@@ -63,6 +73,10 @@ class PhosphorHandler
     using PhosphorLUT = BSPF::array2D<uInt8, kColor, kColor>;
     static PhosphorLUT ourPhosphorLUT;
 
+    // Fixed point (0.16) factor which decays a color value exactly like the
+    // LUT does, for the SIMD version of 'getPixels' (0 if there is none)
+    static uInt16 ourPhosphorFactor;
+
   private:
     PhosphorHandler(const PhosphorHandler&) = delete;
     PhosphorHandler(PhosphorHandler&&) = delete;
@@ -16,6 +16,7 @@
 //============================================================================
 
 #include <cmath>
+#include <cstring>
 
 #include "OSystem.hxx"
 #include "Console.hxx"
@@ -41,15 +42,21 @@ void RewindManager::setup()
 
   const string& prefix = myOSystem.settings().getBool("dev.settings") ? "dev." : "plr.";
 
+  myKeyframeInterval = myOSystem.settings().getBool(prefix + "tm.deltas")
+    ? KEYFRAME_INTERVAL : 1;
+
+  // Without deltas, every state is a complete one
+  const uInt32 maxSize = myKeyframeInterval > 1 ? MAX_BUF_SIZE : MAX_KEYFRAME_BUF_SIZE;
+
   // TODO - Add proper bounds checking (define constexpr variables for this)
   //        Use those bounds in DeveloperDialog too
   mySize = std::min<uInt32>(
-      myOSystem.settings().getInt(prefix + "tm.size"), MAX_BUF_SIZE);
+      myOSystem.settings().getInt(prefix + "tm.size"), maxSize);
   if(mySize != myStateList.capacity())
     resize(mySize);
 
   myUncompressed = std::min<uInt32>(
-      myOSystem.settings().getInt(prefix + "tm.uncompressed"), MAX_BUF_SIZE);
+      myOSystem.settings().getInt(prefix + "tm.uncompressed"), maxSize);
 
   myInterval = INTERVAL_CYCLES[0];
   for(int i = 0; i < NUM_INTERVALS; ++i)
@@ -118,6 +125,10 @@ bool RewindManager::addState(const string& message, bool timeMachine)
       return false;
   }
 
+  Serializer s;
+  if(!myStateManager.saveState(s) || !myOSystem.console().tia().saveDisplay(s))
+    return false;
+
   // Remove all future states
   myStateList.removeToLast();
 
@@ -129,17 +140,12 @@ bool RewindManager::addState(const string& message, bool timeMachine)
   // This updates the 'current' iterator inside the list
   myStateList.addLast();
   RewindState& state = myStateList.current();
-  Serializer& s = state.data;
 
-  s.rewind();  // rewind Serializer internal buffers
-  if(myStateManager.saveState(s) && myOSystem.console().tia().saveDisplay(s))
-  {
-    state.message = message;
-    state.cycles = myOSystem.console().tia().cycles();
-    myLastTimeMachineAdd = timeMachine;
-    return true;
-  }
-  return false;
+  state.message = message;
+  state.cycles = myOSystem.console().tia().cycles();
+  storeState(std::prev(myStateList.end()), s.data(), uInt32(s.size()));
+  myLastTimeMachineAdd = timeMachine;
+  return true;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -161,10 +167,6 @@ uInt32 RewindManager::rewindStates(uInt32 numStates)
         // ...except when the last state was added automatically,
         // because that already happened one interval before
         myLastTimeMachineAdd = false;
-
-      RewindState& state = myStateList.current();
-      Serializer& s = state.data;
-      s.rewind();  // rewind Serializer internal buffers
     }
     else
       break;
@@ -196,10 +198,6 @@ uInt32 RewindManager::unwindStates(uInt32 numStates)
       // Set internal current iterator to nextCycles state (forward in time),
       // since we will now process this state
       myStateList.moveToNext();
-
-      RewindState& state = myStateList.current();
-      Serializer& s = state.data;
-      s.rewind();  // rewind Serializer internal buffers
     }
     else
       break;
@@ -243,37 +241,22 @@ string RewindManager::saveAllStates()
     if (!out)
       return "Can't save to all states file";
 
-    uInt32 curIdx = getCurrentIdx();
-    rewindStates(MAX_BUF_SIZE);
-    uInt32 numStates = uInt32(cyclesList().size());
+    uInt32 numStates = myStateList.size();
 
     // Save header
     buf.str("");
     out.putString(STATE_HEADER);
     out.putShort(numStates);
 
-    for (uInt32 i = 0; i < numStates; ++i)
+    for(auto it = myStateList.cbegin(); it != myStateList.cend(); ++it)
     {
-      RewindState& state = myStateList.current();
-      Serializer& s = state.data;
-      uInt32 stateSize = uInt32(s.size());
-      unique_ptr<uInt8[]> buffer = make_unique<uInt8[]>(stateSize);
-
-      out.putInt(stateSize);
-
-      // Rewind Serializer internal buffers
-      s.rewind();
-
       // Save state
-      s.getByteArray(buffer.get(), stateSize);
-      out.putByteArray(buffer.get(), stateSize);
-      out.putString(state.message);
-      out.putLong(state.cycles);
-
-      unwindStates(1);
+      const ByteArray& data = decodeState(it);
+      out.putInt(uInt32(data.size()));
+      out.putByteArray(data.data(), data.size());
+      out.putString(it->message);
+      out.putLong(it->cycles);
     }
-    // restore old state position
-    rewindStates(numStates - curIdx);
 
     buf.str("");
     buf << "Saved " << numStates << " states";
@@ -302,6 +285,7 @@ string RewindManager::loadAllStates()
 
     clear();
     uInt32 numStates;
+    ByteArray data;
 
     // Load header
     buf.str("");
@@ -316,22 +300,18 @@ string RewindManager::loadAllStates()
         compressStates();
 
       uInt32 stateSize = in.getInt();
-      unique_ptr<uInt8[]> buffer = make_unique<uInt8[]>(stateSize);
+      data.resize(stateSize);
+      in.getByteArray(data.data(), stateSize);
 
       // Add new state at the end of the list (queue adds at end)
       // This updates the 'current' iterator inside the list
       myStateList.addLast();
       RewindState& state = myStateList.current();
-      Serializer& s = state.data;
-
-      // Rewind Serializer internal buffers
-      s.rewind();
 
       // Fill new state with saved values
-      in.getByteArray(buffer.get(), stateSize);
-      s.putByteArray(buffer.get(), stateSize);
       state.message = in.getString();
       state.cycles = in.getLong();
+      storeState(std::prev(myStateList.end()), data.data(), stateSize);
     }
 
     // initialize current state (parameters ignored)
@@ -354,13 +334,13 @@ void RewindManager::compressStates()
   double maxError = 1.5;
   uInt32 idx = myStateList.size() - 2;
   // in case maxError is <= 1.5 remove first state by default:
-  Common::LinkedObjectPool<RewindState>::const_iter removeIter = myStateList.first();
+  StateIter removeIter = myStateList.begin();
   /*if(myUncompressed < mySize)
     //  if compression is enabled, the first but one state is removed by default:
     removeIter++;*/
 
   // iterate from last but one to first but one
-  for(auto it = myStateList.previous(myStateList.last()); it != myStateList.first(); --it)
+  for(auto it = std::prev(myStateList.end(), 2); it != myStateList.begin(); --it)
   {
     if(idx < mySize - myUncompressed)
     {
@@ -378,15 +358,18 @@ void RewindManager::compressStates()
     }
     --idx;
   }
-   myStateList.remove(removeIter); // remove
+  removeState(removeIter);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 string RewindManager::loadState(Int64 startCycles, uInt32 numStates)
 {
   RewindState& state = myStateList.current();
-  Serializer& s = state.data;
+  const ByteArray& data = decodeState(myStateList.currentIter());
+  Serializer s;
 
+  s.putByteArray(data.data(), data.size());
+  s.rewind();  // rewind Serializer internal buffers
   myStateManager.loadState(s);
   myOSystem.console().tia().loadDisplay(s);
 
@@ -472,3 +455,313 @@ IntArray RewindManager::cyclesList() const
 
   return arr;
 }
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void RewindManager::removeState(StateIter it)
+{
+  const StateIter next = std::next(it);
+
+  if(next != myStateList.end() && !next->keyframe)
+  {
+    // The next state is a delta to the removed one.  Combining both
+    // results in the next state's data (removed keyframe) or in its XOR
+    // mask to the new previous state, without decoding any state.
+    const uInt8* const removed = myArena.data() + it->offset;
+    bool keyframe = it->keyframe;
+    const uInt32 size = next->size;
+
+    if(keyframe)
+      myScratch.assign(removed, removed + size);
+    else
+    {
+      myScratch.assign(size, 0);
+      applyDelta(removed, it->encodedSize, myScratch.data());
+    }
+    applyDelta(myArena.data() + next->offset, next->encodedSize, myScratch.data());
+    myStateList.remove(it);
+
+    // The old delta must not be used for decoding anymore
+    next->id = ++myLastId;
+    next->encodedSize = 0;
+
+    if(keyframe && !keyframeRequired(next) &&
+       myStateList.previous(next)->size == size)
+    {
+      // Convert the data into the mask to the new previous state
+      xorState(myScratch, decodeState(myStateList.previous(next)));
+      keyframe = false;
+    }
+    if(!keyframe && !storeDelta(next, myScratch.data(), size))
+    {
+      // The delta is too large, convert the mask back into the data
+      xorState(myScratch, decodeState(myStateList.previous(next)));
+      keyframe = true;
+    }
+    if(keyframe)
+      storeKeyframe(next, myScratch.data(), size);
+  }
+  else
+    myStateList.remove(it);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void RewindManager::storeState(StateIter it, const uInt8* data, uInt32 size)
+{
+  // The old data of the state is not required anymore, a new id makes
+  // sure that it is not used for decoding either
+  it->id = ++myLastId;
+  it->encodedSize = 0;
+
+  bool keyframe = keyframeRequired(it) || myStateList.previous(it)->size != size;
+
+  if(!keyframe)
+  {
+    const ByteArray& from = decodeState(myStateList.previous(it));
+
+    myScratch.resize(size);
+    for(uInt32 i = 0; i < size; ++i)
+      myScratch[i] = from[i] ^ data[i];
+    keyframe = !storeDelta(it, myScratch.data(), size);
+  }
+
+  // The stored state is most likely the next one to be used for a delta.
+  // The previous state is still decoded, so for a delta applying it is
+  // cheaper than copying the complete state.
+  if(keyframe)
+  {
+    storeKeyframe(it, data, size);
+    myDecoded.assign(data, data + size);
+  }
+  else
+    applyDelta(myArena.data() + it->offset, it->encodedSize, myDecoded.data());
+  myDecodedId = it->id;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool RewindManager::keyframeRequired(ConstStateIter it) const
+{
+  if(it == myStateList.cbegin() || myKeyframeInterval <= 1)
+    return true;
+
+  // Limit the number of deltas to apply when decoding a state
+  uInt32 deltas = 1;
+
+  for(auto k = myStateList.previous(it); !k->keyframe; --k)
+    ++deltas;
+
+  return deltas >= myKeyframeInterval;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void RewindManager::storeKeyframe(StateIter it, const uInt8* data, uInt32 size)
+{
+  const size_t offset = reserveArena(size);
+
+  std::copy_n(data, size, myArena.data() + offset);
+  myArenaUsed = offset + size;
+
+  it->offset = offset;
+  it->encodedSize = size;
+  it->size = size;
+  it->keyframe = true;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool RewindManager::storeDelta(StateIter it, const uInt8* mask, uInt32 size)
+{
+  // Deltas larger than half a state are not worth the decoding effort
+  const uInt32 limit = size / 2;
+  const size_t offset = reserveArena(limit);
+  uInt32 encodedSize = 0;
+
+  if(!encodeDelta(mask, size, myArena.data() + offset, limit, encodedSize))
+    return false;
+
+  myArenaUsed = offset + encodedSize;
+
+  it->offset = offset;
+  it->encodedSize = encodedSize;
+  it->size = size;
+  it->keyframe = false;
+
+  return true;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+const ByteArray& RewindManager::decodeState(ConstStateIter it)
+{
+  if(it->id == myDecodedId)
+    return myDecoded;
+
+  const ConstStateIter next = myStateList.next(it);
+
+  if(next != myStateList.cend() && next->id == myDecodedId && !next->keyframe)
+  {
+    // The next state is decoded already, applying its delta gets us back
+    applyDelta(myArena.data() + next->offset, next->encodedSize, myDecoded.data());
+  }
+  else
+  {
+    // Start at the previous keyframe, or at an already decoded state in between
+    ConstStateIter k = it;
+
+    while(!k->keyframe && k->id != myDecodedId)
+      --k;
+    if(k->id != myDecodedId)
+      myDecoded.assign(myArena.data() + k->offset,
+                       myArena.data() + k->offset + k->size);
+    while(k != it)
+    {
+      ++k;
+      applyDelta(myArena.data() + k->offset, k->encodedSize, myDecoded.data());
+    }
+  }
+  myDecodedId = it->id;
+
+  return myDecoded;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+size_t RewindManager::reserveArena(size_t size)
+{
+  if(myArenaUsed + size > myArena.size())
+  {
+    compactArena();
+
+    // Keep some headroom, so that compacting does not happen too often
+    if(myArenaUsed + size > myArena.size() - myArena.size() / 4)
+      myArena.resize((myArenaUsed + size) * 3 / 2);
+  }
+  return myArenaUsed;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void RewindManager::compactArena()
+{
+  vector<RewindState*> states;
+
+  for(auto& state: myStateList)
+    if(state.encodedSize)
+      states.push_back(&state);
+
+  // Moving the data in arena order never overwrites data still to be moved
+  std::sort(states.begin(), states.end(),
+            [](const RewindState* a, const RewindState* b) {
+              return a->offset < b->offset;
+            });
+
+  myArenaUsed = 0;
+  for(auto state: states)
+  {
+    if(state->offset != myArenaUsed)
+      std::memmove(myArena.data() + myArenaUsed, myArena.data() + state->offset,
+                   state->encodedSize);
+    state->offset = myArenaUsed;
+    myArenaUsed += state->encodedSize;
+  }
+}
+
+namespace {
+  // Shorter runs of unchanged bytes are not worth a new delta block
+  constexpr uInt32 MIN_SKIP = 4;
+
+  inline void writeLength(uInt8*& out, uInt32 length)
+  {
+    while(length >= 0x80)
+    {
+      *out++ = uInt8(length | 0x80);
+      length >>= 7;
+    }
+    *out++ = uInt8(length);
+  }
+
+  inline uInt32 readLength(const uInt8*& in)
+  {
+    uInt32 length = 0;
+
+    for(uInt32 shift = 0; ; shift += 7)
+    {
+      const uInt8 b = *in++;
+
+      length |= uInt32(b & 0x7f) << shift;
+      if(!(b & 0x80))
+        return length;
+    }
+  }
+
+  inline uInt64 load64(const uInt8* p)
+  {
+    uInt64 value;
+
+    std::memcpy(&value, p, sizeof(value));
+    return value;
+  }
+}  // namespace
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool RewindManager::encodeDelta(const uInt8* mask, uInt32 size, uInt8* out,
+                                uInt32 limit, uInt32& encodedSize)
+{
+  // Each block consists of the number of unchanged bytes to skip, the
+  // number of changed bytes and the changed bytes of the mask
+  const uInt8* const start = out;
+  uInt32 pos = 0;
+
+  while(pos < size)
+  {
+    const uInt32 skipStart = pos;
+
+    while(pos + 8 <= size && load64(mask + pos) == 0)
+      pos += 8;
+    while(pos < size && mask[pos] == 0)
+      ++pos;
+    if(pos == size)
+      break;  // no block required for unchanged bytes at the end
+
+    // Short runs of unchanged bytes become part of the block
+    const uInt32 changedStart = pos;
+    uInt32 changedEnd = pos;
+
+    while(pos < size && pos - changedEnd < MIN_SKIP)
+    {
+      if(mask[pos] != 0)
+        changedEnd = pos + 1;
+      ++pos;
+    }
+    pos = changedEnd;
+
+    // Two lengths take up to 5 bytes each
+    const uInt32 changed = changedEnd - changedStart;
+    if(uInt32(out - start) + 10 + changed > limit)
+      return false;
+
+    writeLength(out, changedStart - skipStart);
+    writeLength(out, changed);
+    std::copy_n(mask + changedStart, changed, out);
+    out += changed;
+  }
+  encodedSize = uInt32(out - start);
+
+  return true;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void RewindManager::xorState(ByteArray& data, const ByteArray& other)
+{
+  for(size_t i = 0; i < data.size(); ++i)
+    data[i] ^= other[i];
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void RewindManager::applyDelta(const uInt8* delta, uInt32 deltaSize, uInt8* data)
+{
+  const uInt8* const end = delta + deltaSize;
+
+  while(delta < end)
+  {
+    data += readLength(delta);
+
+    for(uInt32 changed = readLength(delta); changed > 0; --changed)
+      *data++ ^= *delta++;
+  }
+}
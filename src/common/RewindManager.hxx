@@ -41,6 +41,12 @@ class StateManager;
   If the list is full, states are either removed at the beginning (compression
   off) or at selective positions (compression on).
 
+  The serialized states are kept in a single contiguous arena.  Every
+  KEYFRAME_INTERVAL states a complete state (keyframe) is stored, the states
+  in between are stored as run-length encoded XOR deltas to their previous
+  state.  Since XOR deltas can be applied in both directions, stepping
+  through the list from a decoded state only costs a single delta.
+
   @author  Stephen Anthony
 */
 class RewindManager
@@ -49,7 +55,11 @@ class RewindManager
     RewindManager(OSystem& system, StateManager& statemgr);
 
   public:
-    static constexpr uInt32 MAX_BUF_SIZE = 1000;
+    // maximum number of states, and when storing keyframes only
+    static constexpr uInt32 MAX_BUF_SIZE = 10000;
+    static constexpr uInt32 MAX_KEYFRAME_BUF_SIZE = 1000;
+    // maximum number of delta states between two keyframes
+    static constexpr uInt32 KEYFRAME_INTERVAL = 60;
     static constexpr int NUM_INTERVALS = 7;
     // cycle values for the intervals
     const std::array<uInt32, NUM_INTERVALS> INTERVAL_CYCLES = {
@@ -142,9 +152,13 @@ class RewindManager
 
     bool atFirst() const { return myStateList.atFirst(); }
     bool atLast() const  { return myStateList.atLast();  }
-    void resize(uInt32 size) { myStateList.resize(size); }
+    void resize(uInt32 size) {
+      myStateList.resize(size);
+      clearArena();
+    }
     void clear() {
       myStateList.clear();
+      clearArena();
     }
 
     /**
@@ -175,11 +189,16 @@ class RewindManager
     uInt64 myHorizon{0};
     double myFactor{0.0};
     bool   myLastTimeMachineAdd{false};
+    uInt32 myKeyframeInterval{1};
 
     struct RewindState {
-      Serializer data;  // actual save state
-      string message;   // describes save state origin
-      uInt64 cycles{0}; // cycles since emulation started
+      string message;         // describes save state origin
+      uInt64 cycles{0};       // cycles since emulation started
+      uInt64 id{0};           // unique id of the stored data
+      size_t offset{0};       // position of the stored data in the arena
+      uInt32 encodedSize{0};  // size of the stored data in the arena
+      uInt32 size{0};         // size of the actual save state
+      bool keyframe{true};    // complete state or delta to the previous one
 
       // We do nothing on object instantiation or copy
       // The goal of LinkedObjectPool is to not do any allocations at all
@@ -196,12 +215,120 @@ class RewindManager
     // The linked-list to store states (internally it takes care of reducing
     // frequent (de)-allocations)
     Common::LinkedObjectPool<RewindState> myStateList;
+    using StateIter = Common::LinkedObjectPool<RewindState>::iter;
+    using ConstStateIter = Common::LinkedObjectPool<RewindState>::const_iter;
+
+    // Contiguous storage for the (encoded) data of all states in the list
+    ByteArray myArena;
+    size_t myArenaUsed{0};
+
+    // The most recently decoded state, identified by its id (0 = none)
+    ByteArray myDecoded;
+    uInt64 myDecodedId{0};
+    uInt64 myLastId{0};
+
+    // Temporary state data or XOR mask while encoding a state
+    ByteArray myScratch;
 
     /**
       Remove a save state from the list
     */
     void compressStates();
 
+    /**
+      Remove the given state from the list.  If the following state is
+      stored as a delta to the removed one, it is encoded again.
+    */
+    void removeState(StateIter it);
+
+    /**
+      Store the data of a state in the arena, either as a keyframe or as
+      delta to the previous state in the list.
+
+      @param it    The state to store the data for
+      @param data  The serialized state data
+      @param size  The size of the data
+    */
+    void storeState(StateIter it, const uInt8* data, uInt32 size);
+
+    /**
+      Answer whether the given state has to be stored as a keyframe, to
+      limit the number of deltas to apply when decoding.
+    */
+    bool keyframeRequired(ConstStateIter it) const;
+
+    /**
+      Store the complete data of a state in the arena.
+    */
+    void storeKeyframe(StateIter it, const uInt8* data, uInt32 size);
+
+    /**
+      Store the XOR mask between a state and its previous state in the arena.
+
+      @return  False if the encoded mask is too large to be worth it
+    */
+    bool storeDelta(StateIter it, const uInt8* mask, uInt32 size);
+
+    /**
+      Reconstruct the serialized data of a state.
+
+      @param it  The state to decode
+      @return    The serialized data, valid until the next call
+    */
+    const ByteArray& decodeState(ConstStateIter it);
+
+    /**
+      Make sure the arena has room for the given number of bytes, compacting
+      or growing it if necessary.
+
+      @param size  The number of bytes required
+      @return      The arena offset of the reserved space
+    */
+    size_t reserveArena(size_t size);
+
+    /**
+      Move the data of all states to the beginning of the arena, dropping
+      the data of removed states.
+    */
+    void compactArena();
+
+    /**
+      Discard all data in the arena.
+    */
+    void clearArena() {
+      myArenaUsed = 0;
+      myDecodedId = 0;
+    }
+
+    /**
+      Encode the XOR mask between two states as delta, with runs of
+      unchanged (zero) bytes skipped.
+
+      @param mask         The XOR mask of both states
+      @param size         The size of the mask
+      @param out          The output buffer, at least 'limit' bytes large
+      @param limit        The maximum size of the encoded delta
+      @param encodedSize  The resulting size of the encoded delta
+      @return             False if the delta would exceed the limit
+    */
+    static bool encodeDelta(const uInt8* mask, uInt32 size, uInt8* out,
+                            uInt32 limit, uInt32& encodedSize);
+
+    /**
+      XOR the data of an equally sized state into another one.
+    */
+    static void xorState(ByteArray& data, const ByteArray& other);
+
+    /**
+      Apply an encoded XOR delta to a state.  This converts the previous
+      state into the new one and vice versa.
+
+      @param delta      The encoded delta
+      @param deltaSize  The size of the encoded delta
+      @param data       The state data to modify
+    */
+    static void applyDelta(const uInt8* delta, uInt32 deltaSize, uInt8* data);
+
     /**
       Load the current state and get the message string for the rewind/unwind
 
@@ -0,0 +1,69 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2020 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+
+#include "Cart.hxx"
+#include "Control.hxx"
+#include "Logger.hxx"
+#include "RunAheadManager.hxx"
+#include "Switches.hxx"
+
+#include "RunAheadInstance.hxx"
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+RunAheadInstance::RunAheadInstance(ConsoleIO& io,
+                                   const TIA::ConsoleTimingProvider& timing,
+                                   Settings& settings, unique_ptr<Cartridge>& cart)
+  : myIO(io),
+    myCart(std::move(cart)),
+    myM6502(settings),
+    myM6532(*this, settings),
+    myTIA(*this, timing, settings),
+    mySystem(myRandom, myM6502, myM6532, myTIA, *myCart)
+{
+  myTIA.setFrameManager(&myFrameManager);
+  myCart->setStartBankFromPropsFunc([]() { return -1; });
+  mySystem.initialize();
+  mySystem.reset();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool RunAheadInstance::runAhead(const System& system, uInt32 frames)
+{
+  myState.rewind();
+  myInputState.rewind();
+  if(!(system.save(myState) &&
+       myIO.leftController().save(myInputState) &&
+       myIO.rightController().save(myInputState) &&
+       myIO.switches().save(myInputState)))
+    return false;
+
+  myState.rewind();
+  const bool success = mySystem.load(myState) &&
+                       RunAheadManager::emulateFrames(myTIA, frames);
+
+  myInputState.rewind();
+  if(!(myIO.leftController().load(myInputState) &&
+       myIO.rightController().load(myInputState) &&
+       myIO.switches().load(myInputState)))
+  {
+    Logger::error("ERROR: Run-ahead failed to restore the controllers");
+    return false;
+  }
+
+  return success;
+}
@@ -0,0 +1,98 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2020 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+
+#ifndef RUNAHEAD_INSTANCE_HXX
+#define RUNAHEAD_INSTANCE_HXX
+
+class Cartridge;
+class Settings;
+
+#include "bspf.hxx"
+#include "ConsoleIO.hxx"
+#include "frame-manager/FrameManager.hxx"
+#include "M6502.hxx"
+#include "M6532.hxx"
+#include "Random.hxx"
+#include "Serializer.hxx"
+#include "System.hxx"
+#include "TIA.hxx"
+
+/**
+  A minimal second system used for run-ahead, consisting of its own copy of
+  the cartridge and the chips only.  Controllers and switches are those of
+  the console, so the instance always sees the current input.  Since these
+  are changed by the run-ahead frames too (e.g. the EEPROM of a SaveKey),
+  their state is restored afterwards.
+*/
+class RunAheadInstance : public ConsoleIO
+{
+  public:
+    /**
+      Create a new instance.
+
+      @param io        The console providing the controllers and switches
+      @param timing    Provides the timing of the console
+      @param settings  The settings to use for the chips
+      @param cart      The copy of the cartridge, owned by the instance
+    */
+    RunAheadInstance(ConsoleIO& io, const TIA::ConsoleTimingProvider& timing,
+                     Settings& settings, unique_ptr<Cartridge>& cart);
+    ~RunAheadInstance() override = default;
+
+    Controller& leftController() const override { return myIO.leftController(); }
+    Controller& rightController() const override { return myIO.rightController(); }
+    Switches& switches() const override { return myIO.switches(); }
+
+    /**
+      Load the state of the given system and emulate the given number of
+      frames, leaving the console's controllers and switches as they were.
+
+      @param system  The system of the console
+      @param frames  The number of frames to run ahead
+
+      @return  False if loading the state or the emulation failed
+    */
+    bool runAhead(const System& system, uInt32 frames);
+
+    TIA& tia() { return myTIA; }
+
+  private:
+    ConsoleIO& myIO;
+    unique_ptr<Cartridge> myCart;
+
+    Random myRandom{0};
+    M6502 myM6502;
+    M6532 myM6532;
+    TIA myTIA;
+    FrameManager myFrameManager;
+    System mySystem;
+
+    // Buffers for the state of the console's system, and of its controllers
+    // and switches
+    Serializer myState, myInputState;
+
+  private:
+    // Following constructors and assignment operators not supported
+    RunAheadInstance() = delete;
+    RunAheadInstance(const RunAheadInstance&) = delete;
+    RunAheadInstance(RunAheadInstance&&) = delete;
+    RunAheadInstance& operator=(const RunAheadInstance&) = delete;
+    RunAheadInstance& operator=(RunAheadInstance&&) = delete;
+};
+
+#endif
@@ -0,0 +1,157 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2020 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+
+#include "OSystem.hxx"
+#include "Settings.hxx"
+#include "Console.hxx"
+#include "Cart.hxx"
+#include "CartCreator.hxx"
+#include "DispatchResult.hxx"
+#include "Logger.hxx"
+#include "Props.hxx"
+#include "RunAheadInstance.hxx"
+#include "TIA.hxx"
+
+#include "RunAheadManager.hxx"
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+RunAheadManager::RunAheadManager(OSystem& system)
+  : myOSystem(system)
+{
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+RunAheadManager::~RunAheadManager()
+{
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void RunAheadManager::reset()
+{
+  const Settings& settings = myOSystem.settings();
+
+  myFrames = BSPF::clamp(settings.getInt("runahead"), 0, Int32(MAX_FRAMES));
+  myUseInstance = settings.getBool("runahead.second");
+  myInstance.reset();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool RunAheadManager::renderFrame()
+{
+  if(!enabled() || !myOSystem.hasConsole())
+    return false;
+
+  if(myUseInstance && !myInstance)
+  {
+    // Multicarts are created from a slice of the image selected by a counter
+    // in the settings, so their cartridge cannot simply be created again
+    const Console& console = myOSystem.console();
+    const Cartridge& original = console.cartridge();
+    unique_ptr<Cartridge> cart;
+
+    try
+    {
+      if(original.multiCartID() == EmptyString)
+      {
+        size_t size = 0;
+        const RomImage& image = original.getImage(size);
+        string md5 = console.properties().get(PropType::Cart_MD5);
+
+        cart = CartCreator::create(myOSystem.romFile(), image, size, md5,
+                                   original.detectedType(), myOSystem.settings());
+      }
+    }
+    catch(const runtime_error&)
+    {
+    }
+
+    if(cart)
+      myInstance = make_unique<RunAheadInstance>(myOSystem.console(),
+          [&osystem = myOSystem]() { return osystem.console().timing(); },
+          myOSystem.settings(), cart);
+    else
+    {
+      Logger::info("Run-ahead: second instance not supported for this ROM");
+      myUseInstance = false;
+    }
+  }
+
+  return myInstance ? renderWithInstance() : renderWithConsole();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool RunAheadManager::renderWithConsole()
+{
+  Console& console = myOSystem.console();
+  TIA& tia = console.tia();
+
+  myState.rewind();
+  if(!console.save(myState))
+    return false;
+
+  // The run-ahead frames are rolled back, so they must not be heard
+  tia.suspendAudio(true);
+  const bool success = emulateFrames(tia, myFrames);
+  tia.suspendAudio(false);
+
+  if(success)
+    tia.renderToFrameBuffer();
+
+  myState.rewind();
+  if(!console.load(myState))
+  {
+    Logger::error("ERROR: Run-ahead failed to restore the console state");
+    return false;
+  }
+
+  return success;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool RunAheadManager::renderWithInstance()
+{
+  if(!myInstance->runAhead(myOSystem.console().system(), myFrames))
+    return false;
+
+  myOSystem.console().tia().renderToFrameBuffer(myInstance->tia());
+
+  return true;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool RunAheadManager::emulateFrames(TIA& tia, uInt32 frames)
+{
+  // Each update ends with a new frame at the latest, but give up if
+  // the ROM doesn't generate any frames at all
+  static constexpr uInt32 MAX_UPDATES_PER_FRAME = 4;
+
+  DispatchResult result;
+  const uInt32 start = tia.framesSinceLastRender();
+
+  for(uInt32 i = 0; i < frames * MAX_UPDATES_PER_FRAME; ++i)
+  {
+    tia.update(result);
+    if(!result.isSuccess())
+      return false;
+
+    if(tia.framesSinceLastRender() - start >= frames)
+      return true;
+  }
+
+  return false;
+}
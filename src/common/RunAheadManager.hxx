@@ -0,0 +1,109 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2020 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+
+#ifndef RUNAHEAD_MANAGER_HXX
+#define RUNAHEAD_MANAGER_HXX
+
+class OSystem;
+class RunAheadInstance;
+class TIA;
+
+#include "bspf.hxx"
+#include "Serializer.hxx"
+
+/**
+  This class implements run-ahead, which hides (part of) the input latency
+  of games that only react to the controllers a few frames later.
+
+  Whenever a frame has to be displayed, the console is emulated the given
+  number of frames ahead, using the current controller state, and the last
+  of these frames is shown instead of the console's own one.  Afterwards
+  the console continues from where it was, so the run-ahead frames never
+  influence the actual emulation.
+
+  By default, the console itself is saved, run ahead (with its audio
+  suspended) and restored again.  Alternatively a second, private instance
+  of the system can be used: it is loaded with the console's state before
+  running ahead, and the console itself is never touched.
+*/
+class RunAheadManager
+{
+  public:
+    explicit RunAheadManager(OSystem& system);
+    ~RunAheadManager();
+
+    static constexpr uInt32 MAX_FRAMES = 4;
+
+  public:
+    /**
+      Read the settings and drop the second instance.  Must be called
+      whenever a new console has been created.
+    */
+    void reset();
+
+    /**
+      Answers whether run-ahead is enabled.
+    */
+    bool enabled() const { return myFrames > 0; }
+
+    /**
+      Emulate the configured number of frames ahead and render the last
+      one to the console's TIA frame buffer.
+
+      @return  False if run-ahead is disabled or failed; the caller must
+               render the console's own frame then
+    */
+    bool renderFrame();
+
+    /**
+      Emulate the given TIA until the given number of new frames have been
+      completed.
+
+      @return  False if the emulation failed or didn't complete the frames
+    */
+    static bool emulateFrames(TIA& tia, uInt32 frames);
+
+  private:
+    bool renderWithConsole();
+    bool renderWithInstance();
+
+  private:
+    OSystem& myOSystem;
+
+    // Number of frames to run ahead (0 disables run-ahead)
+    uInt32 myFrames{0};
+
+    // Use a second instance instead of the console itself
+    bool myUseInstance{false};
+
+    // The second instance, created when first needed
+    unique_ptr<RunAheadInstance> myInstance;
+
+    // Buffer for the state the console is restored to
+    Serializer myState;
+
+  private:
+    // Following constructors and assignment operators not supported
+    RunAheadManager() = delete;
+    RunAheadManager(const RunAheadManager&) = delete;
+    RunAheadManager(RunAheadManager&&) = delete;
+    RunAheadManager& operator=(const RunAheadManager&) = delete;
+    RunAheadManager& operator=(RunAheadManager&&) = delete;
+};
+
+#endif
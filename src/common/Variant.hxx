@@ -35,9 +35,10 @@ class Variant
     // Underlying data store is (currently) always a string
     string data;
 
-    // Use singleton so we use only one ostringstream object
+    // Use singleton so we use only one ostringstream object (per thread,
+    // since settings may be accessed by concurrently running consoles)
     static ostringstream& buf() {
-      static ostringstream buf;
+      static thread_local ostringstream buf;
       return buf;
     }
 
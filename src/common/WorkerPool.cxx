@@ -0,0 +1,134 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2020 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+#if defined(BSPF_WINDOWS)
+  #include "Windows.hxx"
+#elif defined(__linux__)
+  #include <pthread.h>
+  #include <sched.h>
+#endif
+
+#include "WorkerPool.hxx"
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+WorkerPool::~WorkerPool()
+{
+  stop();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void WorkerPool::setup(uInt32 numThreads, bool pinThreads)
+{
+  stop();
+
+  const uInt32 cores = std::max(1U, std::thread::hardware_concurrency());
+
+  for(uInt32 slice = 1; slice < numThreads; ++slice)
+  {
+    myWorkers.emplace_back(&WorkerPool::threadMain, this, slice, numThreads,
+                           myGeneration);
+
+    // Core 0 is left to the main thread
+    if(pinThreads)
+      pinThread(myWorkers.back(), slice % cores);
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void WorkerPool::run(const Job& job)
+{
+  if(myWorkers.empty())
+  {
+    job(0, 1);
+    return;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(myMutex);
+
+    myJob = &job;
+    myPending = uInt32(myWorkers.size());
+    ++myGeneration;
+  }
+  myStartCondition.notify_all();
+
+  // Make the calling thread busy too
+  job(0, numThreads());
+
+  std::unique_lock<std::mutex> lock(myMutex);
+  myDoneCondition.wait(lock, [this] { return myPending == 0; });
+  myJob = nullptr;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void WorkerPool::threadMain(uInt32 slice, uInt32 numSlices, uInt64 generation)
+{
+  std::unique_lock<std::mutex> lock(myMutex);
+
+  for(;;)
+  {
+    myStartCondition.wait(lock, [&] { return myQuit || myGeneration != generation; });
+    if(myQuit)
+      return;
+
+    generation = myGeneration;
+    const Job& job = *myJob;
+
+    lock.unlock();
+    job(slice, numSlices);
+    lock.lock();
+
+    if(--myPending == 0)
+      myDoneCondition.notify_one();
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void WorkerPool::stop()
+{
+  if(myWorkers.empty())
+    return;
+
+  {
+    std::lock_guard<std::mutex> lock(myMutex);
+    myQuit = true;
+  }
+  myStartCondition.notify_all();
+
+  for(auto& worker: myWorkers)
+    worker.join();
+
+  myWorkers.clear();
+  myQuit = false;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void WorkerPool::pinThread(std::thread& thread, uInt32 core)
+{
+#if defined(BSPF_WINDOWS)
+  if(core < 64)
+    SetThreadAffinityMask(thread.native_handle(), DWORD_PTR(1) << core);
+#elif defined(__linux__)
+  cpu_set_t cpuset;
+  CPU_ZERO(&cpuset);
+  CPU_SET(core, &cpuset);
+  pthread_setaffinity_np(thread.native_handle(), sizeof(cpu_set_t), &cpuset);
+#else
+  // Not supported (e.g. macOS only knows affinity hints), ignore
+  (void)thread; (void)core;
+#endif
+}
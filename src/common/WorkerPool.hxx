@@ -0,0 +1,96 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2020 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+#ifndef WORKER_POOL_HXX
+#define WORKER_POOL_HXX
+
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+#include "bspf.hxx"
+
+/**
+  A small pool of persistent worker threads for splitting per-frame work
+  (like rendering the TV effects) into slices.
+
+  The workers are created once and stay parked on a condition variable
+  between the frames. 'run' hands the same job to all of them, executes
+  slice 0 on the calling thread and returns only after every slice is
+  finished, so it acts as a barrier.  The job must not throw.
+*/
+class WorkerPool
+{
+  public:
+    // Called with the slice to work on and the total number of slices
+    using Job = std::function<void(uInt32 slice, uInt32 numSlices)>;
+
+    WorkerPool() = default;
+    ~WorkerPool();
+
+    /**
+      (Re)create the workers.
+
+      @param numThreads  Total number of threads, including the caller;
+                         0 or 1 means no workers at all
+      @param pinThreads  Bind each worker to its own core (where supported)
+    */
+    void setup(uInt32 numThreads, bool pinThreads = false);
+
+    /**
+      Run the job on all threads and wait until all slices are done.
+    */
+    void run(const Job& job);
+
+    /**
+      The number of slices each job is split into.
+    */
+    uInt32 numThreads() const { return uInt32(myWorkers.size()) + 1; }
+
+  private:
+    // 'generation' is the last job the new worker must not run
+    void threadMain(uInt32 slice, uInt32 numSlices, uInt64 generation);
+
+    void stop();
+
+    static void pinThread(std::thread& thread, uInt32 core);
+
+  private:
+    vector<std::thread> myWorkers;
+
+    std::mutex myMutex;
+    std::condition_variable myStartCondition;
+    std::condition_variable myDoneCondition;
+
+    // The current job, valid while myPending is not zero
+    const Job* myJob{nullptr};
+    // Incremented for each job, so the workers can detect a new one
+    uInt64 myGeneration{0};
+    // Number of workers still busy with the current job
+    uInt32 myPending{0};
+    bool myQuit{false};
+
+  private:
+    // Following constructors and assignment operators not supported
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool(WorkerPool&&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+    WorkerPool& operator=(WorkerPool&&) = delete;
+};
+
+#endif
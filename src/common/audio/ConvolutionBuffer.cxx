@@ -17,29 +17,119 @@
 
 #include "ConvolutionBuffer.hxx"
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+  #include <emmintrin.h>
+  #define CONVOLUTION_SSE2
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+  #include <arm_neon.h>
+  #define CONVOLUTION_NEON
+#endif
+
+namespace {
+#if defined(CONVOLUTION_SSE2)
+  inline float horizontalSum(__m128 v)
+  {
+    const __m128 shuffled = _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 3, 0, 1));
+    const __m128 sums = _mm_add_ps(v, shuffled);
+
+    return _mm_cvtss_f32(_mm_add_ss(sums, _mm_movehl_ps(shuffled, sums)));
+  }
+#elif defined(CONVOLUTION_NEON)
+  inline float horizontalSum(float32x4_t v)
+  {
+    const float32x2_t sums = vadd_f32(vget_low_f32(v), vget_high_f32(v));
+
+    return vget_lane_f32(vpadd_f32(sums, sums), 0);
+  }
+#endif
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 ConvolutionBuffer::ConvolutionBuffer(uInt32 size)
-  : mySize(size)
+  : mySize(size),
+    myPaddedSize(paddedSize(size))
 {
-  myData = make_unique<float[]>(mySize);
-  std::fill_n(myData.get(), mySize, 0.F);
+  // The samples are mirrored at offset mySize; the tail beyond that covers
+  // the zero padding of the kernel
+  myData = make_unique<float[]>(mySize + myPaddedSize);
+  std::fill_n(myData.get(), mySize + myPaddedSize, 0.F);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void ConvolutionBuffer::shift(float nextValue)
 {
-  myData[myFirstIndex] = nextValue;
-  myFirstIndex = (myFirstIndex + 1) % mySize;
+  myData[myFirstIndex] = myData[myFirstIndex + mySize] = nextValue;
+  if (++myFirstIndex == mySize) myFirstIndex = 0;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-float ConvolutionBuffer::convoluteWith(float* kernel) const
+float ConvolutionBuffer::convoluteWith(const float* kernel) const
 {
+  const float* data = myData.get() + myFirstIndex;
+
+#if defined(CONVOLUTION_SSE2)
+  __m128 sum = _mm_setzero_ps();
+
+  for (uInt32 i = 0; i < myPaddedSize; i += 4)
+    sum = _mm_add_ps(sum, _mm_mul_ps(_mm_loadu_ps(kernel + i), _mm_loadu_ps(data + i)));
+
+  return horizontalSum(sum);
+#elif defined(CONVOLUTION_NEON)
+  float32x4_t sum = vdupq_n_f32(0.F);
+
+  for (uInt32 i = 0; i < myPaddedSize; i += 4)
+    sum = vmlaq_f32(sum, vld1q_f32(kernel + i), vld1q_f32(data + i));
+
+  return horizontalSum(sum);
+#else
   float result = 0.F;
 
-  for (uInt32 i = 0; i < mySize; ++i) {
-    result += kernel[i] * myData[(myFirstIndex + i) % mySize];
-  }
+  for (uInt32 i = 0; i < mySize; ++i)
+    result += kernel[i] * data[i];
 
   return result;
+#endif
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void ConvolutionBuffer::convoluteWith(const float* kernel,
+    const ConvolutionBuffer& buffer1, const ConvolutionBuffer& buffer2,
+    float& result1, float& result2)
+{
+  const float* data1 = buffer1.myData.get() + buffer1.myFirstIndex;
+  const float* data2 = buffer2.myData.get() + buffer2.myFirstIndex;
+  const uInt32 size = buffer1.myPaddedSize;
+
+#if defined(CONVOLUTION_SSE2)
+  __m128 sum1 = _mm_setzero_ps(), sum2 = _mm_setzero_ps();
+
+  for (uInt32 i = 0; i < size; i += 4) {
+    const __m128 k = _mm_loadu_ps(kernel + i);
+
+    sum1 = _mm_add_ps(sum1, _mm_mul_ps(k, _mm_loadu_ps(data1 + i)));
+    sum2 = _mm_add_ps(sum2, _mm_mul_ps(k, _mm_loadu_ps(data2 + i)));
+  }
+
+  result1 = horizontalSum(sum1);
+  result2 = horizontalSum(sum2);
+#elif defined(CONVOLUTION_NEON)
+  float32x4_t sum1 = vdupq_n_f32(0.F), sum2 = vdupq_n_f32(0.F);
+
+  for (uInt32 i = 0; i < size; i += 4) {
+    const float32x4_t k = vld1q_f32(kernel + i);
+
+    sum1 = vmlaq_f32(sum1, k, vld1q_f32(data1 + i));
+    sum2 = vmlaq_f32(sum2, k, vld1q_f32(data2 + i));
+  }
+
+  result1 = horizontalSum(sum1);
+  result2 = horizontalSum(sum2);
+#else
+  result1 = result2 = 0.F;
+
+  for (uInt32 i = 0; i < size; ++i) {
+    result1 += kernel[i] * data1[i];
+    result2 += kernel[i] * data2[i];
+  }
+#endif
 }
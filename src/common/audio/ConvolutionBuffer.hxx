@@ -20,6 +20,12 @@
 
 #include "bspf.hxx"
 
+/**
+  A ring buffer of the last N samples that can be convoluted with a kernel
+  of size N.  The samples are stored twice in a row, so the window of the
+  last N samples is always contiguous in memory and can be processed with
+  vector instructions (SSE2 on x86, NEON on ARM) without wrapping around.
+*/
 class ConvolutionBuffer
 {
   public:
@@ -28,7 +34,23 @@ class ConvolutionBuffer
 
     void shift(float nextValue);
 
-    float convoluteWith(float* kernel) const;
+    /**
+      Convolute the buffer with the given kernel.  The kernel must be padded
+      with zeros to paddedSize() elements.
+    */
+    float convoluteWith(const float* kernel) const;
+
+    /**
+      Convolute two buffers of the same size with the same kernel at once
+      (used for the left and right channel of stereo samples).
+    */
+    static void convoluteWith(const float* kernel, const ConvolutionBuffer& buffer1,
+                              const ConvolutionBuffer& buffer2, float& result1, float& result2);
+
+    /**
+      The size a kernel for a buffer of the given size must be padded to.
+    */
+    static constexpr uInt32 paddedSize(uInt32 size) { return (size + 3) & ~3u; }
 
   private:
 
@@ -38,6 +60,8 @@ class ConvolutionBuffer
 
     uInt32 mySize{0};
 
+    uInt32 myPaddedSize{0};
+
   private:
 
     ConvolutionBuffer() = delete;
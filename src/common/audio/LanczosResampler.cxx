@@ -71,12 +71,16 @@ LanczosResampler::LanczosResampler(
   // -> we find N from fully reducing the fraction.
   myPrecomputedKernelCount(reducedDenominator(formatFrom.sampleRate, formatTo.sampleRate)),
   myKernelSize(2 * kernelParameter),
+  myKernelStride(ConvolutionBuffer::paddedSize(myKernelSize)),
   myKernelParameter(kernelParameter),
   myHighPassL(HIGH_PASS_CUT_OFF, float(formatFrom.sampleRate)),
   myHighPassR(HIGH_PASS_CUT_OFF, float(formatFrom.sampleRate)),
   myHighPass(HIGH_PASS_CUT_OFF, float(formatFrom.sampleRate))
 {
-  myPrecomputedKernels = make_unique<float[]>(myPrecomputedKernelCount * myKernelSize);
+  // Kernels are zero-padded to a multiple of four floats, so that each one
+  // starts on a 16 byte boundary and can be processed in whole vectors
+  myPrecomputedKernels = make_unique<float[]>(myPrecomputedKernelCount * myKernelStride);
+  std::fill_n(myPrecomputedKernels.get(), myPrecomputedKernelCount * myKernelStride, 0.F);
 
   if (myFormatFrom.stereo)
   {
@@ -96,7 +100,7 @@ void LanczosResampler::precomputeKernels()
   uInt32 timeIndex = 0;
 
   for (uInt32 i = 0; i < myPrecomputedKernelCount; ++i) {
-    float* kernel = myPrecomputedKernels.get() + myKernelSize * i;
+    float* kernel = myPrecomputedKernels.get() + myKernelStride * i;
     // The kernel is normalized such to be evaluate on time * formatFrom.sampleRate
     float center =
       static_cast<float>(timeIndex) / static_cast<float>(myFormatTo.sampleRate);
@@ -143,12 +147,12 @@ void LanczosResampler::fillFragment(float* fragment, uInt32 length)
   const uInt32 outputSamples = myFormatTo.stereo ? (length >> 1) : length;
 
   for (uInt32 i = 0; i < outputSamples; ++i) {
-    float* kernel = myPrecomputedKernels.get() + (myCurrentKernelIndex * myKernelSize);
-    myCurrentKernelIndex = (myCurrentKernelIndex + 1) % myPrecomputedKernelCount;
+    const float* kernel = myPrecomputedKernels.get() + (myCurrentKernelIndex * myKernelStride);
+    if (++myCurrentKernelIndex == myPrecomputedKernelCount) myCurrentKernelIndex = 0;
 
     if (myFormatFrom.stereo) {
-      float sampleL = myBufferL->convoluteWith(kernel);
-      float sampleR = myBufferR->convoluteWith(kernel);
+      float sampleL, sampleR;
+      ConvolutionBuffer::convoluteWith(kernel, *myBufferL, *myBufferR, sampleL, sampleR);
 
       if (myFormatTo.stereo) {
         fragment[2*i] = sampleL;
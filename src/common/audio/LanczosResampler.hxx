@@ -45,6 +45,7 @@ class LanczosResampler : public Resampler
 
     uInt32 myPrecomputedKernelCount{0};
     uInt32 myKernelSize{0};
+    uInt32 myKernelStride{0};
     uInt32 myCurrentKernelIndex{0};
     unique_ptr<float[]> myPrecomputedKernels;
 
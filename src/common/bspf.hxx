@@ -113,6 +113,17 @@ static const string EmptyString("");
   #define ADAPTABLE_REFRESH_SUPPORT
 #endif
 
+// SIMD instruction sets which are part of the baseline of the target
+// architecture, so they can be used without any runtime detection
+// (define BSPF_NO_SIMD to always use the plain C++ code instead)
+#if !defined(BSPF_NO_SIMD)
+  #if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #define BSPF_SIMD_SSE2
+  #elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+    #define BSPF_SIMD_NEON
+  #endif
+#endif
+
 namespace BSPF
 {
   static constexpr float PI_f = 3.141592653589793238462643383279502884F;
@@ -22,12 +22,15 @@ MODULE_OBJS := \
 	src/common/PKeyboardHandler.o \
 	src/common/PNGLibrary.o \
 	src/common/RewindManager.o \
+	src/common/RunAheadInstance.o \
+	src/common/RunAheadManager.o \
 	src/common/SoundSDL2.o \
 	src/common/StaggeredLogger.o \
 	src/common/StateManager.o \
 	src/common/ThreadDebugging.o \
 	src/common/TimerManager.o \
 	src/common/VideoModeHandler.o \
+	src/common/WorkerPool.o \
 	src/common/ZipHandler.o \
 	src/common/repository/KeyValueRepositoryConfigfile.o \
 	src/common/sdl_blitter/BilinearBlitter.o \
@@ -79,7 +79,7 @@ void BilinearBlitter::free()
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-void BilinearBlitter::blit(SDL_Surface& surface)
+void BilinearBlitter::blit(SDL_Surface& surface, uInt32 dirtyTop, uInt32 dirtyBottom)
 {
   ASSERT_MAIN_THREAD;
 
@@ -88,9 +88,16 @@ void BilinearBlitter::blit(SDL_Surface& surface)
   SDL_Texture* texture = myTexture;
 
   if(myStaticData == nullptr) {
-    SDL_UpdateTexture(myTexture, &mySrcRect, surface.pixels, surface.pitch);
+    // The texture we upload to was last updated two frames ago, so it also
+    // needs the rows that changed in the previous frame
+    myStaleRows.add(dirtyTop, dirtyBottom);
+    updateTextureRows(myTexture, mySrcRect, surface, myStaleRows);
+    mySecondaryStaleRows.add(dirtyTop, dirtyBottom);
+
     myTexture = mySecondaryTexture;
     mySecondaryTexture = texture;
+    myStaleRows = mySecondaryStaleRows;
+    mySecondaryStaleRows = RowRange();
   }
 
   SDL_RenderCopy(myFB.renderer(), texture, &mySrcRect, &myDstRect);
@@ -137,6 +144,9 @@ void BilinearBlitter::recreateTexturesIfNecessary()
     }
   }
 
+  // Fresh textures have to be uploaded completely
+  myStaleRows = mySecondaryStaleRows = RowRange{0, static_cast<uInt32>(mySrcRect.h)};
+
   myRecreateTextures = false;
   myTexturesAreAllocated = true;
 }
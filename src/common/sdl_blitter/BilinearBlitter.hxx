@@ -38,13 +38,15 @@ class BilinearBlitter : public Blitter {
       SDL_Surface* staticData = nullptr
     ) override;
 
-    virtual void blit(SDL_Surface& surface) override;
+    virtual void blit(SDL_Surface& surface, uInt32 dirtyTop, uInt32 dirtyBottom) override;
 
   private:
     FBBackendSDL2& myFB;
 
     SDL_Texture* myTexture{nullptr};
     SDL_Texture* mySecondaryTexture{nullptr};
+    // The rows each of the two textures has missed since its last upload
+    RowRange myStaleRows, mySecondaryStaleRows;
     SDL_Rect mySrcRect{0, 0, 0, 0}, myDstRect{0, 0, 0, 0};
     FBSurface::Attributes myAttributes;
 
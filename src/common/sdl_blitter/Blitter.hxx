@@ -35,12 +35,47 @@ class Blitter {
       SDL_Surface* staticData = nullptr
     ) = 0;
 
-    virtual void blit(SDL_Surface& surface) = 0;
+    /**
+      Blit the surface to the screen. Only rows [dirtyTop, dirtyBottom) of
+      the surface have changed since the previous blit, so a streaming
+      blitter may restrict its texture uploads to these rows (plus any
+      rows an alternate texture has missed in the meantime).
+    */
+    virtual void blit(SDL_Surface& surface, uInt32 dirtyTop, uInt32 dirtyBottom) = 0;
 
   protected:
 
     Blitter() = default;
 
+    // A range of texture rows [top, bottom) that is out of date
+    struct RowRange {
+      uInt32 top{0}, bottom{0};
+
+      bool empty() const { return top >= bottom; }
+
+      void add(uInt32 t, uInt32 b) {
+        if(t >= b) return;
+        if(empty()) { top = t;  bottom = b; }
+        else        { top = std::min(top, t);  bottom = std::max(bottom, b); }
+      }
+    };
+
+    // Upload the given rows of the surface to a streaming texture
+    static void updateTextureRows(SDL_Texture* texture, const SDL_Rect& srcRect,
+                                  const SDL_Surface& surface, RowRange rows)
+    {
+      rows.bottom = std::min(rows.bottom, static_cast<uInt32>(srcRect.h));
+      if(rows.empty()) return;
+
+      const SDL_Rect rect{
+        srcRect.x, srcRect.y + static_cast<int>(rows.top),
+        srcRect.w, static_cast<int>(rows.bottom - rows.top)
+      };
+      SDL_UpdateTexture(texture, &rect,
+          static_cast<const uInt8*>(surface.pixels) + rows.top * surface.pitch,
+          surface.pitch);
+    }
+
   private:
 
     Blitter(const Blitter&) = delete;
@@ -88,7 +88,7 @@ void QisBlitter::free()
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-void QisBlitter::blit(SDL_Surface& surface)
+void QisBlitter::blit(SDL_Surface& surface, uInt32 dirtyTop, uInt32 dirtyBottom)
 {
   ASSERT_MAIN_THREAD;
 
@@ -97,7 +97,11 @@ void QisBlitter::blit(SDL_Surface& surface)
   SDL_Texture* intermediateTexture = myIntermediateTexture;
 
   if(myStaticData == nullptr) {
-    SDL_UpdateTexture(mySrcTexture, &mySrcRect, surface.pixels, surface.pitch);
+    // The source texture we upload to was last updated two frames ago, so it
+    // also needs the rows that changed in the previous frame
+    mySrcStaleRows.add(dirtyTop, dirtyBottom);
+    updateTextureRows(mySrcTexture, mySrcRect, surface, mySrcStaleRows);
+    mySecondarySrcStaleRows.add(dirtyTop, dirtyBottom);
 
     blitToIntermediate();
 
@@ -107,6 +111,9 @@ void QisBlitter::blit(SDL_Surface& surface)
     SDL_Texture* temporary = mySrcTexture;
     mySrcTexture = mySecondarySrcTexture;
     mySecondarySrcTexture = temporary;
+
+    mySrcStaleRows = mySecondarySrcStaleRows;
+    mySecondarySrcStaleRows = RowRange();
   }
 
   SDL_RenderCopy(myFB.renderer(), intermediateTexture, &myIntermediateRect, &myDstRect);
@@ -193,6 +200,9 @@ void QisBlitter::recreateTexturesIfNecessary()
     }
   }
 
+  // Fresh textures have to be uploaded completely
+  mySrcStaleRows = mySecondarySrcStaleRows = RowRange{0, static_cast<uInt32>(mySrcRect.h)};
+
   myRecreateTextures = false;
   myTexturesAreAllocated = true;
 }
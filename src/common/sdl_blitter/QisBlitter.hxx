@@ -40,7 +40,7 @@ class QisBlitter : public Blitter {
       SDL_Surface* staticData = nullptr
     ) override;
 
-    virtual void blit(SDL_Surface& surface) override;
+    virtual void blit(SDL_Surface& surface, uInt32 dirtyTop, uInt32 dirtyBottom) override;
 
   private:
 
@@ -50,6 +50,8 @@ class QisBlitter : public Blitter {
     SDL_Texture* mySecondarySrcTexture{nullptr};
     SDL_Texture* myIntermediateTexture{nullptr};
     SDL_Texture* mySecondaryIntermedateTexture{nullptr};
+    // The rows each of the two source textures has missed since its last upload
+    RowRange mySrcStaleRows, mySecondarySrcStaleRows;
 
     SDL_Rect mySrcRect{0, 0, 0, 0}, myIntermediateRect{0, 0, 0, 0}, myDstRect{0, 0, 0, 0};
     FBSurface::Attributes myAttributes;
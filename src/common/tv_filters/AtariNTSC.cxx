@@ -15,10 +15,15 @@
 // this file, and for a DISCLAIMER OF ALL WARRANTIES.
 //============================================================================
 
-#include <thread>
 #include "AtariNTSC.hxx"
 #include "PhosphorHandler.hxx"
 
+#if defined(BSPF_SIMD_SSE2)
+  #include <emmintrin.h>
+#elif defined(BSPF_SIMD_NEON)
+  #include <arm_neon.h>
+#endif
+
 // blitter related
 #ifndef restrict
   #if defined (__GNUC__)
@@ -86,51 +91,77 @@ void AtariNTSC::generateKernels()
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-void AtariNTSC::enableThreading(bool enable)
+void AtariNTSC::enableThreading(bool enable, bool pinThreads)
 {
   uInt32 systemThreads = enable ? std::thread::hardware_concurrency() : 0;
-  if(systemThreads <= 1)
-  {
-    myWorkerThreads = 0;
-    myTotalThreads  = 1;
-  }
-  else
-  {
+  if(systemThreads > 1)
     systemThreads = std::max<uInt32>(1, std::min<uInt32>(4, systemThreads - 1));
 
-    myWorkerThreads = systemThreads - 1;
-    myTotalThreads  = systemThreads;
-
-    myThreads = make_unique<std::thread[]>(myWorkerThreads);  // NOLINT
-  }
+  myWorkerPool.setup(systemThreads, pinThreads);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void AtariNTSC::render(const uInt8* atari_in, const uInt32 in_width, const uInt32 in_height,
   void* rgb_out, const uInt32 out_pitch, uInt32* rgb_in)
 {
-  // Spawn the threads...
-  for(uInt32 i = 0; i < myWorkerThreads; ++i)
-  {
-    myThreads[i] = std::thread([=] {
+  // Let the (already running) threads render their slices
+  myWorkerPool.run([&](uInt32 slice, uInt32 numSlices) {
     rgb_in == nullptr ?
-      renderThread(atari_in, in_width, in_height, myTotalThreads, i+1, rgb_out, out_pitch) :
-      renderWithPhosphorThread(atari_in, in_width, in_height, myTotalThreads, i+1, rgb_in, rgb_out, out_pitch);
-    });
-  }
-  // Make the main thread busy too
-  rgb_in == nullptr ?
-    renderThread(atari_in, in_width, in_height, myTotalThreads, 0, rgb_out, out_pitch) :
-    renderWithPhosphorThread(atari_in, in_width, in_height, myTotalThreads, 0, rgb_in, rgb_out, out_pitch);
-  // ...and make them join again
-  for(uInt32 i = 0; i < myWorkerThreads; ++i)
-    myThreads[i].join();
+      renderThread(atari_in, in_width, in_height, numSlices, slice, rgb_out, out_pitch) :
+      renderWithPhosphorThread(atari_in, in_width, in_height, numSlices, slice, rgb_in, rgb_out, out_pitch);
+  });
 
   // Copy phosphor values into out buffer
   if(rgb_in != nullptr)
     memcpy(rgb_out, rgb_in, in_height * out_pitch);
 }
 
+#if defined(BSPF_SIMD_SSE2) || defined(BSPF_SIMD_NEON)
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void AtariNTSC::rgbOut4_8888(const uInt32* k0, const uInt32* k1,
+  const uInt32* kx0, const uInt32* kx1, uInt32* out)
+{
+#if defined(BSPF_SIMD_SSE2)
+  const auto load = [](const uInt32* p) {
+    return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+  };
+  __m128i raw = _mm_add_epi32(_mm_add_epi32(load(k0), load(k1)),
+                              _mm_add_epi32(load(kx0), load(kx1)));
+
+  // ATARI_NTSC_CLAMP
+  const __m128i sub = _mm_and_si128(_mm_srli_epi32(raw, 9),
+                                    _mm_set1_epi32(atari_ntsc_clamp_mask));
+  __m128i clamp = _mm_sub_epi32(_mm_set1_epi32(atari_ntsc_clamp_add), sub);
+  raw = _mm_or_si128(raw, clamp);
+  clamp = _mm_sub_epi32(clamp, sub);
+  raw = _mm_and_si128(raw, clamp);
+
+  const __m128i rgb = _mm_or_si128(_mm_or_si128(
+    _mm_and_si128(_mm_srli_epi32(raw, 5), _mm_set1_epi32(0x00FF0000)),
+    _mm_and_si128(_mm_srli_epi32(raw, 3), _mm_set1_epi32(0x0000FF00))),
+    _mm_and_si128(_mm_srli_epi32(raw, 1), _mm_set1_epi32(0x000000FF)));
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(out), rgb);
+#elif defined(BSPF_SIMD_NEON)
+  uint32x4_t raw = vaddq_u32(vaddq_u32(vld1q_u32(k0), vld1q_u32(k1)),
+                             vaddq_u32(vld1q_u32(kx0), vld1q_u32(kx1)));
+
+  // ATARI_NTSC_CLAMP
+  const uint32x4_t sub = vandq_u32(vshrq_n_u32(raw, 9),
+                                   vdupq_n_u32(atari_ntsc_clamp_mask));
+  uint32x4_t clamp = vsubq_u32(vdupq_n_u32(atari_ntsc_clamp_add), sub);
+  raw = vorrq_u32(raw, clamp);
+  clamp = vsubq_u32(clamp, sub);
+  raw = vandq_u32(raw, clamp);
+
+  const uint32x4_t rgb = vorrq_u32(vorrq_u32(
+    vandq_u32(vshrq_n_u32(raw, 5), vdupq_n_u32(0x00FF0000)),
+    vandq_u32(vshrq_n_u32(raw, 3), vdupq_n_u32(0x0000FF00))),
+    vandq_u32(vshrq_n_u32(raw, 1), vdupq_n_u32(0x000000FF)));
+  vst1q_u32(out, rgb);
+#endif
+}
+#endif
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void AtariNTSC::renderThread(const uInt8* atari_in, const uInt32 in_width,
   const uInt32 in_height, const uInt32 numThreads, const uInt32 threadNum,
@@ -159,15 +190,10 @@ void AtariNTSC::renderThread(const uInt8* atari_in, const uInt32 in_width,
     {
       // order of input and output pixels must not be altered
       ATARI_NTSC_COLOR_IN(0, line_in[0])
-      ATARI_NTSC_RGB_OUT_8888(0, line_out[0])
-      ATARI_NTSC_RGB_OUT_8888(1, line_out[1])
-      ATARI_NTSC_RGB_OUT_8888(2, line_out[2])
-      ATARI_NTSC_RGB_OUT_8888(3, line_out[3])
+      ATARI_NTSC_RGB_OUT4_8888(0, line_out)
 
       ATARI_NTSC_COLOR_IN(1, line_in[1])
-      ATARI_NTSC_RGB_OUT_8888(4, line_out[4])
-      ATARI_NTSC_RGB_OUT_8888(5, line_out[5])
-      ATARI_NTSC_RGB_OUT_8888(6, line_out[6])
+      ATARI_NTSC_RGB_OUT4_8888(4, line_out)
 
       line_in += 2;
       line_out += 7;
@@ -235,15 +261,10 @@ void AtariNTSC::renderWithPhosphorThread(const uInt8* atari_in, const uInt32 in_
     {
       // order of input and output pixels must not be altered
       ATARI_NTSC_COLOR_IN(0, line_in[0])
-      ATARI_NTSC_RGB_OUT_8888(0, line_out[0])
-      ATARI_NTSC_RGB_OUT_8888(1, line_out[1])
-      ATARI_NTSC_RGB_OUT_8888(2, line_out[2])
-      ATARI_NTSC_RGB_OUT_8888(3, line_out[3])
+      ATARI_NTSC_RGB_OUT4_8888(0, line_out)
 
       ATARI_NTSC_COLOR_IN(1, line_in[1])
-      ATARI_NTSC_RGB_OUT_8888(4, line_out[4])
-      ATARI_NTSC_RGB_OUT_8888(5, line_out[5])
-      ATARI_NTSC_RGB_OUT_8888(6, line_out[6])
+      ATARI_NTSC_RGB_OUT4_8888(4, line_out)
 
       line_in += 2;
       line_out += 7;
@@ -277,45 +298,10 @@ void AtariNTSC::renderWithPhosphorThread(const uInt8* atari_in, const uInt32 in_
 #endif
 
     // Do phosphor mode (blend the resulting frames)
-    // Note: The unrolled code assumed that AtariNTSC::outWidth(kTIAW) == outPitch == 565
-    // Now this got changed to 568 so the final 5 calculations got removed.
-    for (uInt32 x = AtariNTSC::outWidth(in_width) / 8; x; --x)
-    {
-      // Store back into displayed frame buffer (for next frame)
-      rgb_in[bufofs] = PhosphorHandler::getPixel(out[bufofs], rgb_in[bufofs]);
-      ++bufofs;
-      rgb_in[bufofs] = PhosphorHandler::getPixel(out[bufofs], rgb_in[bufofs]);
-      ++bufofs;
-      rgb_in[bufofs] = PhosphorHandler::getPixel(out[bufofs], rgb_in[bufofs]);
-      ++bufofs;
-      rgb_in[bufofs] = PhosphorHandler::getPixel(out[bufofs], rgb_in[bufofs]);
-      ++bufofs;
-      rgb_in[bufofs] = PhosphorHandler::getPixel(out[bufofs], rgb_in[bufofs]);
-      ++bufofs;
-      rgb_in[bufofs] = PhosphorHandler::getPixel(out[bufofs], rgb_in[bufofs]);
-      ++bufofs;
-      rgb_in[bufofs] = PhosphorHandler::getPixel(out[bufofs], rgb_in[bufofs]);
-      ++bufofs;
-      rgb_in[bufofs] = PhosphorHandler::getPixel(out[bufofs], rgb_in[bufofs]);
-      ++bufofs;
-    }
-    // finish final 565 % 8 = 5 pixels
-    /*rgb_in[bufofs] = PhosphorHandler::getPixel(out[bufofs], rgb_in[bufofs]);
-    ++bufofs;
-    rgb_in[bufofs] = PhosphorHandler::getPixel(out[bufofs], rgb_in[bufofs]);
-    ++bufofs;
-    rgb_in[bufofs] = PhosphorHandler::getPixel(out[bufofs], rgb_in[bufofs]);
-    ++bufofs;
-    rgb_in[bufofs] = PhosphorHandler::getPixel(out[bufofs], rgb_in[bufofs]);
-    ++bufofs;
-    rgb_in[bufofs] = PhosphorHandler::getPixel(out[bufofs], rgb_in[bufofs]);
-    ++bufofs;*/
-#if 0
-    rgb_in[bufofs] = PhosphorHandler::getPixel(out[bufofs], rgb_in[bufofs]);
-    ++bufofs;
-    rgb_in[bufofs] = PhosphorHandler::getPixel(out[bufofs], rgb_in[bufofs]);
-    ++bufofs;
-#endif
+    // Note: The code assumes that AtariNTSC::outWidth(kTIAW) == outPitch
+    const uInt32 pixels = AtariNTSC::outWidth(in_width) / 8 * 8;
+    PhosphorHandler::getPixels(out + bufofs, rgb_in + bufofs, pixels);
+    bufofs += pixels;
 
     atari_in += in_width;
     rgb_out = static_cast<char*>(rgb_out) + out_pitch;
@@ -41,9 +41,9 @@
 #define ATARI_NTSC_HXX
 
 #include <cmath>
-#include <thread>
 
 #include "FrameBufferConstants.hxx"
+#include "WorkerPool.hxx"
 #include "bspf.hxx"
 
 //#define BLARGG_PALETTE // also modify contrast, brightness, saturation, gamma and hue when defined
@@ -90,8 +90,11 @@ class AtariNTSC
     // Set palette for normal Blarrg mode
     void setPalette(const PaletteArray& palette);
 
-    // Set up threading
-    void enableThreading(bool enable);
+    // Set up threading, optionally binding the workers to their own cores
+    void enableThreading(bool enable, bool pinThreads = false);
+
+    // The rendering threads, which can also be used for other per-frame work
+    WorkerPool& workerPool() { return myWorkerPool; }
 
     // Filters one or more rows of pixels. Input pixels are 8-bit Atari
     // palette colors.
@@ -108,6 +111,9 @@ class AtariNTSC
     }
 
   private:
+    // Compares the SIMD with the per pixel rendering ('make check')
+    friend class AtariNTSCCheck;
+
     // Generate kernels from raw RGB palette
     void generateKernels();
 
@@ -162,10 +168,8 @@ class AtariNTSC
     std::array<uInt8, palette_size*3> myRGBPalette;
     BSPF::array2D<uInt32, palette_size, entry_size> myColorTable;
 
-    // Rendering threads
-    unique_ptr<std::thread[]> myThreads;  // NOLINT
-    // Number of rendering and total threads
-    uInt32 myWorkerThreads{0}, myTotalThreads{0};
+    // Rendering threads, parked between the frames
+    WorkerPool myWorkerPool;
 
     struct init_t
     {
@@ -231,6 +235,29 @@ class AtariNTSC
       rgb_out = (raw_>>5 & 0x00FF0000)|(raw_>>3 & 0x0000FF00)|(raw_>>1 & 0x000000FF);\
     }
 
+    // Generates the output pixels 'index' to 'index + 3' of a chunk in the
+    // same format, using SIMD instructions where available.  For index 4,
+    // the (garbage) 4th pixel is overwritten by the next chunk; without
+    // SIMD, it is not generated at all.
+  #if defined(BSPF_SIMD_SSE2) || defined(BSPF_SIMD_NEON)
+    #define ATARI_NTSC_RGB_OUT4_8888( index, rgb_out ) \
+      rgbOut4_8888(kernel0 + (index), kernel1 + ((index)+10)%7+14,\
+        kernelx0 + ((index)+7)%14, kernelx1 + ((index)+3)%7+14+7, (rgb_out) + (index));
+
+    // Does the work of ATARI_NTSC_RGB_OUT_8888 for 4 consecutive pixels,
+    // whose kernel entries are consecutive too
+    static void rgbOut4_8888(const uInt32* k0, const uInt32* k1,
+                             const uInt32* kx0, const uInt32* kx1, uInt32* out);
+  #else
+    #define ATARI_NTSC_RGB_OUT4_8888( index, rgb_out ) {\
+      ATARI_NTSC_RGB_OUT_8888((index)  , (rgb_out)[(index)  ])\
+      ATARI_NTSC_RGB_OUT_8888((index)+1, (rgb_out)[(index)+1])\
+      ATARI_NTSC_RGB_OUT_8888((index)+2, (rgb_out)[(index)+2])\
+      if((index) == 0)\
+        ATARI_NTSC_RGB_OUT_8888((index)+3, (rgb_out)[(index)+3])\
+    }
+  #endif
+
     // Common ntsc macros
     static constexpr void ATARI_NTSC_CLAMP( uInt32& io, uInt32 shift ) {
       uInt32 sub = io >> (9-(shift)) & atari_ntsc_clamp_mask;
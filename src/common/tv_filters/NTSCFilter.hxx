@@ -123,11 +123,14 @@ class NTSCFilter
     }
 
     // Enable threading for the NTSC rendering
-    inline void enableThreading(bool enable)
+    inline void enableThreading(bool enable, bool pinThreads = false)
     {
-      myNTSC.enableThreading(enable);
+      myNTSC.enableThreading(enable, pinThreads);
     }
 
+    // The threads used for the NTSC rendering
+    inline WorkerPool& workerPool() { return myNTSC.workerPool(); }
+
   private:
     // Convert from atari_ntsc_setup_t values to equivalent adjustables
     void convertToAdjustable(Adjustable& adjustable,
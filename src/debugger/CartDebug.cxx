@@ -754,6 +754,20 @@ int CartDebug::getAddress(const string& label) const
     return -1;
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+int CartDebug::getNearestLabelAddress(uInt16 addr) const
+{
+  if(addressType(addr) != AddrType::ROM)
+    return -1;
+
+  // Search for the nearest label in the same 4K segment
+  auto iter = myUserLabels.upper_bound(addr);
+  if(iter == myUserLabels.begin() || ((--iter)->first & 0xf000) != (addr & 0xf000))
+    return -1;
+
+  return iter->first;
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 string CartDebug::loadListFile()
 {
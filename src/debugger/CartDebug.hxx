@@ -217,6 +217,13 @@ class CartDebug : public DebuggerSystem
                     int places = -1, bool isRam = false) const;
     int getAddress(const string& label) const;
 
+    /**
+      Return the address of the nearest user-defined label at or before the
+      given ROM address (ie, the routine it belongs to), or -1 if there is
+      no such label in the same 4K segment.
+    */
+    int getNearestLabelAddress(uInt16 addr) const;
+
     /**
       Load constants from list file (as generated by DASM).
     */
@@ -0,0 +1,409 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2020 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+#include "Debugger.hxx"
+#include "CompiledExpression.hxx"
+
+namespace {
+  // Get the index of an item in the list, appending it if necessary
+  template<typename T>
+  uInt16 indexOf(vector<T>& list, const T& item)
+  {
+    const auto iter = std::find(list.begin(), list.end(), item);
+    if(iter != list.end())
+      return uInt16(std::distance(list.begin(), iter));
+
+    list.push_back(item);
+    return uInt16(list.size() - 1);
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void Expression::compile(CompiledExpression& program) const
+{
+  program.call(*this);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+CompiledExpression::CompiledExpression(Expression* expression)
+  : myExpression(expression)
+{
+  myExpression->compile(*this);
+  myInputValues.resize(myInputs.size());
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+Int32 CompiledExpression::evaluate()
+{
+  bool changed = !(myCacheable && myResultValid);
+  const Debugger& debugger = Debugger::debugger();
+  const uInt8* ram = debugger.riotDebug().ram();
+
+  for(size_t i = 0; i < myInputs.size(); ++i)
+  {
+    const Int32 value = fetch(myInputs[i], debugger, ram);
+    if(value != myInputValues[i])
+    {
+      myInputValues[i] = value;
+      changed = true;
+    }
+  }
+
+  if(changed)
+  {
+    myResult = run(0);
+    myResultValid = true;
+  }
+  return myResult;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void CompiledExpression::constant(Int32 value)
+{
+  emit(Op::Const, value, 1);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void CompiledExpression::unary(Op op, const Expression& operand)
+{
+  const size_t start = myCode.size();
+  const bool isConstant = compileOperand(operand);
+
+  emit(op, 0, 0);
+  if(isConstant)
+    fold(start);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void CompiledExpression::binary(Op op, const Expression& lhs, const Expression& rhs)
+{
+  const size_t start = myCode.size();
+  const bool lhsConstant = compileOperand(lhs);
+  const bool rhsConstant = compileOperand(rhs);
+
+  emit(op, 0, -1);
+  if(lhsConstant && rhsConstant)
+    fold(start);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void CompiledExpression::logical(Op op, const Expression& lhs, const Expression& rhs)
+{
+  if(compileOperand(lhs))
+  {
+    // The left side alone either decides the result, or can be dropped
+    const bool value = myCode.back().arg != 0;
+    myCode.pop_back();
+    --myDepth;
+
+    if(value == (op == Op::OrJump))
+      constant(value ? 1 : 0);
+    else
+      unary(Op::Bool, rhs);
+    return;
+  }
+
+  // The jump skips the right side if the left one decides the result,
+  // otherwise it removes the left value from the stack
+  const size_t jump = myCode.size();
+  emit(op, 0, -1);
+  compileOperand(rhs);
+  emit(Op::Bool, 0, 0);
+  myCode[jump].arg = Int32(myCode.size());
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void CompiledExpression::method(CpuMethod method)
+{
+  input(Source::Cpu, indexOf(myCpuMethods, method));
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void CompiledExpression::method(TiaMethod method)
+{
+  input(Source::Tia, indexOf(myTiaMethods, method));
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void CompiledExpression::method(RiotMethod method)
+{
+  input(Source::Riot, indexOf(myRiotMethods, method));
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void CompiledExpression::method(CartMethod method)
+{
+  input(Source::Cart, indexOf(myCartMethods, method));
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void CompiledExpression::equate(const string& label)
+{
+  input(Source::Equate, indexOf(myLabels, label));
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void CompiledExpression::function(const string& label)
+{
+  // Functions can be redefined at any time, so they are looked up when
+  // the program runs
+  emit(Op::Function, indexOf(myLabels, label), 1);
+  myCacheable = false;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void CompiledExpression::byteDeref(const Expression& address, const Expression* offset)
+{
+  const size_t start = myCode.size();
+  bool isConstant = compileOperand(address);
+
+  if(offset)
+  {
+    isConstant = compileOperand(*offset) && isConstant;
+    emit(Op::Plus, 0, -1);
+    if(isConstant)
+      fold(start);
+  }
+
+  if(isConstant && isRAM(uInt16(myCode.back().arg)))
+  {
+    const uInt16 addr = uInt16(myCode.back().arg);
+    myCode.pop_back();
+    --myDepth;
+    input(Source::Ram, addr);
+  }
+  else
+  {
+    emit(Op::Peek, 0, 0);
+    myCacheable = false;
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void CompiledExpression::wordDeref(const Expression& address)
+{
+  if(compileOperand(address) && isRAM(uInt16(myCode.back().arg)) &&
+     isRAM(uInt16(myCode.back().arg + 1)))
+  {
+    const uInt16 addr = uInt16(myCode.back().arg);
+    myCode.pop_back();
+    --myDepth;
+    input(Source::RamWord, addr);
+  }
+  else
+  {
+    emit(Op::DPeek, 0, 0);
+    myCacheable = false;
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void CompiledExpression::call(const Expression& expression)
+{
+  myCalls.push_back(&expression);
+  emit(Op::Call, Int32(myCalls.size() - 1), 1);
+  myCacheable = false;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool CompiledExpression::compileOperand(const Expression& expression)
+{
+  const size_t start = myCode.size();
+  expression.compile(*this);
+
+  return myCode.size() == start + 1 && myCode[start].op == Op::Const;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void CompiledExpression::emit(Op op, Int32 arg, Int32 depth)
+{
+  myCode.push_back({op, arg});
+
+  myDepth += depth;
+  if(size_t(myDepth) > myStack.size())
+    myStack.resize(myDepth);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void CompiledExpression::input(Source source, uInt16 index)
+{
+  size_t slot = 0;
+  while(slot < myInputs.size() &&
+        (myInputs[slot].source != source || myInputs[slot].index != index))
+    ++slot;
+
+  if(slot == myInputs.size())
+    myInputs.push_back({source, index});
+
+  emit(Op::Input, Int32(slot), 1);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void CompiledExpression::fold(size_t start)
+{
+  const Int32 value = run(start);
+
+  myCode.resize(start);
+  --myDepth;
+  constant(value);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+Int32 CompiledExpression::run(size_t start)
+{
+  Debugger& debugger = Debugger::debugger();
+  const Instruction* const code = myCode.data();
+  const Instruction* const end = code + myCode.size();
+  Int32* sp = myStack.data();
+
+  for(const Instruction* ip = code + start; ip != end; ++ip)
+  {
+    switch(ip->op)
+    {
+      case Op::Const:
+        *sp++ = ip->arg;
+        break;
+      case Op::Input:
+        *sp++ = myInputValues[ip->arg];
+        break;
+      case Op::Call:
+        *sp++ = myCalls[ip->arg]->evaluate();
+        break;
+      case Op::Function:
+        *sp++ = debugger.getFunction(myLabels[ip->arg]).evaluate();
+        break;
+      case Op::Peek:
+        sp[-1] = debugger.peek(uInt16(sp[-1]));
+        break;
+      case Op::DPeek:
+        sp[-1] = debugger.dpeekAsInt(sp[-1]);
+        break;
+
+      case Op::UnaryMinus:
+        sp[-1] = -sp[-1];
+        break;
+      case Op::BinNot:
+        sp[-1] = ~sp[-1];
+        break;
+      case Op::LogNot:
+        sp[-1] = !sp[-1];
+        break;
+      case Op::LoByte:
+        sp[-1] = 0xff & sp[-1];
+        break;
+      case Op::HiByte:
+        sp[-1] = 0xff & (sp[-1] >> 8);
+        break;
+      case Op::Bool:
+        sp[-1] = sp[-1] != 0;
+        break;
+
+      case Op::Plus:
+        --sp;  sp[-1] = sp[-1] + sp[0];
+        break;
+      case Op::Minus:
+        --sp;  sp[-1] = sp[-1] - sp[0];
+        break;
+      case Op::Mult:
+        --sp;  sp[-1] = sp[-1] * sp[0];
+        break;
+      case Op::Div:
+        --sp;  sp[-1] = sp[0] == 0 ? 0 : sp[-1] / sp[0];
+        break;
+      case Op::Mod:
+        --sp;  sp[-1] = sp[0] == 0 ? 0 : sp[-1] % sp[0];
+        break;
+      case Op::BinAnd:
+        --sp;  sp[-1] = sp[-1] & sp[0];
+        break;
+      case Op::BinOr:
+        --sp;  sp[-1] = sp[-1] | sp[0];
+        break;
+      case Op::BinXor:
+        --sp;  sp[-1] = sp[-1] ^ sp[0];
+        break;
+      case Op::ShiftLeft:
+        --sp;  sp[-1] = sp[-1] << sp[0];
+        break;
+      case Op::ShiftRight:
+        --sp;  sp[-1] = sp[-1] >> sp[0];
+        break;
+
+      case Op::Equals:
+        --sp;  sp[-1] = sp[-1] == sp[0];
+        break;
+      case Op::NotEquals:
+        --sp;  sp[-1] = sp[-1] != sp[0];
+        break;
+      case Op::Less:
+        --sp;  sp[-1] = sp[-1] < sp[0];
+        break;
+      case Op::LessEquals:
+        --sp;  sp[-1] = sp[-1] <= sp[0];
+        break;
+      case Op::Greater:
+        --sp;  sp[-1] = sp[-1] > sp[0];
+        break;
+      case Op::GreaterEquals:
+        --sp;  sp[-1] = sp[-1] >= sp[0];
+        break;
+
+      case Op::AndJump:
+        if(sp[-1] == 0)
+          ip = code + ip->arg - 1;  // result is 0
+        else
+          --sp;
+        break;
+      case Op::OrJump:
+        if(sp[-1] != 0)
+        {
+          sp[-1] = 1;
+          ip = code + ip->arg - 1;
+        }
+        else
+          --sp;
+        break;
+    }
+  }
+  return sp[-1];
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+Int32 CompiledExpression::fetch(const Input& input, const Debugger& debugger,
+                                const uInt8* ram) const
+{
+  switch(input.source)
+  {
+    case Source::Cpu:
+      return (debugger.cpuDebug().*myCpuMethods[input.index])();
+    case Source::Tia:
+      return (debugger.tiaDebug().*myTiaMethods[input.index])();
+    case Source::Riot:
+      return (debugger.riotDebug().*myRiotMethods[input.index])();
+    case Source::Cart:
+      return (debugger.cartDebug().*myCartMethods[input.index])();
+    case Source::Equate:
+      return debugger.cartDebug().getAddress(myLabels[input.index]);
+    // RAM is read directly; unlike a peek through the system, this has
+    // no side effects
+    case Source::Ram:
+      return ram[input.index & 0x7f];
+    case Source::RamWord:
+      return ram[input.index & 0x7f] | (ram[(input.index + 1) & 0x7f] << 8);
+  }
+  return 0;
+}
@@ -0,0 +1,154 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2020 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+#ifndef COMPILED_EXPRESSION_HXX
+#define COMPILED_EXPRESSION_HXX
+
+class Debugger;
+
+#include "bspf.hxx"
+#include "CartDebug.hxx"
+#include "CpuDebug.hxx"
+#include "RiotDebug.hxx"
+#include "TIADebug.hxx"
+#include "Expression.hxx"
+
+/**
+  An expression tree translated into a flat program for a small stack
+  machine.  This is used for the conditions which are checked after every
+  instruction (breakif, trapif and savestateif), where evaluating the tree
+  node by node would slow down emulation considerably.
+
+  The values the expression depends on (CPU registers, TIA/RIOT/cart
+  debugger values, labels and zero-page RAM at fixed addresses) are
+  fetched before the program runs.  If none of them changed since the
+  last evaluation, the previous result is returned without running the
+  program at all.  Expressions which access anything else (e.g. memory at
+  a calculated address or a user-defined function) are always run.
+*/
+class CompiledExpression
+{
+  public:
+    enum class Op: uInt8 {
+      Const, Input, Call, Function, Peek, DPeek,
+      UnaryMinus, BinNot, LogNot, LoByte, HiByte, Bool,
+      Plus, Minus, Mult, Div, Mod, BinAnd, BinOr, BinXor,
+      ShiftLeft, ShiftRight,
+      Equals, NotEquals, Less, LessEquals, Greater, GreaterEquals,
+      AndJump, OrJump
+    };
+
+  public:
+    /**
+      Compile the given expression tree, taking ownership of it.
+    */
+    explicit CompiledExpression(Expression* expression);
+    ~CompiledExpression() = default;
+
+    /**
+      Evaluate the expression in the current state of the emulation.
+    */
+    Int32 evaluate();
+
+    /**
+      The following methods are called by Expression::compile() to append
+      the code for an expression node.
+    */
+    void constant(Int32 value);
+    void unary(Op op, const Expression& operand);
+    void binary(Op op, const Expression& lhs, const Expression& rhs);
+    void logical(Op op, const Expression& lhs, const Expression& rhs);
+    void method(CpuMethod method);
+    void method(TiaMethod method);
+    void method(RiotMethod method);
+    void method(CartMethod method);
+    void equate(const string& label);
+    void function(const string& label);
+    void byteDeref(const Expression& address, const Expression* offset = nullptr);
+    void wordDeref(const Expression& address);
+    void call(const Expression& expression);
+
+  private:
+    struct Instruction {
+      Op op{Op::Const};
+      Int32 arg{0};
+    };
+
+    // Sources of the values fetched before running the program
+    enum class Source: uInt8 {
+      Cpu, Tia, Riot, Cart, Equate, Ram, RamWord
+    };
+    struct Input {
+      Source source{Source::Cpu};
+      uInt16 index{0};  // method/label index or RAM address
+    };
+
+  private:
+    // Compile a subexpression, and answer whether it was reduced to a constant
+    bool compileOperand(const Expression& expression);
+
+    // Append an instruction, which changes the stack depth by 'depth'
+    void emit(Op op, Int32 arg, Int32 depth);
+
+    // Append an instruction loading the given input, adding it if necessary
+    void input(Source source, uInt16 index);
+
+    // Replace the code starting at 'start' by its (constant) result
+    void fold(size_t start);
+
+    // Run the code starting at 'start' and return the value left on the stack
+    Int32 run(size_t start);
+
+    // Fetch the current value of an input
+    Int32 fetch(const Input& input, const Debugger& debugger,
+                const uInt8* ram) const;
+
+    // Answer whether the address is always mapped to zero-page RAM
+    static bool isRAM(uInt16 address) { return (address & 0x1280) == 0x0080; }
+
+  private:
+    unique_ptr<Expression> myExpression;
+
+    vector<Instruction> myCode;
+    vector<Int32> myStack;
+    Int32 myDepth{0};
+
+    vector<Input> myInputs;
+    vector<Int32> myInputValues;
+
+    vector<CpuMethod> myCpuMethods;
+    vector<TiaMethod> myTiaMethods;
+    vector<RiotMethod> myRiotMethods;
+    vector<CartMethod> myCartMethods;
+    StringList myLabels;
+    vector<const Expression*> myCalls;
+
+    // The result only depends on the inputs, so it can be reused
+    bool myCacheable{true};
+    bool myResultValid{false};
+    Int32 myResult{0};
+
+  private:
+    // Following constructors and assignment operators not supported
+    CompiledExpression() = delete;
+    CompiledExpression(const CompiledExpression&) = delete;
+    CompiledExpression(CompiledExpression&&) = delete;
+    CompiledExpression& operator=(const CompiledExpression&) = delete;
+    CompiledExpression& operator=(CompiledExpression&&) = delete;
+};
+
+#endif
@@ -41,6 +41,10 @@
 #include "CpuDebug.hxx"
 #include "RiotDebug.hxx"
 #include "TIADebug.hxx"
+#include "TraceRecorder.hxx"
+#include "Profiler.hxx"
+#include "ThumbProfiler.hxx"
+#include "Thumbulator.hxx"
 
 #include "TiaInfoWidget.hxx"
 #include "TiaOutputWidget.hxx"
@@ -337,10 +341,7 @@ int Debugger::trace()
       setBreakPoint(targetPC, bank, BreakpointMap::ONE_SHOT);
     }
 
-    unlockSystem();
-    mySystem.m6502().execute(11900000); // max. ~10 seconds
-    myOSystem.console().tia().flushLineCache();
-    lockSystem();
+    runCycles(11900000); // max. ~10 seconds
 
     addState("trace");
     return int(mySystem.cycles() - startCycle);
@@ -349,6 +350,22 @@ int Debugger::trace()
     return step();
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// Run the CPU at full speed for the given number of cycles, stopping early
+// at breakpoints, traps and conditional breaks. Unlike stepping, there are
+// no scanline updates between the instructions.
+int Debugger::runCycles(uInt64 cycles)
+{
+  uInt64 startCycle = mySystem.cycles();
+
+  unlockSystem();
+  mySystem.m6502().execute(cycles);
+  myOSystem.console().tia().flushLineCache();
+  lockSystem();
+
+  return int(mySystem.cycles() - startCycle);
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 bool Debugger::setBreakPoint(uInt16 addr, uInt8 bank, uInt32 flags)
 {
@@ -646,6 +663,73 @@ bool Debugger::patchROM(uInt16 addr, uInt8 value)
   return myConsole.cartridge().patch(addr, value);
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool Debugger::startTraceRecording(const string& filename)
+{
+  if(!myTraceRecorder)
+    myTraceRecorder = make_unique<TraceRecorder>();
+
+  mySystem.m6502().setTraceRecorder(nullptr);
+  if(!myTraceRecorder->start(filename, mySystem.cycles()))
+    return false;
+
+  mySystem.m6502().setTraceRecorder(myTraceRecorder.get());
+  return true;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool Debugger::stopTraceRecording()
+{
+  mySystem.m6502().setTraceRecorder(nullptr);
+
+  return myTraceRecorder ? myTraceRecorder->stop() : true;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void Debugger::startProfiling()
+{
+  if(!myProfiler)
+    myProfiler = make_unique<Profiler>();
+
+  myProfiler->start(myConsole.tia().frameCount());
+  mySystem.m6502().setProfiler(myProfiler.get());
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void Debugger::stopProfiling()
+{
+  mySystem.m6502().setProfiler(nullptr);
+
+  if(myProfiler)
+    myProfiler->stop(myConsole.tia().frameCount(), mySystem.cycles());
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool Debugger::startArmProfiling()
+{
+  Thumbulator* thumb = myConsole.cartridge().thumbulator();
+  if(!thumb)
+    return false;
+
+  if(!myThumbProfiler)
+    myThumbProfiler = make_unique<ThumbProfiler>();
+
+  myThumbProfiler->start(myConsole.tia().frameCount());
+  thumb->setProfiler(myThumbProfiler.get());
+  return true;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void Debugger::stopArmProfiling()
+{
+  Thumbulator* thumb = myConsole.cartridge().thumbulator();
+  if(thumb)
+    thumb->setProfiler(nullptr);
+
+  if(myThumbProfiler)
+    myThumbProfiler->stop(myConsole.tia().frameCount());
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void Debugger::saveOldState(bool clearDirtyPages)
 {
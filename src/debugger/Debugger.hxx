@@ -40,6 +40,9 @@ class RiotDebug;
 class TIADebug;
 class DebuggerParser;
 class RewindManager;
+class TraceRecorder;
+class Profiler;
+class ThumbProfiler;
 
 #include <map>
 
@@ -260,6 +263,32 @@ class Debugger : public DialogContainer
 
     bool patchROM(uInt16 addr, uInt8 value);
 
+    /**
+      Start/stop recording every executed instruction into a binary file
+      (see TraceRecorder for its format).  Recording continues while the
+      emulation runs outside of the debugger.
+    */
+    bool startTraceRecording(const string& filename);
+    bool stopTraceRecording();
+    const TraceRecorder* traceRecorder() const { return myTraceRecorder.get(); }
+
+    /**
+      Start/stop counting the cycles spent per ROM address, bank, scanline
+      and labelled routine (see Profiler).  Profiling continues while the
+      emulation runs outside of the debugger.
+    */
+    void startProfiling();
+    void stopProfiling();
+    const Profiler* profiler() const { return myProfiler.get(); }
+
+    /**
+      Start/stop profiling the ARM code of the cart (see ThumbProfiler).
+      Starting fails if the cart doesn't contain an ARM processor.
+    */
+    bool startArmProfiling();
+    void stopArmProfiling();
+    const ThumbProfiler* armProfiler() const { return myThumbProfiler.get(); }
+
     /**
       Normally, accessing RAM or ROM during emulation can possibly trigger
       bankswitching or other inadvertent changes.  However, when we're in
@@ -305,6 +334,7 @@ class Debugger : public DialogContainer
 
     int step(bool save = true);
     int trace();
+    int runCycles(uInt64 cycles);
     void nextScanline(int lines);
     void nextFrame(int frames);
     uInt16 rewindStates(const uInt16 numStates, string& message);
@@ -342,6 +372,9 @@ class Debugger : public DialogContainer
     unique_ptr<CpuDebug>       myCpuDebug;
     unique_ptr<RiotDebug>      myRiotDebug;
     unique_ptr<TIADebug>       myTiaDebug;
+    unique_ptr<TraceRecorder>  myTraceRecorder;
+    unique_ptr<Profiler>       myProfiler;
+    unique_ptr<ThumbProfiler>  myThumbProfiler;
 
     static Debugger* myStaticDebugger;
 
@@ -18,8 +18,6 @@
 #ifndef DEBUGGER_EXPRESSIONS_HXX
 #define DEBUGGER_EXPRESSIONS_HXX
 
-#include <functional>
-
 #include "bspf.hxx"
 #include "CartDebug.hxx"
 #include "CpuDebug.hxx"
@@ -27,6 +25,7 @@
 #include "TIADebug.hxx"
 #include "Debugger.hxx"
 #include "Expression.hxx"
+#include "CompiledExpression.hxx"
 
 /**
   All expressions currently supported by the debugger.
@@ -40,6 +39,8 @@ class BinAndExpression : public Expression
     BinAndExpression(Expression* left, Expression* right) : Expression(left, right) { }
     Int32 evaluate() const override
       { return myLHS->evaluate() & myRHS->evaluate(); }
+    void compile(CompiledExpression& program) const override
+      { program.binary(CompiledExpression::Op::BinAnd, *myLHS, *myRHS); }
 };
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -49,6 +50,8 @@ class BinNotExpression : public Expression
     BinNotExpression(Expression* left) : Expression(left) { }
     Int32 evaluate() const override
       { return ~(myLHS->evaluate()); }
+    void compile(CompiledExpression& program) const override
+      { program.unary(CompiledExpression::Op::BinNot, *myLHS); }
 };
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -58,6 +61,8 @@ class BinOrExpression : public Expression
     BinOrExpression(Expression* left, Expression* right) : Expression(left, right) { }
     Int32 evaluate() const override
       { return myLHS->evaluate() | myRHS->evaluate(); }
+    void compile(CompiledExpression& program) const override
+      { program.binary(CompiledExpression::Op::BinOr, *myLHS, *myRHS); }
 };
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -67,6 +72,8 @@ class BinXorExpression : public Expression
     BinXorExpression(Expression* left, Expression* right) : Expression(left, right) { }
     Int32 evaluate() const override
       { return myLHS->evaluate() ^ myRHS->evaluate(); }
+    void compile(CompiledExpression& program) const override
+      { program.binary(CompiledExpression::Op::BinXor, *myLHS, *myRHS); }
 };
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -76,6 +83,8 @@ class ByteDerefExpression : public Expression
     ByteDerefExpression(Expression* left): Expression(left) { }
     Int32 evaluate() const override
       { return Debugger::debugger().peek(myLHS->evaluate()); }
+    void compile(CompiledExpression& program) const override
+      { program.byteDeref(*myLHS); }
 };
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -85,6 +94,8 @@ class ByteDerefOffsetExpression : public Expression
     ByteDerefOffsetExpression(Expression* left, Expression* right) : Expression(left, right) { }
     Int32 evaluate() const override
       { return Debugger::debugger().peek(myLHS->evaluate() + myRHS->evaluate()); }
+    void compile(CompiledExpression& program) const override
+      { program.byteDeref(*myLHS, myRHS.get()); }
 };
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -94,6 +105,8 @@ class ConstExpression : public Expression
     ConstExpression(const int value) : Expression(), myValue(value) { }
     Int32 evaluate() const override
       { return myValue; }
+    void compile(CompiledExpression& program) const override
+      { program.constant(myValue); }
 
   private:
     int myValue;
@@ -103,12 +116,14 @@ class ConstExpression : public Expression
 class CpuMethodExpression : public Expression
 {
   public:
-    CpuMethodExpression(CpuMethod method) : Expression(), myMethod(std::mem_fn(method)) { }
+    CpuMethodExpression(CpuMethod method) : Expression(), myMethod(method) { }
     Int32 evaluate() const override
-      { return myMethod(Debugger::debugger().cpuDebug()); }
+      { return (Debugger::debugger().cpuDebug().*myMethod)(); }
+    void compile(CompiledExpression& program) const override
+      { program.method(myMethod); }
 
   private:
-    std::function<int(const CpuDebug&)> myMethod;
+    CpuMethod myMethod;
 };
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -119,6 +134,8 @@ class DivExpression : public Expression
     Int32 evaluate() const override
       { int denom = myRHS->evaluate();
         return denom == 0 ? 0 : myLHS->evaluate() / denom; }
+    void compile(CompiledExpression& program) const override
+      { program.binary(CompiledExpression::Op::Div, *myLHS, *myRHS); }
 };
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -128,6 +145,8 @@ class EqualsExpression : public Expression
     EqualsExpression(Expression* left, Expression* right) : Expression(left, right) { }
     Int32 evaluate() const override
       { return myLHS->evaluate() == myRHS->evaluate(); }
+    void compile(CompiledExpression& program) const override
+      { program.binary(CompiledExpression::Op::Equals, *myLHS, *myRHS); }
 };
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -137,6 +156,8 @@ class EquateExpression : public Expression
     EquateExpression(const string& label) : Expression(), myLabel(label) { }
     Int32 evaluate() const override
       { return Debugger::debugger().cartDebug().getAddress(myLabel); }
+    void compile(CompiledExpression& program) const override
+      { program.equate(myLabel); }
 
   private:
     string myLabel;
@@ -149,6 +170,8 @@ class FunctionExpression : public Expression
     FunctionExpression(const string& label) : Expression(), myLabel(label) { }
     Int32 evaluate() const override
       { return Debugger::debugger().getFunction(myLabel).evaluate(); }
+    void compile(CompiledExpression& program) const override
+      { program.function(myLabel); }
 
   private:
     string myLabel;
@@ -161,6 +184,8 @@ class GreaterEqualsExpression : public Expression
     GreaterEqualsExpression(Expression* left, Expression* right) : Expression(left, right) { }
     Int32 evaluate() const override
       { return myLHS->evaluate() >= myRHS->evaluate(); }
+    void compile(CompiledExpression& program) const override
+      { program.binary(CompiledExpression::Op::GreaterEquals, *myLHS, *myRHS); }
 };
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -170,6 +195,8 @@ class GreaterExpression : public Expression
     GreaterExpression(Expression* left, Expression* right) : Expression(left, right) { }
     Int32 evaluate() const override
       { return myLHS->evaluate() > myRHS->evaluate(); }
+    void compile(CompiledExpression& program) const override
+      { program.binary(CompiledExpression::Op::Greater, *myLHS, *myRHS); }
 };
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -179,6 +206,8 @@ class HiByteExpression : public Expression
     HiByteExpression(Expression* left) : Expression(left) { }
     Int32 evaluate() const override
       { return 0xff & (myLHS->evaluate() >> 8); }
+    void compile(CompiledExpression& program) const override
+      { program.unary(CompiledExpression::Op::HiByte, *myLHS); }
 };
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -188,6 +217,8 @@ class LessEqualsExpression : public Expression
     LessEqualsExpression(Expression* left, Expression* right) : Expression(left, right) { }
     Int32 evaluate() const override
       { return myLHS->evaluate() <= myRHS->evaluate(); }
+    void compile(CompiledExpression& program) const override
+      { program.binary(CompiledExpression::Op::LessEquals, *myLHS, *myRHS); }
 };
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -197,6 +228,8 @@ class LessExpression : public Expression
     LessExpression(Expression* left, Expression* right) : Expression(left, right) { }
     Int32 evaluate() const override
       { return myLHS->evaluate() < myRHS->evaluate(); }
+    void compile(CompiledExpression& program) const override
+      { program.binary(CompiledExpression::Op::Less, *myLHS, *myRHS); }
 };
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -206,6 +239,8 @@ class LoByteExpression : public Expression
     LoByteExpression(Expression* left) : Expression(left) { }
     Int32 evaluate() const override
       { return 0xff & myLHS->evaluate(); }
+    void compile(CompiledExpression& program) const override
+      { program.unary(CompiledExpression::Op::LoByte, *myLHS); }
 };
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -215,6 +250,8 @@ class LogAndExpression : public Expression
     LogAndExpression(Expression* left, Expression* right) : Expression(left, right) { }
     Int32 evaluate() const override
       { return myLHS->evaluate() && myRHS->evaluate(); }
+    void compile(CompiledExpression& program) const override
+      { program.logical(CompiledExpression::Op::AndJump, *myLHS, *myRHS); }
 };
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -224,6 +261,8 @@ class LogNotExpression : public Expression
     LogNotExpression(Expression* left) : Expression(left) { }
     Int32 evaluate() const override
       { return !(myLHS->evaluate()); }
+    void compile(CompiledExpression& program) const override
+      { program.unary(CompiledExpression::Op::LogNot, *myLHS); }
 };
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -233,6 +272,8 @@ class LogOrExpression : public Expression
     LogOrExpression(Expression* left, Expression* right) : Expression(left, right) { }
     Int32 evaluate() const override
       { return myLHS->evaluate() || myRHS->evaluate(); }
+    void compile(CompiledExpression& program) const override
+      { program.logical(CompiledExpression::Op::OrJump, *myLHS, *myRHS); }
 };
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -242,6 +283,8 @@ class MinusExpression : public Expression
     MinusExpression(Expression* left, Expression* right) : Expression(left, right) { }
     Int32 evaluate() const override
       { return myLHS->evaluate() - myRHS->evaluate(); }
+    void compile(CompiledExpression& program) const override
+      { program.binary(CompiledExpression::Op::Minus, *myLHS, *myRHS); }
 };
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -252,6 +295,8 @@ class ModExpression : public Expression
     Int32 evaluate() const override
       { int rhs = myRHS->evaluate();
         return rhs == 0 ? 0 : myLHS->evaluate() % rhs; }
+    void compile(CompiledExpression& program) const override
+      { program.binary(CompiledExpression::Op::Mod, *myLHS, *myRHS); }
 };
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -261,6 +306,8 @@ class MultExpression : public Expression
     MultExpression(Expression* left, Expression* right) : Expression(left, right) { }
     Int32 evaluate() const override
       { return myLHS->evaluate() * myRHS->evaluate(); }
+    void compile(CompiledExpression& program) const override
+      { program.binary(CompiledExpression::Op::Mult, *myLHS, *myRHS); }
 };
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -270,6 +317,8 @@ class NotEqualsExpression : public Expression
     NotEqualsExpression(Expression* left, Expression* right) : Expression(left, right) { }
     Int32 evaluate() const override
       { return myLHS->evaluate() != myRHS->evaluate(); }
+    void compile(CompiledExpression& program) const override
+      { program.binary(CompiledExpression::Op::NotEquals, *myLHS, *myRHS); }
 };
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -279,18 +328,22 @@ class PlusExpression : public Expression
     PlusExpression(Expression* left, Expression* right) : Expression(left, right) { }
     Int32 evaluate() const override
       { return myLHS->evaluate() + myRHS->evaluate(); }
+    void compile(CompiledExpression& program) const override
+      { program.binary(CompiledExpression::Op::Plus, *myLHS, *myRHS); }
 };
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 class CartMethodExpression : public Expression
 {
   public:
-    CartMethodExpression(CartMethod method) : Expression(), myMethod(std::mem_fn(method)) { }
+    CartMethodExpression(CartMethod method) : Expression(), myMethod(method) { }
     Int32 evaluate() const override
-      { return myMethod(Debugger::debugger().cartDebug()); }
+      { return (Debugger::debugger().cartDebug().*myMethod)(); }
+    void compile(CompiledExpression& program) const override
+      { program.method(myMethod); }
 
   private:
-    std::function<int(CartDebug&)> myMethod;
+    CartMethod myMethod;
 };
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -300,6 +353,8 @@ class ShiftLeftExpression : public Expression
     ShiftLeftExpression(Expression* left, Expression* right) : Expression(left, right) { }
     Int32 evaluate() const override
       { return myLHS->evaluate() << myRHS->evaluate(); }
+    void compile(CompiledExpression& program) const override
+      { program.binary(CompiledExpression::Op::ShiftLeft, *myLHS, *myRHS); }
 };
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -309,30 +364,36 @@ class ShiftRightExpression : public Expression
     ShiftRightExpression(Expression* left, Expression* right) : Expression(left, right) { }
     Int32 evaluate() const override
       { return myLHS->evaluate() >> myRHS->evaluate(); }
+    void compile(CompiledExpression& program) const override
+      { program.binary(CompiledExpression::Op::ShiftRight, *myLHS, *myRHS); }
 };
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 class RiotMethodExpression : public Expression
 {
   public:
-    RiotMethodExpression(RiotMethod method) : Expression(), myMethod(std::mem_fn(method)) { }
+    RiotMethodExpression(RiotMethod method) : Expression(), myMethod(method) { }
     Int32 evaluate() const override
-      { return myMethod(Debugger::debugger().riotDebug()); }
+      { return (Debugger::debugger().riotDebug().*myMethod)(); }
+    void compile(CompiledExpression& program) const override
+      { program.method(myMethod); }
 
   private:
-    std::function<int(const RiotDebug&)> myMethod;
+    RiotMethod myMethod;
 };
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 class TiaMethodExpression : public Expression
 {
   public:
-    TiaMethodExpression(TiaMethod method) : Expression(), myMethod(std::mem_fn(method)) { }
+    TiaMethodExpression(TiaMethod method) : Expression(), myMethod(method) { }
     Int32 evaluate() const override
-      { return myMethod(Debugger::debugger().tiaDebug()); }
+      { return (Debugger::debugger().tiaDebug().*myMethod)(); }
+    void compile(CompiledExpression& program) const override
+      { program.method(myMethod); }
 
   private:
-    std::function<int(const TIADebug&)> myMethod;
+    TiaMethod myMethod;
 };
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -342,6 +403,8 @@ class UnaryMinusExpression : public Expression
     UnaryMinusExpression(Expression* left) : Expression(left) { }
     Int32 evaluate() const override
       { return -(myLHS->evaluate()); }
+    void compile(CompiledExpression& program) const override
+      { program.unary(CompiledExpression::Op::UnaryMinus, *myLHS); }
 };
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -351,6 +414,8 @@ class WordDerefExpression : public Expression
     WordDerefExpression(Expression* left) : Expression(left) { }
     Int32 evaluate() const override
       { return Debugger::debugger().dpeekAsInt(myLHS->evaluate()); }
+    void compile(CompiledExpression& program) const override
+      { program.wordDeref(*myLHS); }
 };
 
 #endif
@@ -36,6 +36,9 @@
 #include "RomWidget.hxx"
 #include "ProgressDialog.hxx"
 #include "TimerManager.hxx"
+#include "TraceRecorder.hxx"
+#include "Profiler.hxx"
+#include "ThumbProfiler.hxx"
 #include "Vec.hxx"
 
 #include "Base.hxx"
@@ -721,6 +724,25 @@ void DebuggerParser::executeA()
   debugger.cpuDebug().setA(uInt8(args[0]));
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// "armprofile"
+void DebuggerParser::executeArmprofile()
+{
+  const ThumbProfiler* profiler = debugger.armProfiler();
+
+  if(profiler && profiler->isActive())
+  {
+    debugger.stopArmProfiling();
+    commandResult << "ARM profiling stopped after " << dec
+                  << profiler->frames(debugger.tiaDebug().frameCount())
+                  << " frame(s) (see 'savearmprofile')";
+  }
+  else if(debugger.startArmProfiling())
+    commandResult << "ARM profiling started";
+  else
+    commandResult << red("cartridge has no ARM processor");
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 // "aud"
 void DebuggerParser::executeAud()
@@ -1645,6 +1667,28 @@ void DebuggerParser::executePGfx()
   executeDirective(Device::PGFX);
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// "profile"
+void DebuggerParser::executeProfile()
+{
+  const Profiler* profiler = debugger.profiler();
+
+  if(profiler && profiler->isActive())
+  {
+    debugger.stopProfiling();
+
+    const uInt32 frames = profiler->frames(debugger.tiaDebug().frameCount());
+    commandResult << "profiling stopped after " << dec << frames << " frame(s), "
+                  << profiler->cycles() / std::max(frames, 1U)
+                  << " cycles per frame (see 'saveprofile')";
+  }
+  else
+  {
+    debugger.startProfiling();
+    commandResult << "profiling started";
+  }
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 // "print"
 void DebuggerParser::executePrint()
@@ -1740,44 +1784,44 @@ void DebuggerParser::executeRunTo()
 
   debugger.saveOldState();
 
-  uInt32 count = 0, max_iterations = uInt32(list.size());
+  const auto found = [&]() {
+    int pcline = cartdbg.addressToLine(debugger.cpuDebug().pc());
+    return pcline >= 0 &&
+      BSPF::findIgnoreCase(list[pcline].disasm, argStrings[0]) != string::npos;
+  };
+
+  // Collect the addresses of all lines containing the string in advance,
+  // so the CPU doesn't have to be stopped after each instruction
+  vector<uInt16> addresses;
+  for(uInt32 i = 0; i < list.size(); ++i)
+    if(BSPF::findIgnoreCase(list[i].disasm, argStrings[0]) != string::npos &&
+       cartdbg.addressToLine(list[i].address) == int(i))
+      addresses.push_back(list[i].address);
 
   // Create a progress dialog box to show the progress searching through the
   // disassembly, since this may be a time-consuming operation
   ostringstream buf;
   ProgressDialog progress(debugger.baseDialog(), debugger.lfont());
 
-  buf << "RunTo searching through " << max_iterations << " disassembled instructions"
+  buf << "RunTo searching for " << addresses.size() << " disassembled instructions"
     << progress.ELLIPSIS;
   progress.setMessage(buf.str());
-  progress.setRange(0, max_iterations, 5);
+  progress.setRange(0, RUNTO_MAX_FRAMES, 5);
   progress.open();
 
-  bool done = false;
-  do {
-    debugger.step(false);
-
-    // Update romlist to point to current PC
-    int pcline = cartdbg.addressToLine(debugger.cpuDebug().pc());
-    if(pcline >= 0)
-    {
-      const string& next = list[pcline].disasm;
-      done = (BSPF::findIgnoreCase(next, argStrings[0]) != string::npos);
-    }
-    // Update the progress bar
-    progress.incProgress();
-  } while(!done && ++count < max_iterations && !progress.isCancelled());
+  uInt64 cycles = debugger.step(false);
+  bool done = found();
+  if(!done && !addresses.empty())
+    done = runToAddresses(addresses, found, progress, RUNTO_MAX_FRAMES, cycles);
 
   progress.close();
 
   if(done)
     commandResult
-      << "found " << argStrings[0] << " in " << dec << count
-      << " disassembled instructions";
+      << "found " << argStrings[0] << " after " << dec << cycles << " cycles";
   else
     commandResult
-      << argStrings[0] << " not found in " << dec << count
-      << " disassembled instructions";
+      << argStrings[0] << " not found after " << dec << cycles << " cycles";
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -1789,8 +1833,11 @@ void DebuggerParser::executeRunToPc()
 
   debugger.saveOldState();
 
-  uInt32 count = 0;
-  bool done = false;
+  const auto found = [&]() {
+    int pcline = cartdbg.addressToLine(debugger.cpuDebug().pc());
+    return (pcline >= 0) && (list[pcline].address == args[0]);
+  };
+
   // Create a progress dialog box to show the progress searching through the
   // disassembly, since this may be a time-consuming operation
   ostringstream buf;
@@ -1801,25 +1848,21 @@ void DebuggerParser::executeRunToPc()
   progress.setRange(0, 100000, 5);
   progress.open();
 
-  do {
-    debugger.step(false);
+  uInt64 cycles = debugger.step(false);
+  bool done = found();
+  if(!done)
+    done = runToAddresses({ uInt16(args[0]) }, found, progress, 0, cycles);
 
-    // Update romlist to point to current PC
-    int pcline = cartdbg.addressToLine(debugger.cpuDebug().pc());
-    done = (pcline >= 0) && (list[pcline].address == args[0]);
-    progress.incProgress();
-    ++count;
-  } while(!done && !progress.isCancelled());
   progress.close();
 
   if(done)
     commandResult
-      << "Set PC to $" << Base::HEX4 << args[0] << " in "
-      << dec << count << " instructions";
+      << "Set PC to $" << Base::HEX4 << args[0] << " after "
+      << dec << cycles << " cycles";
   else
     commandResult
-      << "PC $" << Base::HEX4 << args[0] << " not reached or found in "
-      << dec << count << " instructions";
+      << "PC $" << Base::HEX4 << args[0] << " not reached or found after "
+      << dec << cycles << " cycles";
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -1843,6 +1886,40 @@ void DebuggerParser::executeSaveAccess()
   commandResult << debugger.cartDebug().saveAccessFile();
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// "savearmprofile"
+void DebuggerParser::executeSavearmprofile()
+{
+  const ThumbProfiler* profiler = debugger.armProfiler();
+  if(!profiler)
+  {
+    commandResult << red("no ARM profile (see 'armprofile')");
+    return;
+  }
+
+  const string& rom = debugger.myOSystem.console().properties().get(PropType::Cart_Name);
+  stringstream report, stacks;
+  report << "ARM profile for '" << rom << "'" << endl
+         << profiler->report(debugger.tiaDebug().frameCount());
+  stacks << profiler->foldedStacks();
+
+  try
+  {
+    const string path = debugger.myOSystem.defaultSaveDir().getPath() + rom;
+    FilesystemNode reportNode(path + ".armprofile.txt");
+    FilesystemNode stacksNode(path + ".armprofile.folded");
+
+    reportNode.write(report);
+    stacksNode.write(stacks);
+    commandResult << "saved ARM profile as " << reportNode.getShortPath()
+                  << " and " << stacksNode.getShortPath();
+  }
+  catch(...)
+  {
+    commandResult << red("failed to save ARM profile");
+  }
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 // "saveconfig"
 void DebuggerParser::executeSaveconfig()
@@ -1857,6 +1934,50 @@ void DebuggerParser::executeSavedisassembly()
   commandResult << debugger.cartDebug().saveDisassembly();
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// "saveprofile"
+void DebuggerParser::executeSaveprofile()
+{
+  const Profiler* profiler = debugger.profiler();
+  if(!profiler)
+  {
+    commandResult << red("no profile (see 'profile')");
+    return;
+  }
+
+  Profiler::Order order = Profiler::Order::Cycles;
+  if(argCount == 1)
+  {
+    if(argStrings[0] == "count")
+      order = Profiler::Order::Instructions;
+    else if(argStrings[0] == "address")
+      order = Profiler::Order::Address;
+    else if(argStrings[0] != "cycles")
+    {
+      outputCommandError("invalid order (must be \"cycles\", \"count\" or \"address\")",
+                         myCommand);
+      return;
+    }
+  }
+
+  const string& rom = debugger.myOSystem.console().properties().get(PropType::Cart_Name);
+  stringstream out;
+  out << "Profile for '" << rom << "'" << endl
+      << profiler->report(debugger.cartDebug(), debugger.tiaDebug().frameCount(), order);
+
+  try
+  {
+    FilesystemNode node(debugger.myOSystem.defaultSaveDir().getPath() + rom + ".profile.txt");
+
+    node.write(out);
+    commandResult << "saved profile as " << node.getShortPath();
+  }
+  catch(...)
+  {
+    commandResult << red("failed to save profile");
+  }
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 // "saverom"
 void DebuggerParser::executeSaverom()
@@ -1955,9 +2076,7 @@ void DebuggerParser::executeStepwhile()
     commandResult << red("invalid expression");
     return;
   }
-  Expression* expr = YaccParser::getResult();
-  int ncycles = 0;
-  uInt32 count = 0;
+  unique_ptr<Expression> expr(YaccParser::getResult());
 
   // Create a progress dialog box to show the progress searching through the
   // disassembly, since this may be a time-consuming operation
@@ -1970,15 +2089,63 @@ void DebuggerParser::executeStepwhile()
   progress.setRange(0, 100000, 5);
   progress.open();
 
-  do {
-    ncycles += debugger.step(false);
+  uInt64 cycles = debugger.step(false);
+  if(expr->evaluate())
+  {
+    // Let the CPU run at full speed, with a temporary conditional
+    // breakpoint stopping it as soon as the condition is false
+    YaccParser::parse(("!(" + argStrings[0] + ")").c_str());
+    uInt32 idx = debugger.m6502().addCondBreak(YaccParser::getResult(), "stepwhile");
 
-    progress.incProgress();
-    ++count;
-  } while (expr->evaluate() && !progress.isCancelled());
+    runUntil([&]() { return !expr->evaluate(); }, progress, 0, cycles);
+
+    debugger.m6502().delCondBreak(idx);
+  }
 
   progress.close();
-  commandResult << "executed " << ncycles << " cycles";
+  commandResult << "executed " << cycles << " cycles";
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool DebuggerParser::runToAddresses(const vector<uInt16>& addresses,
+                                    const std::function<bool()>& done,
+                                    ProgressDialog& progress, uInt32 maxFrames,
+                                    uInt64& cycles)
+{
+  // Temporary breakpoints stop the CPU at the addresses; these are valid for
+  // all mirrors and banks, just like the lines found in the disassembly
+  vector<uInt16> added;
+  for(uInt16 addr: addresses)
+    if(debugger.setBreakPoint(addr & 0x1fff, BreakpointMap::ANY_BANK,
+                              BreakpointMap::ONE_SHOT))
+      added.push_back(addr & 0x1fff);
+
+  bool found = runUntil(done, progress, maxFrames, cycles);
+
+  for(uInt16 addr: added)
+    debugger.clearBreakPoint(addr, BreakpointMap::ANY_BANK);
+
+  return found;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool DebuggerParser::runUntil(const std::function<bool()>& done,
+                              ProgressDialog& progress, uInt32 maxFrames,
+                              uInt64& cycles)
+{
+  // Run a frame at a time, so the progress can be shown and the user can
+  // cancel. Other breakpoints and traps only interrupt the current frame.
+  for(uInt32 frame = 0; maxFrames == 0 || frame < maxFrames; ++frame)
+  {
+    cycles += debugger.runCycles(RUN_CYCLES_PER_FRAME);
+    if(done())
+      return true;
+
+    progress.incProgress();
+    if(progress.isCancelled())
+      break;
+  }
+  return false;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -1995,6 +2162,50 @@ void DebuggerParser::executeTrace()
   commandResult << "executed " << dec << debugger.trace() << " cycles";
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// "tracelog"
+void DebuggerParser::executeTracelog()
+{
+  const TraceRecorder* recorder = debugger.traceRecorder();
+
+  if(recorder && recorder->isRecording())
+  {
+    const FilesystemNode node(recorder->filename());
+    const uInt64 records = recorder->records();
+
+    if(!debugger.stopTraceRecording())
+    {
+      commandResult << red("error writing trace log '" + node.getShortPath() + "'");
+      return;
+    }
+    commandResult << "trace log stopped, " << dec << records
+                  << " instructions saved to '" << node.getShortPath() << "'";
+    if(argCount == 0)
+      return;
+    commandResult << endl;
+  }
+
+  ostringstream filename;
+  filename << debugger.myOSystem.defaultSaveDir();
+  if(argCount == 0)
+  {
+    auto timeinfo = BSPF::localTime();
+    filename << std::put_time(&timeinfo, "trace_%F_%H-%M-%S.trace");
+  }
+  else
+  {
+    filename << argStrings[0];
+    if(argStrings[0].find_last_of('.') == string::npos)
+      filename << ".trace";
+  }
+  const FilesystemNode node(filename.str());
+
+  if(debugger.startTraceRecording(node.getPath()))
+    commandResult << "trace log started, saving to '" << node.getShortPath() << "'";
+  else
+    commandResult << red("unable to create trace log '" + node.getShortPath() + "'");
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 // "trap"
 void DebuggerParser::executeTrap()
@@ -2328,7 +2539,7 @@ void DebuggerParser::executeZ()
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 // List of all commands available to the parser
-std::array<DebuggerParser::Command, 100> DebuggerParser::commands = { {
+std::array<DebuggerParser::Command, 105> DebuggerParser::commands = { {
   {
     "a",
     "Set Accumulator to <value>",
@@ -2339,6 +2550,17 @@ std::array<DebuggerParser::Command, 100> DebuggerParser::commands = { {
     std::mem_fn(&DebuggerParser::executeA)
   },
 
+  {
+    "armprofile",
+    "Start/stop profiling the ARM code of the cart",
+    "Counts ARM cycles per address and call site (BUS/CDF/DPC+ carts)\n"
+    "Example: armprofile (no parameters)",
+    false,
+    false,
+    { Parameters::ARG_END_ARGS },
+    std::mem_fn(&DebuggerParser::executeArmprofile)
+  },
+
   {
     "aud",
     "Mark 'AUD' range in disassembly",
@@ -2926,6 +3148,17 @@ std::array<DebuggerParser::Command, 100> DebuggerParser::commands = { {
     std::mem_fn(&DebuggerParser::executePGfx)
   },
 
+  {
+    "profile",
+    "Start/stop profiling the cycles spent per address",
+    "Counts cycles per ROM address, bank, scanline and labelled routine\n"
+    "Example: profile (no parameters)",
+    false,
+    false,
+    { Parameters::ARG_END_ARGS },
+    std::mem_fn(&DebuggerParser::executeProfile)
+  },
+
   {
     "print",
     "Evaluate/print expression xx in hex/dec/binary",
@@ -3059,6 +3292,16 @@ std::array<DebuggerParser::Command, 100> DebuggerParser::commands = { {
       std::mem_fn(&DebuggerParser::executeSaveAccess)
   },
 
+  {
+    "savearmprofile",
+    "Save the ARM profile and its flame graph stacks",
+    "Example: savearmprofile (no parameters)",
+    false,
+    false,
+    { Parameters::ARG_END_ARGS },
+    std::mem_fn(&DebuggerParser::executeSavearmprofile)
+  },
+
   {
     "saveconfig",
     "Save Distella config file (with default name)",
@@ -3080,6 +3323,16 @@ std::array<DebuggerParser::Command, 100> DebuggerParser::commands = { {
     std::mem_fn(&DebuggerParser::executeSavedisassembly)
   },
 
+  {
+    "saveprofile",
+    "Save the profile, sorted by cycles/count/address",
+    "Example: saveprofile, saveprofile count, saveprofile address",
+    false,
+    false,
+    { Parameters::ARG_LABEL, Parameters::ARG_END_ARGS },
+    std::mem_fn(&DebuggerParser::executeSaveprofile)
+  },
+
   {
     "saverom",
     "Save (possibly patched) ROM (with default name)",
@@ -3193,6 +3446,17 @@ std::array<DebuggerParser::Command, 100> DebuggerParser::commands = { {
     std::mem_fn(&DebuggerParser::executeTrace)
   },
 
+  {
+    "tracelog",
+    "Start/stop logging executed instructions [to file xx]",
+    "Saves a binary log, which can be decoded with 'tracediff'\n"
+    "Example: tracelog, tracelog mygame",
+    false,
+    false,
+    { Parameters::ARG_FILE, Parameters::ARG_END_ARGS },
+    std::mem_fn(&DebuggerParser::executeTracelog)
+  },
+
   {
     "trap",
     "Trap read/write access to address(es) xx [yy]",
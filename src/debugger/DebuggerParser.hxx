@@ -24,6 +24,7 @@
 class Debugger;
 class Settings;
 class FilesystemNode;
+class ProgressDialog;
 struct Command;
 
 #include "bspf.hxx"
@@ -66,6 +67,19 @@ class DebuggerParser
     string eval();
     string saveScriptFile(string file);
 
+    // Run the CPU at full speed until 'done' answers true after reaching
+    // one of the given addresses, the user cancels or 'maxFrames' frames
+    // have been executed (0 = no limit)
+    bool runToAddresses(const vector<uInt16>& addresses,
+                        const std::function<bool()>& done,
+                        ProgressDialog& progress, uInt32 maxFrames,
+                        uInt64& cycles);
+    // Run the CPU at full speed until 'done' answers true (checked after
+    // each breakpoint and frame), the user cancels or 'maxFrames' frames
+    // have been executed (0 = no limit)
+    bool runUntil(const std::function<bool()>& done,
+                  ProgressDialog& progress, uInt32 maxFrames, uInt64& cycles);
+
   private:
     // Constants for argument processing
     enum class ParseState {
@@ -98,7 +112,12 @@ class DebuggerParser
       std::array<Parameters, 10> parms;
       std::function<void (DebuggerParser*)> executor;
     };
-    static std::array<Command, 100> commands;
+    static std::array<Command, 105> commands;
+
+    // The number of cycles 'runto' and friends execute between updating the
+    // progress (about one frame), and the frames 'runto' searches at most
+    static constexpr uInt64 RUN_CYCLES_PER_FRAME = 76 * 262;
+    static constexpr uInt32 RUNTO_MAX_FRAMES = 600;
 
     struct Trap
     {
@@ -145,6 +164,7 @@ class DebuggerParser
 
     // List of available command methods
     void executeA();
+    void executeArmprofile();
     void executeAud();
     void executeBase();
     void executeBCol();
@@ -203,6 +223,7 @@ class DebuggerParser
     void executePc();
     void executePCol();
     void executePGfx();
+    void executeProfile();
     void executePrint();
     void executeRam();
     void executeReset();
@@ -216,9 +237,11 @@ class DebuggerParser
     void executeS();
     void executeSave();
     void executeSaveAccess();
+    void executeSavearmprofile();
     void executeSaveallstates();
     void executeSaveconfig();
     void executeSavedisassembly();
+    void executeSaveprofile();
     void executeSaverom();
     void executeSaveses();
     void executeSavesnap();
@@ -229,6 +252,7 @@ class DebuggerParser
     void executeStepwhile();
     void executeTia();
     void executeTrace();
+    void executeTracelog();
     void executeTrap();
     void executeTrapif();
     void executeTrapread();
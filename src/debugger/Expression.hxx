@@ -18,6 +18,8 @@
 #ifndef EXPRESSION_HXX
 #define EXPRESSION_HXX
 
+class CompiledExpression;
+
 #include "bspf.hxx"
 
 /**
@@ -37,6 +39,13 @@ class Expression
 
     virtual Int32 evaluate() const { return 0; }
 
+    /**
+      Append the code which evaluates this expression to the given program
+      (see CompiledExpression).  By default, the program simply calls
+      evaluate() on this node.
+    */
+    virtual void compile(CompiledExpression& program) const;
+
   protected:
     unique_ptr<Expression> myLHS, myRHS;
 
@@ -0,0 +1,186 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2020 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+#include <map>
+
+#include "Base.hxx"
+#include "CartDebug.hxx"
+#include "Profiler.hxx"
+
+using Common::Base;
+
+namespace {
+  // One line of a report section
+  struct Entry {
+    uInt32 key{0};  // sort key for Order::Address
+    string name;
+    uInt64 cycles{0};
+    uInt64 instructions{0};
+  };
+
+  void printSection(ostream& buf, const string& title, const string& heading,
+                    vector<Entry>& entries, Profiler::Order order,
+                    uInt64 totalCycles, uInt32 frames)
+  {
+    switch(order)
+    {
+      case Profiler::Order::Cycles:
+        std::stable_sort(entries.begin(), entries.end(),
+            [](const Entry& a, const Entry& b) { return a.cycles > b.cycles; });
+        break;
+      case Profiler::Order::Instructions:
+        std::stable_sort(entries.begin(), entries.end(),
+            [](const Entry& a, const Entry& b) { return a.instructions > b.instructions; });
+        break;
+      case Profiler::Order::Address:
+        std::stable_sort(entries.begin(), entries.end(),
+            [](const Entry& a, const Entry& b) { return a.key < b.key; });
+        break;
+    }
+
+    buf << endl << title << ":" << endl
+        << "      cycles   per frame       %  instructions  " << heading << endl;
+    for(const auto& e: entries)
+    {
+      buf << std::setw(12) << e.cycles << "  "
+          << std::setw(10) << double(e.cycles) / frames << "  "
+          << std::setw(6) << (totalCycles ? 100.0 * e.cycles / totalCycles : 0.0) << "  "
+          << std::setw(12) << e.instructions << "  "
+          << e.name << endl;
+    }
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void Profiler::start(uInt32 frame)
+{
+  myBanks.clear();
+  myScanlines.fill(Counter());
+  myPendingAddress = myPendingScanline = nullptr;
+
+  myStartFrame = myStopFrame = frame;
+  myActive = true;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void Profiler::stop(uInt32 frame, uInt64 cycles)
+{
+  if(!myActive)
+    return;
+
+  finishInstruction(cycles);
+  myPendingAddress = myPendingScanline = nullptr;
+
+  myStopFrame = frame;
+  myActive = false;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+uInt64 Profiler::cycles() const
+{
+  uInt64 cycles = 0;
+  for(const auto& counter: myScanlines)
+    cycles += counter.cycles;
+
+  return cycles;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+string Profiler::report(const CartDebug& cartDebug, uInt32 frame, Order order) const
+{
+  const uInt32 numFrames = std::max(frames(frame), 1U);
+  uInt64 totalCycles = 0, totalInstructions = 0;
+  vector<Entry> routines, banks, addresses, scanlines;
+  std::map<uInt32, size_t> routineIndex;
+
+  for(uInt32 bank = 0; bank < myBanks.size(); ++bank)
+  {
+    ostringstream bankName;
+    bankName << std::setw(4) << bank;
+
+    Entry bankEntry;
+    bankEntry.key = bank;
+    bankEntry.name = bankName.str();
+
+    for(const auto& counter: myBanks[bank])
+    {
+      if(counter.instructions == 0)
+        continue;
+
+      const uInt16 pc = counter.pc;
+      const int labelAddr = cartDebug.getNearestLabelAddress(pc);
+      const uInt32 key = (bank << 16) | pc;
+      ostringstream name;
+
+      // Group all addresses following a label into its routine
+      const uInt32 routineKey = labelAddr < 0 ? (bank << 16) : ((bank << 16) | labelAddr);
+      auto iter = routineIndex.find(routineKey);
+      if(iter == routineIndex.end())
+      {
+        Entry routine;
+        routine.key = routineKey;
+        name << std::setw(4) << bank << "  "
+             << (labelAddr < 0 ? "(no label)" : cartDebug.getLabel(labelAddr, true));
+        routine.name = name.str();
+        iter = routineIndex.emplace(routineKey, routines.size()).first;
+        routines.push_back(routine);
+      }
+      routines[iter->second].cycles += counter.cycles;
+      routines[iter->second].instructions += counter.instructions;
+
+      name.str("");
+      name << std::setw(4) << bank << "  $" << Base::HEX4 << pc;
+      if(labelAddr >= 0)
+      {
+        name << "  " << cartDebug.getLabel(labelAddr, true);
+        if(pc != labelAddr)
+          name << "+$" << Base::HEX1 << (pc - labelAddr);
+      }
+      addresses.push_back(Entry{key, name.str(), counter.cycles, counter.instructions});
+
+      bankEntry.cycles += counter.cycles;
+      bankEntry.instructions += counter.instructions;
+    }
+
+    if(bankEntry.instructions > 0)
+    {
+      banks.push_back(bankEntry);
+      totalCycles += bankEntry.cycles;
+      totalInstructions += bankEntry.instructions;
+    }
+  }
+
+  for(uInt32 line = 0; line <= MAX_SCANLINE; ++line)
+    if(myScanlines[line].instructions > 0)
+      scanlines.push_back(Entry{line,
+          std::to_string(line) + (line == MAX_SCANLINE ? "+" : ""),
+          myScanlines[line].cycles, myScanlines[line].instructions});
+
+  ostringstream buf;
+  buf << std::dec << std::fixed << std::setprecision(1) << std::setfill(' ')
+      << "frames: " << frames(frame)
+      << ", instructions: " << totalInstructions
+      << ", cycles: " << totalCycles
+      << " (" << double(totalCycles) / numFrames << " per frame)" << endl;
+
+  printSection(buf, "Routines", "bank  label", routines, order, totalCycles, numFrames);
+  printSection(buf, "Banks", "bank", banks, order, totalCycles, numFrames);
+  printSection(buf, "Addresses", "bank  address", addresses, order, totalCycles, numFrames);
+  printSection(buf, "Scanlines", "scanline", scanlines, order, totalCycles, numFrames);
+
+  return buf.str();
+}
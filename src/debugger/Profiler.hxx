@@ -0,0 +1,134 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2020 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+#ifndef PROFILER_HXX
+#define PROFILER_HXX
+
+class CartDebug;
+
+#include "bspf.hxx"
+
+/**
+  Accumulates the cycles and the number of instructions executed by the
+  6502, per ROM address and bank, and per scanline.  The report groups
+  them by bank and by the labelled routine they belong to as well.
+
+  An instruction is charged with all cycles until the next instruction
+  starts, so the time spent waiting for WSYNC counts for the STA WSYNC.
+*/
+class Profiler
+{
+  public:
+    // Order of the entries in the report
+    enum class Order { Cycles, Instructions, Address };
+
+  public:
+    Profiler() = default;
+    ~Profiler() = default;
+
+    /**
+      Clear all counters, and start profiling at the given frame.
+    */
+    void start(uInt32 frame);
+
+    /**
+      Stop profiling at the given frame and system cycle.
+    */
+    void stop(uInt32 frame, uInt64 cycles);
+
+    bool isActive() const { return myActive; }
+
+    /**
+      Called by the CPU before an instruction is executed.
+    */
+    void next(uInt16 pc, uInt8 bank, uInt32 scanline, uInt64 cycles)
+    {
+      finishInstruction(cycles);
+
+      if(bank >= myBanks.size())
+        myBanks.resize(bank + 1);
+      if(myBanks[bank].empty())
+        myBanks[bank].resize(0x2000);
+
+      myPendingAddress = &myBanks[bank][pc & 0x1fff];
+      myPendingAddress->pc = pc;
+      myPendingScanline = &myScanlines[std::min(scanline, MAX_SCANLINE)];
+      myPendingCycles = cycles;
+    }
+
+    /**
+      Create a report of all counters.
+
+      @param cartDebug  Provides the labels of the routines
+      @param frame      The current frame, if profiling is still active
+      @param order      The order of the entries in each section
+    */
+    string report(const CartDebug& cartDebug, uInt32 frame, Order order) const;
+
+    /**
+      Answers the number of frames and cycles profiled.
+    */
+    uInt32 frames(uInt32 frame) const {
+      return (myActive ? frame : myStopFrame) - myStartFrame;
+    }
+    uInt64 cycles() const;
+
+  private:
+    struct Counter {
+      uInt64 cycles{0};
+      uInt64 instructions{0};
+      uInt16 pc{0};  // full address the code was executed at
+
+      void add(uInt64 c) { cycles += c;  ++instructions; }
+    };
+
+    // Charge the previous instruction with the cycles up to now
+    void finishInstruction(uInt64 cycles)
+    {
+      if(myPendingAddress)
+      {
+        const uInt64 c = cycles - myPendingCycles;
+
+        myPendingAddress->add(c);
+        myPendingScanline->add(c);
+      }
+    }
+
+  private:
+    static constexpr uInt32 MAX_SCANLINE = 511;
+
+    bool myActive{false};
+    uInt32 myStartFrame{0}, myStopFrame{0};
+
+    // 8K of counters for each bank which has been executed
+    vector<vector<Counter>> myBanks;
+    std::array<Counter, MAX_SCANLINE + 1> myScanlines;
+
+    // The instruction currently executed
+    Counter* myPendingAddress{nullptr};
+    Counter* myPendingScanline{nullptr};
+    uInt64 myPendingCycles{0};
+
+  private:
+    // Following constructors and assignment operators not supported
+    Profiler(const Profiler&) = delete;
+    Profiler(Profiler&&) = delete;
+    Profiler& operator=(const Profiler&) = delete;
+    Profiler& operator=(Profiler&&) = delete;
+};
+
+#endif
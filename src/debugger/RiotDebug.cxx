@@ -257,6 +257,12 @@ int RiotDebug::timReadCycles() const
   return mySystem.m6532().myTimReadCycles;
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+const uInt8* RiotDebug::ram() const
+{
+  return mySystem.m6532().getRAM();
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 bool RiotDebug::diffP0(int newVal)
 {
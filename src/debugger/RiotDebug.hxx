@@ -86,6 +86,9 @@ class RiotDebug : public DebuggerSystem
 
     int timReadCycles() const;
 
+    /* Zero-page RAM contents */
+    const uInt8* ram() const;
+
     /* Console switches */
     bool diffP0(int newVal = -1);
     bool diffP1(int newVal = -1);
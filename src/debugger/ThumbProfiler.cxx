@@ -0,0 +1,172 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2020 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+#include "Base.hxx"
+#include "ThumbProfiler.hxx"
+
+using Common::Base;
+
+namespace {
+  // The call site of the code run by the 6507
+  constexpr uInt32 SITE_6507 = 0xFFFFFFFF;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void ThumbProfiler::start(uInt32 frame)
+{
+  myRuns = myCycles = 0;
+  myAddresses.clear();
+  myCallSites.clear();
+  myNodes.resize(1);
+  myChildren.clear();
+  myStack.clear();
+
+  myStartFrame = myStopFrame = frame;
+  myActive = true;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void ThumbProfiler::stop(uInt32 frame)
+{
+  myStopFrame = frame;
+  myActive = false;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void ThumbProfiler::beginRun(uInt32 address)
+{
+  myStack.clear();
+  ++myRuns;
+
+  // The 6507 'calls' the code, which never returns to an ARM address
+  myStack.push_back({node(0, address), SITE_6507, address, SITE_6507, myCycles});
+  myCallSites[{SITE_6507, address}].calls++;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void ThumbProfiler::endRun()
+{
+  while(!myStack.empty())
+    ret();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void ThumbProfiler::call(uInt32 site, uInt32 target)
+{
+  myStack.push_back({node(myStack.back().node, target), site, target, site + 2, myCycles});
+  myCallSites[{site, target}].calls++;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void ThumbProfiler::ret()
+{
+  const Frame& frame = myStack.back();
+
+  myCallSites[{frame.site, frame.target}].cycles += myCycles - frame.startCycles;
+  myStack.pop_back();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+uInt32 ThumbProfiler::node(uInt32 parent, uInt32 function)
+{
+  const auto iter = myChildren.find({parent, function});
+  if(iter != myChildren.end())
+    return iter->second;
+
+  myNodes.push_back({function, parent, 0});
+  return myChildren[{parent, function}] = uInt32(myNodes.size() - 1);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+string ThumbProfiler::report(uInt32 frame) const
+{
+  const uInt32 numFrames = std::max(frames(frame), 1U);
+  const auto percent = [this](uInt64 cycles) {
+    return myCycles ? 100.0 * cycles / myCycles : 0.0;
+  };
+
+  ostringstream buf;
+  buf << std::dec << std::fixed << std::setprecision(1) << std::setfill(' ')
+      << "frames: " << frames(frame) << ", runs: " << myRuns
+      << ", cycles: " << myCycles << " (" << double(myCycles) / numFrames
+      << " per frame)" << endl;
+
+  // Call sites, by the cycles spent in the called function (and below)
+  vector<std::pair<std::pair<uInt32, uInt32>, Counter>> sites(
+      myCallSites.begin(), myCallSites.end());
+  std::stable_sort(sites.begin(), sites.end(), [](const auto& a, const auto& b) {
+    return a.second.cycles > b.second.cycles;
+  });
+
+  buf << endl << "Call sites:" << endl
+      << "      cycles   per frame       %       calls  calls/frame  site      target" << endl;
+  for(const auto& site: sites)
+  {
+    buf << std::setw(12) << site.second.cycles << "  "
+        << std::setw(10) << double(site.second.cycles) / numFrames << "  "
+        << std::setw(6) << percent(site.second.cycles) << "  "
+        << std::setw(10) << site.second.calls << "  "
+        << std::setw(11) << double(site.second.calls) / numFrames << "  "
+        << (site.first.first == SITE_6507 ? "6507    " :
+            Base::toString(site.first.first, Base::Fmt::_16_8))
+        << "  " << Base::toString(site.first.second, Base::Fmt::_16_8) << endl;
+  }
+
+  // Addresses, hottest first
+  vector<std::pair<uInt32, Counter>> addresses(myAddresses.begin(), myAddresses.end());
+  std::sort(addresses.begin(), addresses.end(), [](const auto& a, const auto& b) {
+    return a.second.cycles != b.second.cycles ? a.second.cycles > b.second.cycles
+                                              : a.first < b.first;
+  });
+
+  buf << endl << "Addresses:" << endl
+      << "      cycles   per frame       %  instructions  address" << endl;
+  for(const auto& address: addresses)
+  {
+    buf << std::setw(12) << address.second.cycles << "  "
+        << std::setw(10) << double(address.second.cycles) / numFrames << "  "
+        << std::setw(6) << percent(address.second.cycles) << "  "
+        << std::setw(12) << address.second.instructions << "  "
+        << Base::toString(address.first, Base::Fmt::_16_8) << endl;
+  }
+
+  return buf.str();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+string ThumbProfiler::foldedStacks() const
+{
+  ostringstream buf;
+  vector<uInt32> path;
+
+  for(uInt32 i = 1; i < myNodes.size(); ++i)
+  {
+    if(myNodes[i].cycles == 0)
+      continue;
+
+    path.clear();
+    for(uInt32 n = i; n != 0; n = myNodes[n].parent)
+      path.push_back(myNodes[n].function);
+
+    for(auto f = path.rbegin(); f != path.rend(); ++f)
+      buf << (f == path.rbegin() ? "" : ";") << "0x"
+          << Base::toString(*f, Base::Fmt::_16_8);
+    buf << " " << myNodes[i].cycles << endl;
+  }
+
+  return buf.str();
+}
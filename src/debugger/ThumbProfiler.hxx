@@ -0,0 +1,161 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2020 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+#ifndef THUMB_PROFILER_HXX
+#define THUMB_PROFILER_HXX
+
+#include <map>
+#include <unordered_map>
+
+#include "bspf.hxx"
+
+/**
+  Profiles the ARM code run by the Thumbulator.  For every address, the
+  number of instructions executed and the cycles they took are counted.
+  The cycles are the memory accesses (fetches, reads and writes) the
+  Thumbulator counts anyway.
+
+  Calls (BL and BLX, which set LR to the address following them) are
+  tracked on a shadow stack, which yields the cycles spent per call site
+  (including the functions called from there), and a call tree which can
+  be exported in the 'folded stacks' format used to render flame graphs.
+*/
+class ThumbProfiler
+{
+  public:
+    ThumbProfiler() = default;
+    ~ThumbProfiler() = default;
+
+    /**
+      Clear all counters, and start profiling at the given 6507 frame.
+    */
+    void start(uInt32 frame);
+
+    /**
+      Stop profiling at the given 6507 frame.
+    */
+    void stop(uInt32 frame);
+
+    bool isActive() const { return myActive; }
+
+    /**
+      Answers the number of 6507 frames profiled.
+    */
+    uInt32 frames(uInt32 frame) const {
+      return (myActive ? frame : myStopFrame) - myStartFrame;
+    }
+
+    /**
+      Called by the Thumbulator when it starts running the code at the
+      given address, and after it finished.
+    */
+    void beginRun(uInt32 address);
+    void endRun();
+
+    /**
+      Called by the Thumbulator after an instruction was executed.
+
+      @param address  The address of the instruction
+      @param cycles   The memory cycles used by the instruction
+      @param next     The address of the next instruction
+      @param isCall   Whether the instruction called a function at 'next'
+    */
+    void instruction(uInt32 address, uInt32 cycles, uInt32 next, bool isCall)
+    {
+      Counter& counter = myAddresses[address];
+      counter.instructions++;
+      counter.cycles += cycles;
+
+      myCycles += cycles;
+      myNodes[myStack.back().node].cycles += cycles;
+
+      if(isCall)
+        call(address, next);
+      else if(next == myStack.back().returnAddress)
+        ret();
+    }
+
+    /**
+      Create a report with the per-address histogram and the call sites.
+
+      @param frame  The current 6507 frame, if profiling is still active
+    */
+    string report(uInt32 frame) const;
+
+    /**
+      Create the call tree in the 'folded stacks' format, ie, one line per
+      call stack listing the functions separated by ';', followed by the
+      cycles spent in the innermost function.  This can be rendered by
+      e.g. 'flamegraph.pl'.
+    */
+    string foldedStacks() const;
+
+  private:
+    struct Counter {
+      uInt64 instructions{0};
+      uInt64 cycles{0};
+      uInt64 calls{0};
+    };
+
+    // A function in the call tree, for each path it's been called by
+    struct Node {
+      uInt32 function{0};
+      uInt32 parent{0};
+      uInt64 cycles{0};  // spent in the function itself
+    };
+
+    // An active call
+    struct Frame {
+      uInt32 node{0};
+      uInt32 site{0};
+      uInt32 target{0};
+      uInt32 returnAddress{0};
+      uInt64 startCycles{0};
+    };
+
+  private:
+    void call(uInt32 site, uInt32 target);
+    void ret();
+
+    // Answer the node of the given function called from 'parent'
+    uInt32 node(uInt32 parent, uInt32 function);
+
+  private:
+    bool myActive{false};
+    uInt32 myStartFrame{0}, myStopFrame{0};
+
+    uInt64 myRuns{0};
+    uInt64 myCycles{0};
+
+    std::unordered_map<uInt32, Counter> myAddresses;
+    std::map<std::pair<uInt32, uInt32>, Counter> myCallSites;  // (site, target)
+
+    // Node 0 is the root of all runs
+    vector<Node> myNodes{1};
+    std::map<std::pair<uInt32, uInt32>, uInt32> myChildren;  // (parent, function)
+
+    vector<Frame> myStack;
+
+  private:
+    // Following constructors and assignment operators not supported
+    ThumbProfiler(const ThumbProfiler&) = delete;
+    ThumbProfiler(ThumbProfiler&&) = delete;
+    ThumbProfiler& operator=(const ThumbProfiler&) = delete;
+    ThumbProfiler& operator=(ThumbProfiler&&) = delete;
+};
+
+#endif
@@ -0,0 +1,129 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2020 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+#include "TraceRecorder.hxx"
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+TraceRecorder::~TraceRecorder()
+{
+  stop();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool TraceRecorder::start(const string& filename, uInt64 cycles)
+{
+  stop();
+
+  myFile.open(filename, std::ios::out | std::ios::binary | std::ios::trunc);
+  if(!myFile.is_open())
+    return false;
+
+  std::array<uInt8, HEADER_SIZE> header{'S', 'T', 'L', 'T', 'R', 'A', 'C', 'E'};
+  putShort(&header[8], VERSION);
+  putShort(&header[10], RECORD_SIZE);
+  putInt(&header[16], uInt32(cycles));
+  putInt(&header[20], uInt32(cycles >> 32));
+  myFile.write(reinterpret_cast<const char*>(header.data()), header.size());
+
+  myFilename = filename;
+  myRecords = 0;
+  myBlock.resize(BLOCK_RECORDS * RECORD_SIZE);
+  myBlockSize = 0;
+  myStopping = myWriteError = false;
+  myWriter = std::thread(&TraceRecorder::threadMain, this);
+  myRecording = true;
+
+  return true;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool TraceRecorder::stop()
+{
+  if(!myRecording)
+    return true;
+
+  flushBlock();
+  {
+    std::lock_guard<std::mutex> lock(myMutex);
+    myStopping = true;
+  }
+  myCondition.notify_one();
+  myWriter.join();
+
+  myFile.close();
+  myRecording = false;
+  myBlock.clear();
+  mySpareBlocks.clear();
+
+  return !myWriteError && !myFile.fail();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void TraceRecorder::flushBlock()
+{
+  if(myBlockSize == 0)
+    return;
+
+  vector<uInt8> next;
+  myBlock.resize(myBlockSize);
+  {
+    std::lock_guard<std::mutex> lock(myMutex);
+    myQueue.push_back(std::move(myBlock));
+    if(!mySpareBlocks.empty())
+    {
+      next = std::move(mySpareBlocks.back());
+      mySpareBlocks.pop_back();
+    }
+  }
+  myCondition.notify_one();
+
+  next.resize(BLOCK_RECORDS * RECORD_SIZE);
+  myBlock = std::move(next);
+  myBlockSize = 0;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void TraceRecorder::threadMain()
+{
+  vector<vector<uInt8>> blocks;
+
+  for(;;)
+  {
+    bool stopping = false;
+    {
+      std::unique_lock<std::mutex> lock(myMutex);
+
+      myCondition.wait(lock, [this]() { return myStopping || !myQueue.empty(); });
+      blocks.swap(myQueue);
+      stopping = myStopping;
+    }
+
+    for(auto& block: blocks)
+      if(!myFile.write(reinterpret_cast<const char*>(block.data()), block.size()))
+        myWriteError = true;
+
+    {
+      std::lock_guard<std::mutex> lock(myMutex);
+      for(auto& block: blocks)
+        mySpareBlocks.push_back(std::move(block));
+    }
+    blocks.clear();
+
+    if(stopping)
+      break;
+  }
+}
@@ -0,0 +1,163 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2020 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+#ifndef TRACE_RECORDER_HXX
+#define TRACE_RECORDER_HXX
+
+#include <condition_variable>
+#include <fstream>
+#include <mutex>
+#include <thread>
+
+#include "bspf.hxx"
+
+/**
+  Records every instruction executed by the 6502 into a compact binary
+  file, which can be decoded and compared by 'src/tools/tracediff.cxx'.
+
+  The file starts with a header of HEADER_SIZE bytes:
+
+    0   "STLTRACE" (magic)
+    8   format version (uInt16)
+    10  record size (uInt16)
+    12  reserved (uInt32)
+    16  system cycle of the first record (uInt64)
+
+  followed by one record of RECORD_SIZE bytes per instruction:
+
+    0   low 32 bits of the system cycle at which the instruction started
+    4   PC (uInt16)
+    6   opcode
+    7   A, X, Y, SP and P before the instruction was executed
+    12  bank of the PC
+    13  data of the last bus access of the instruction
+    14  address of the last bus access of the instruction (uInt16)
+
+  All values are stored in little-endian byte order.  Records are collected
+  in blocks, which are written to disk by a separate thread, so that
+  recording doesn't noticeably slow down emulation.
+*/
+class TraceRecorder
+{
+  public:
+    static constexpr uInt16 VERSION = 1;
+    static constexpr size_t HEADER_SIZE = 24;
+    static constexpr size_t RECORD_SIZE = 16;
+
+  public:
+    TraceRecorder() = default;
+    ~TraceRecorder();
+
+    /**
+      Start recording into the given file, replacing its contents.
+
+      @param filename  The file to record into
+      @param cycles    The current system cycle
+
+      @return  True if the file could be opened, false otherwise
+    */
+    bool start(const string& filename, uInt64 cycles);
+
+    /**
+      Stop recording, and wait until all records are written.
+
+      @return  True if all records were written successfully, false otherwise
+    */
+    bool stop();
+
+    bool isRecording() const { return myRecording; }
+    const string& filename() const { return myFilename; }
+    uInt64 records() const { return myRecords; }
+
+    /**
+      Called by the CPU before an instruction is executed.
+    */
+    void begin(uInt64 cycles, uInt16 pc, uInt8 a, uInt8 x, uInt8 y,
+               uInt8 sp, uInt8 ps, uInt8 bank)
+    {
+      uInt8* r = myBlock.data() + myBlockSize;
+
+      putInt(r, uInt32(cycles));
+      putShort(r + 4, pc);
+      r[7] = a;  r[8] = x;  r[9] = y;  r[10] = sp;  r[11] = ps;
+      r[12] = bank;
+    }
+
+    /**
+      Called by the CPU after an instruction was executed successfully.
+    */
+    void end(uInt8 opcode, uInt16 address, uInt8 data)
+    {
+      uInt8* r = myBlock.data() + myBlockSize;
+
+      r[6] = opcode;
+      r[13] = data;
+      putShort(r + 14, address);
+
+      ++myRecords;
+      if((myBlockSize += RECORD_SIZE) == myBlock.size())
+        flushBlock();
+    }
+
+  private:
+    // Hand the current block over to the writer thread
+    void flushBlock();
+
+    // Write the blocks queued by the emulation thread
+    void threadMain();
+
+    static void putShort(uInt8* p, uInt16 value) {
+      p[0] = uInt8(value);
+      p[1] = uInt8(value >> 8);
+    }
+    static void putInt(uInt8* p, uInt32 value) {
+      putShort(p, uInt16(value));
+      putShort(p + 2, uInt16(value >> 16));
+    }
+
+  private:
+    // Number of records collected before they are handed to the writer
+    static constexpr size_t BLOCK_RECORDS = 16384;
+
+    string myFilename;
+    std::ofstream myFile;
+    bool myRecording{false};
+    uInt64 myRecords{0};
+
+    // The block currently filled by the emulation
+    vector<uInt8> myBlock;
+    size_t myBlockSize{0};
+
+    // Blocks waiting to be written, and written blocks ready for reuse
+    vector<vector<uInt8>> myQueue;
+    vector<vector<uInt8>> mySpareBlocks;
+    bool myStopping{false};
+    bool myWriteError{false};
+
+    std::thread myWriter;
+    std::mutex myMutex;
+    std::condition_variable myCondition;
+
+  private:
+    // Following constructors and assignment operators not supported
+    TraceRecorder(const TraceRecorder&) = delete;
+    TraceRecorder(TraceRecorder&&) = delete;
+    TraceRecorder& operator=(const TraceRecorder&) = delete;
+    TraceRecorder& operator=(TraceRecorder&&) = delete;
+};
+
+#endif
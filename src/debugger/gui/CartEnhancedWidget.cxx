@@ -94,7 +94,7 @@ string CartridgeEnhancedWidget::romDescription()
 {
   ostringstream info;
   size_t size;
-  const ByteBuffer& image = myCart.getImage(size);
+  const RomImage& image = myCart.getImage(size);
 
   if(myCart.romBankCount() > 1)
   {
@@ -58,13 +58,15 @@ bool Cartridge::saveROM(const FilesystemNode& out) const
   try
   {
     size_t size = 0;
-    const ByteBuffer& image = getImage(size);
+    const RomImage& image = getImage(size);
     if(size == 0)
     {
       cerr << "save not supported" << endl;
       return false;
     }
-    out.write(image, size);
+    ByteBuffer buffer = make_unique<uInt8[]>(size);
+    std::copy_n(image.get(), size, buffer.get());
+    out.write(buffer, size);
   }
   catch(...)
   {
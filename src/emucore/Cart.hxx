@@ -25,11 +25,13 @@ class CartDebugWidget;
 class CartRamWidget;
 class GuiObject;
 class Settings;
+class Thumbulator;
 
 #include <functional>
 
 #include "bspf.hxx"
 #include "Device.hxx"
+#include "RomImage.hxx"
 #ifdef DEBUGGER_SUPPORT
   namespace GUI {
     class Font;
@@ -249,7 +251,7 @@ class Cartridge : public Device
       @param size  Set to the size of the internal ROM image data
       @return  A reference to the internal ROM image data
     */
-    virtual const ByteBuffer& getImage(size_t& size) const = 0;
+    virtual const RomImage& getImage(size_t& size) const = 0;
 
     /**
       Get a descriptor for the cart name.
@@ -296,6 +298,11 @@ class Cartridge : public Device
     {
       return nullptr;
     }
+
+    /**
+      Get the ARM emulator of the cart, if it has one.
+    */
+    virtual Thumbulator* thumbulator() { return nullptr; }
   #endif
 
   protected:
@@ -19,7 +19,7 @@
 #include "Cart0840.hxx"
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-Cartridge0840::Cartridge0840(const ByteBuffer& image, size_t size,
+Cartridge0840::Cartridge0840(const RomImage& image, size_t size,
                              const string& md5, const Settings& settings,
                              size_t bsSize)
   : CartridgeEnhanced(image, size, md5, settings, bsSize)
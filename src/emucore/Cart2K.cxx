@@ -19,7 +19,7 @@
 #include "Cart2K.hxx"
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-Cartridge2K::Cartridge2K(const ByteBuffer& image, size_t size,
+Cartridge2K::Cartridge2K(const RomImage& image, size_t size,
                          const string& md5, const Settings& settings,
                          size_t bsSize)
   : CartridgeEnhanced(image, size, md5, settings, bsSize)
@@ -44,7 +44,7 @@ Cartridge2K::Cartridge2K(const ByteBuffer& image, size_t size,
   {
     // Manually 'mirror' the ROM image into the buffer
     for(size_t i = 0; i < System::PAGE_SIZE; i += mySize)
-      std::copy_n(image.get(), mySize, myImage.get() + i);
+      std::copy_n(image.get(), mySize, myImage.modify() + i);
     mySize = System::PAGE_SIZE;
     myBankShift = System::PAGE_SHIFT;
   }
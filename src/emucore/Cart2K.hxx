@@ -49,7 +49,7 @@ class Cartridge2K : public CartridgeEnhanced
       @param settings  A reference to the various settings (read-only)
       @param bsSize    The size specified by the bankswitching scheme
     */
-    Cartridge2K(const ByteBuffer& image, size_t size, const string& md5,
+    Cartridge2K(const RomImage& image, size_t size, const string& md5,
                 const Settings& settings, size_t bsSize = 2_KB);
     ~Cartridge2K() override = default;
 
@@ -20,7 +20,7 @@
 #include "Cart3E.hxx"
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-Cartridge3E::Cartridge3E(const ByteBuffer& image, size_t size,
+Cartridge3E::Cartridge3E(const RomImage& image, size_t size,
                          const string& md5, const Settings& settings,
                          size_t bsSize)
   : CartridgeEnhanced(image, size, md5, settings,
@@ -20,7 +20,7 @@
 #include "Cart3EPlus.hxx"
 
 //  - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-Cartridge3EPlus::Cartridge3EPlus(const ByteBuffer& image, size_t size,
+Cartridge3EPlus::Cartridge3EPlus(const RomImage& image, size_t size,
                                  const string& md5, const Settings& settings,
                                  size_t bsSize)
   : Cartridge3E(image, size, md5, settings,
@@ -18,7 +18,7 @@
 #include "Cart3EX.hxx"
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-Cartridge3EX::Cartridge3EX(const ByteBuffer& image, size_t size,
+Cartridge3EX::Cartridge3EX(const RomImage& image, size_t size,
                            const string& md5, const Settings& settings)
   : Cartridge3E(image, size, md5, settings)
 {
@@ -20,7 +20,7 @@
 #include "Cart3F.hxx"
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-Cartridge3F::Cartridge3F(const ByteBuffer& image, size_t size,
+Cartridge3F::Cartridge3F(const RomImage& image, size_t size,
                          const string& md5, const Settings& settings,
                          size_t bsSize)
   : CartridgeEnhanced(image, size, md5, settings,
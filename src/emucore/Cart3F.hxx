@@ -53,7 +53,7 @@ class Cartridge3F : public CartridgeEnhanced
       @param bsSize    The size specified by the bankswitching scheme
                        (where 0 means variable-sized ROM)
     */
-    Cartridge3F(const ByteBuffer& image, size_t size, const string& md5,
+    Cartridge3F(const RomImage& image, size_t size, const string& md5,
                 const Settings& settings, size_t bsSize = 0);
     ~Cartridge3F() override = default;
 
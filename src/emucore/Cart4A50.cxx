@@ -21,10 +21,10 @@
 #include "Cart4A50.hxx"
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-Cartridge4A50::Cartridge4A50(const ByteBuffer& image, size_t size,
+Cartridge4A50::Cartridge4A50(const RomImage& image, size_t size,
                              const string& md5, const Settings& settings)
   : Cartridge(settings, md5),
-    myImage(make_unique<uInt8[]>(128_KB)),
+    myImage(128_KB),
     mySize(size)
 {
   // Copy the ROM image into my buffer
@@ -33,7 +33,7 @@ Cartridge4A50::Cartridge4A50(const ByteBuffer& image, size_t size,
   else if(size < 128_KB)  size = 64_KB;
   else                    size = 128_KB;
   for(uInt32 slice = 0; slice < 128_KB / size; ++slice)
-    std::copy_n(image.get(), size, myImage.get() + (slice*size));
+    std::copy_n(image.get(), size, myImage.modify() + (slice*size));
 
   // We use System::PageAccess.romAccessBase, but don't allow its use
   // through a pointer, since the address space of 4A50 carts can change
@@ -324,7 +324,7 @@ bool Cartridge4A50::patch(uInt16 address, uInt8 value)
   if((address & 0x1800) == 0x1000)           // 2K region from 0x1000 - 0x17ff
   {
     if(myIsRomLow)
-      myImage[(address & 0x7ff) + mySliceLow] = value;
+      myImage.modify()[(address & 0x7ff) + mySliceLow] = value;
     else
       myRAM[(address & 0x7ff) + mySliceLow] = value;
   }
@@ -332,26 +332,26 @@ bool Cartridge4A50::patch(uInt16 address, uInt8 value)
           ((address & 0x1fff) <= 0x1dff))
   {
     if(myIsRomMiddle)
-      myImage[(address & 0x7ff) + mySliceMiddle + 0x10000] = value;
+      myImage.modify()[(address & 0x7ff) + mySliceMiddle + 0x10000] = value;
     else
       myRAM[(address & 0x7ff) + mySliceMiddle] = value;
   }
   else if((address & 0x1f00) == 0x1e00)      // 256B region from 0x1e00 - 0x1eff
   {
     if(myIsRomHigh)
-      myImage[(address & 0xff) + mySliceHigh + 0x10000] = value;
+      myImage.modify()[(address & 0xff) + mySliceHigh + 0x10000] = value;
     else
       myRAM[(address & 0xff) + mySliceHigh] = value;
   }
   else if((address & 0x1f00) == 0x1f00)      // 256B region from 0x1f00 - 0x1fff
   {
-    myImage[(address & 0xff) + 0x1ff00] = value;
+    myImage.modify()[(address & 0xff) + 0x1ff00] = value;
   }
   return myBankChanged = true;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-const ByteBuffer& Cartridge4A50::getImage(size_t& size) const
+const RomImage& Cartridge4A50::getImage(size_t& size) const
 {
   size = mySize;
   return myImage;
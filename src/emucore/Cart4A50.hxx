@@ -65,7 +65,7 @@ class Cartridge4A50 : public Cartridge
       @param md5       The md5sum of the ROM image
       @param settings  A reference to the various settings (read-only)
     */
-    Cartridge4A50(const ByteBuffer& image, size_t size, const string& md5,
+    Cartridge4A50(const RomImage& image, size_t size, const string& md5,
                   const Settings& settings);
     ~Cartridge4A50() override = default;
 
@@ -98,7 +98,7 @@ class Cartridge4A50 : public Cartridge
       @param size  Set to the size of the internal ROM image data
       @return  A reference to the internal ROM image data
     */
-    const ByteBuffer& getImage(size_t& size) const override;
+    const RomImage& getImage(size_t& size) const override;
 
     /**
       Save the current state of this cart to the given Serializer.
@@ -220,7 +220,7 @@ class Cartridge4A50 : public Cartridge
 
   private:
     // The 128K ROM image of the cartridge
-    ByteBuffer myImage;
+    RomImage myImage;
 
     // The 32K of RAM on the cartridge
     std::array<uInt8, 32_KB> myRAM;
@@ -19,7 +19,7 @@
 #include "Cart4K.hxx"
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-Cartridge4K::Cartridge4K(const ByteBuffer& image, size_t size,
+Cartridge4K::Cartridge4K(const RomImage& image, size_t size,
                          const string& md5, const Settings& settings,
                          size_t bsSize)
   : CartridgeEnhanced(image, size, md5, settings, bsSize)
@@ -19,7 +19,7 @@
 #include "Cart4KSC.hxx"
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-Cartridge4KSC::Cartridge4KSC(const ByteBuffer& image, size_t size,
+Cartridge4KSC::Cartridge4KSC(const RomImage& image, size_t size,
                              const string& md5, const Settings& settings,
                              size_t bsSize)
   : Cartridge4K(image, size, md5, settings, bsSize)
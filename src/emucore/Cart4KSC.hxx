@@ -47,7 +47,7 @@ class Cartridge4KSC : public Cartridge4K
       @param settings  A reference to the various settings (read-only)
       @param bsSize    The size specified by the bankswitching scheme
     */
-    Cartridge4KSC(const ByteBuffer& image, size_t size, const string& md5,
+    Cartridge4KSC(const RomImage& image, size_t size, const string& md5,
                   const Settings& settings, size_t bsSize = 4_KB);
     ~Cartridge4KSC() override = default;
 
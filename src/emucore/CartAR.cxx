@@ -21,20 +21,20 @@
 #include "CartAR.hxx"
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-CartridgeAR::CartridgeAR(const ByteBuffer& image, size_t size,
+CartridgeAR::CartridgeAR(const RomImage& image, size_t size,
                          const string& md5, const Settings& settings)
   : Cartridge(settings, md5),
     mySize(std::max<size_t>(size, 8448))
 {
   // Create a load image buffer and copy the given image
-  myLoadImages = make_unique<uInt8[]>(mySize);
+  myLoadImages = RomImage(mySize);
   myNumberOfLoadImages = uInt8(mySize / 8448);
-  std::copy_n(image.get(), size, myLoadImages.get());
+  std::copy_n(image.get(), size, myLoadImages.modify());
 
   // Add header if image doesn't include it
   if(size < 8448)
     std::copy_n(ourDefaultHeader.data(), ourDefaultHeader.size(),
-                myLoadImages.get()+myImage.size());
+                myLoadImages.modify()+myImage.size());
 
   // We use System::PageAccess.romAccessBase, but don't allow its use
   // through a pointer, since the AR scheme doesn't support bankswitching
@@ -304,20 +304,22 @@ void CartridgeAR::initializeROM()
   // contents placed in the ourDummyROMCode array), the offsets will
   // almost definitely change
 
+  // Initialize ROM with illegal 6502 opcode that causes a real 6502 to jam
+  std::fill_n(myImage.begin() + (3<<11), 2_KB, 0x02);
+
+  // Copy the "dummy" Supercharger BIOS code into the ROM area
+  // Note that the per-instance patches below are applied to the copy only,
+  // since the template is shared by all cartridges in the process
+  std::copy_n(ourDummyROMCode.data(), ourDummyROMCode.size(), myImage.data() + (3<<11));
+
   // The scrom.asm code checks a value at offset 109 as follows:
   //   0xFF -> do a complete jump over the SC BIOS progress bars code
   //   0x00 -> show SC BIOS progress bars as normal
-  ourDummyROMCode[109] = mySettings.getBool("fastscbios") ? 0xFF : 0x00;
+  myImage[(3<<11) + 109] = mySettings.getBool("fastscbios") ? 0xFF : 0x00;
 
   // The accumulator should contain a random value after exiting the
   // SC BIOS code - a value placed in offset 281 will be stored in A
-  ourDummyROMCode[281] = mySystem->randGenerator().next();
-
-  // Initialize ROM with illegal 6502 opcode that causes a real 6502 to jam
-  std::fill_n(myImage.begin() + (3<<11), 2_KB, 0x02);
-
-  // Copy the "dummy" Supercharger BIOS code into the ROM area
-  std::copy_n(ourDummyROMCode.data(), ourDummyROMCode.size(), myImage.data() + (3<<11));
+  myImage[(3<<11) + 281] = mySystem->randGenerator().next();
 
   // Finally set 6502 vectors to point to initial load code at 0xF80A of BIOS
   myImage[(3<<11) + 2044] = 0x0A;
@@ -327,7 +329,7 @@ void CartridgeAR::initializeROM()
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-uInt8 CartridgeAR::checksum(uInt8* s, uInt16 length)
+uInt8 CartridgeAR::checksum(const uInt8* s, uInt16 length)
 {
   uInt8 sum = 0;
 
@@ -361,7 +363,7 @@ void CartridgeAR::loadIntoRAM(uInt8 load)
       {
         uInt32 bank = myHeader[16 + j] & 0x03;
         uInt32 page = (myHeader[16 + j] >> 2) & 0x07;
-        uInt8* src = myLoadImages.get() + (image * 8448) + (j * 256);
+        const uInt8* src = myLoadImages.get() + (image * 8448) + (j * 256);
         uInt8 sum = checksum(src, 256) + myHeader[16 + j] + myHeader[64 + j];
 
         if(!invalidPageChecksumSeen && (sum != 0x55))
@@ -420,7 +422,7 @@ bool CartridgeAR::patch(uInt16 address, uInt8 value)
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-const ByteBuffer& CartridgeAR::getImage(size_t& size) const
+const RomImage& CartridgeAR::getImage(size_t& size) const
 {
   size = mySize;
   return myLoadImages;
@@ -487,7 +489,7 @@ bool CartridgeAR::load(Serializer& in)
 
     // All of the 8448 byte loads associated with the game
     // Note that the size of this array is myNumberOfLoadImages * 8448
-    in.getByteArray(myLoadImages.get(), myNumberOfLoadImages * 8448);
+    in.getByteArray(myLoadImages.modify(), myNumberOfLoadImages * 8448);
 
     // Indicates how many 8448 loads there are
     myNumberOfLoadImages = in.getByte();
@@ -517,7 +519,7 @@ bool CartridgeAR::load(Serializer& in)
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-std::array<uInt8, 294> CartridgeAR::ourDummyROMCode = {
+const std::array<uInt8, 294> CartridgeAR::ourDummyROMCode = {
   0xa5, 0xfa, 0x85, 0x80, 0x4c, 0x18, 0xf8, 0xff,
   0xff, 0xff, 0x78, 0xd8, 0xa0, 0x00, 0xa2, 0x00,
   0x94, 0x00, 0xe8, 0xd0, 0xfb, 0x4c, 0x50, 0xf8,
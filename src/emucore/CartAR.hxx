@@ -52,7 +52,7 @@ class CartridgeAR : public Cartridge
       @param md5       The md5sum of the ROM image
       @param settings  A reference to the various settings (read-only)
     */
-    CartridgeAR(const ByteBuffer& image, size_t size, const string& md5,
+    CartridgeAR(const RomImage& image, size_t size, const string& md5,
                 const Settings& settings);
     ~CartridgeAR() override = default;
 
@@ -107,7 +107,7 @@ class CartridgeAR : public Cartridge
       @param size  Set to the size of the internal ROM image data
       @return  A reference to the internal ROM image data
     */
-    const ByteBuffer& getImage(size_t& size) const override;
+    const RomImage& getImage(size_t& size) const override;
 
     /**
       Save the current state of this cart to the given Serializer.
@@ -182,7 +182,7 @@ class CartridgeAR : public Cartridge
     bool bankConfiguration(uInt8 configuration);
 
     // Compute the sum of the array of bytes
-    uInt8 checksum(uInt8* s, uInt16 length);
+    uInt8 checksum(const uInt8* s, uInt16 length);
 
     // Load the specified load into SC RAM
     void loadIntoRAM(uInt8 load);
@@ -204,7 +204,7 @@ class CartridgeAR : public Cartridge
     size_t mySize{0};
 
     // All of the 8448 byte loads associated with the game
-    ByteBuffer myLoadImages;
+    RomImage myLoadImages;
 
     // Indicates how many 8448 loads there are
     uInt8 myNumberOfLoadImages{0};
@@ -228,7 +228,7 @@ class CartridgeAR : public Cartridge
     uInt16 myCurrentBank{0};
 
     // Fake SC-BIOS code to simulate the Supercharger load bars
-    static std::array<uInt8, 294> ourDummyROMCode;
+    static const std::array<uInt8, 294> ourDummyROMCode;
 
     // Default 256-byte header to use if one isn't included in the ROM
     // This data comes from z26
@@ -19,7 +19,7 @@
 #include "CartBF.hxx"
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-CartridgeBF::CartridgeBF(const ByteBuffer& image, size_t size,
+CartridgeBF::CartridgeBF(const RomImage& image, size_t size,
                          const string& md5, const Settings& settings,
                          size_t bsSize)
   : CartridgeEnhanced(image, size, md5, settings, bsSize)
@@ -47,7 +47,7 @@ class CartridgeBF : public CartridgeEnhanced
       @param settings  A reference to the various settings (read-only)
       @param bsSize    The size specified by the bankswitching scheme
     */
-    CartridgeBF(const ByteBuffer& image, size_t size, const string& md5,
+    CartridgeBF(const RomImage& image, size_t size, const string& md5,
                 const Settings& settings, size_t bsSize = 256_KB);
     ~CartridgeBF() override = default;
 
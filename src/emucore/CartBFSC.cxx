@@ -19,7 +19,7 @@
 #include "CartBFSC.hxx"
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-CartridgeBFSC::CartridgeBFSC(const ByteBuffer& image, size_t size,
+CartridgeBFSC::CartridgeBFSC(const RomImage& image, size_t size,
                              const string& md5, const Settings& settings,
                              size_t bsSize)
   : CartridgeBF(image, size, md5, settings, bsSize)
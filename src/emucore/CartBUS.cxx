@@ -41,20 +41,20 @@
 #define DIGITAL_AUDIO_ON ((myMode & 0xF0) == 0)
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-CartridgeBUS::CartridgeBUS(const ByteBuffer& image, size_t size,
+CartridgeBUS::CartridgeBUS(const RomImage& image, size_t size,
                            const string& md5, const Settings& settings)
   : Cartridge(settings, md5),
-    myImage(make_unique<uInt8[]>(32_KB))
+    myImage(32_KB)
 {
   // Copy the ROM image into my buffer
-  std::copy_n(image.get(), std::min(32_KB, size), myImage.get());
+  std::copy_n(image.get(), std::min(32_KB, size), myImage.modify());
 
   // Even though the ROM is 32K, only 28K is accessible to the 6507
   createRomAccessArrays(28_KB);
 
   // Pointer to the program ROM (28K @ 0 byte offset)
   // which starts after the 2K BUS Driver and 2K C Code
-  myProgramImage = myImage.get() + 4_KB;
+  myProgramImage = myImage.modify() + 4_KB;
 
   // Pointer to BUS driver in RAM
   myDriverImage = myRAM.data();
@@ -65,13 +65,14 @@ CartridgeBUS::CartridgeBUS(const ByteBuffer& image, size_t size,
   // Create Thumbulator ARM emulator
   bool devSettings = settings.getBool("dev.settings");
   myThumbEmulator = make_unique<Thumbulator>(
-    reinterpret_cast<uInt16*>(myImage.get()),
+    reinterpret_cast<uInt16*>(myImage.modify()),
     reinterpret_cast<uInt16*>(myRAM.data()),
     static_cast<uInt32>(32_KB),
     0x00000800,
     0x00000808,
     0x40001FDC,
     devSettings ? settings.getBool("dev.thumb.trapfatal") : false, 
+    settings.getBool("thumbcache"),
     Thumbulator::ConfigureFor::BUS, 
     this);
 
@@ -170,6 +171,8 @@ inline void CartridgeBUS::callFunction(uInt8 value)
         Int32 cycles = Int32(mySystem->cycles() - myARMCycles);
         myARMCycles = mySystem->cycles();
 
+        SubsystemTimer::Scope timing(mySystem->subsystemTimer(),
+            SubsystemTimer::Subsystem::arm);
         myThumbEmulator->run(cycles);
       }
       catch(const runtime_error& e) {
@@ -483,7 +486,7 @@ bool CartridgeBUS::patch(uInt16 address, uInt8 value)
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-const ByteBuffer& CartridgeBUS::getImage(size_t& size) const
+const RomImage& CartridgeBUS::getImage(size_t& size) const
 {
   size = 32_KB;
   return myImage;
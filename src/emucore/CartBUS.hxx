@@ -54,7 +54,7 @@ class CartridgeBUS : public Cartridge
       @param md5       The md5sum of the ROM image
       @param settings  A reference to the various settings (read-only)
     */
-    CartridgeBUS(const ByteBuffer& image, size_t size, const string& md5,
+    CartridgeBUS(const RomImage& image, size_t size, const string& md5,
                  const Settings& settings);
     ~CartridgeBUS() override = default;
 
@@ -118,7 +118,7 @@ class CartridgeBUS : public Cartridge
       @param size  Set to the size of the internal ROM image data
       @return  A reference to the internal ROM image data
     */
-    const ByteBuffer& getImage(size_t& size) const override;
+    const RomImage& getImage(size_t& size) const override;
 
     /**
       Save the current state of this cart to the given Serializer.
@@ -175,6 +175,11 @@ class CartridgeBUS : public Cartridge
     {
       return new CartridgeBUSWidget(boss, lfont, nfont, x, y, w, h, *this);
     }
+
+    /**
+      Get the ARM emulator of the cart.
+    */
+    Thumbulator* thumbulator() override { return myThumbEmulator.get(); }
   #endif
 
   public:
@@ -235,7 +240,7 @@ class CartridgeBUS : public Cartridge
 
   private:
     // The 32K ROM image of the cartridge
-    ByteBuffer myImage;
+    RomImage myImage;
 
     // Pointer to the 28K program ROM image of the cartridge
     uInt8* myProgramImage{nullptr};
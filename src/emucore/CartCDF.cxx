@@ -63,14 +63,13 @@ namespace {
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-CartridgeCDF::CartridgeCDF(const ByteBuffer& image, size_t size,
+CartridgeCDF::CartridgeCDF(const RomImage& image, size_t size,
                            const string& md5, const Settings& settings)
   : Cartridge(settings, md5),
-    myImage(make_unique<uInt8[]>(512_KB))
+    myImage(512_KB)
 {
-  // Copy the ROM image into my buffer
-  std::fill_n(myImage.get(), 512_KB, 0);
-  std::copy_n(image.get(), std::min(512_KB, size), myImage.get());
+  // Copy the ROM image into my buffer (which is initialized with all 0's)
+  std::copy_n(image.get(), std::min(512_KB, size), myImage.modify());
 
   // Detect cart version
   setupVersion();
@@ -80,7 +79,7 @@ CartridgeCDF::CartridgeCDF(const ByteBuffer& image, size_t size,
 
   // Pointer to the program ROM
   // which starts after the 2K driver (and 2K C Code for CDF)
-  myProgramImage = myImage.get() + (isCDFJplus() ? 2_KB : 4_KB);
+  myProgramImage = myImage.modify() + (isCDFJplus() ? 2_KB : 4_KB);
 
   // Pointer to CDF driver in RAM
   myDriverImage = myRAM.data();
@@ -103,11 +102,12 @@ CartridgeCDF::CartridgeCDF(const ByteBuffer& image, size_t size,
   // Create Thumbulator ARM emulator
   bool devSettings = settings.getBool("dev.settings");
   myThumbEmulator = make_unique<Thumbulator>(
-    reinterpret_cast<uInt16*>(myImage.get()),
+    reinterpret_cast<uInt16*>(myImage.modify()),
     reinterpret_cast<uInt16*>(myRAM.data()),
     static_cast<uInt32>(512_KB),
     cBase, cStart, cStack,
     devSettings ? settings.getBool("dev.thumb.trapfatal") : false, 
+    settings.getBool("thumbcache"),
     thumulatorConfiguration(myCDFSubtype), 
     this);
 
@@ -198,6 +198,8 @@ inline void CartridgeCDF::callFunction(uInt8 value)
         Int32 cycles = Int32(mySystem->cycles() - myARMCycles);
         myARMCycles = mySystem->cycles();
 
+        SubsystemTimer::Scope timing(mySystem->subsystemTimer(),
+            SubsystemTimer::Subsystem::arm);
         myThumbEmulator->run(cycles);
       }
       catch(const runtime_error& e) {
@@ -483,7 +485,7 @@ bool CartridgeCDF::patch(uInt16 address, uInt8 value)
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-const ByteBuffer& CartridgeCDF::getImage(size_t& size) const
+const RomImage& CartridgeCDF::getImage(size_t& size) const
 {
   size = 512_KB;
   return myImage;
@@ -76,7 +76,7 @@ class CartridgeCDF : public Cartridge
       @param md5       The md5sum of the ROM image
       @param settings  A reference to the various settings (read-only)
     */
-    CartridgeCDF(const ByteBuffer& image, size_t size, const string& md5,
+    CartridgeCDF(const RomImage& image, size_t size, const string& md5,
                  const Settings& settings);
     ~CartridgeCDF() override = default;
 
@@ -140,7 +140,7 @@ class CartridgeCDF : public Cartridge
       @param size  Set to the size of the internal ROM image data
       @return  A reference to the internal ROM image data
     */
-    const ByteBuffer& getImage(size_t& size) const override;
+    const RomImage& getImage(size_t& size) const override;
 
     /**
       Save the current state of this cart to the given Serializer.
@@ -208,6 +208,11 @@ class CartridgeCDF : public Cartridge
                                  const GUI::Font& nfont, int x, int y, int w, int h) override;
     CartDebugWidget* infoWidget(GuiObject* boss, const GUI::Font& lfont,
                                 const GUI::Font& nfont, int x, int y, int w, int h) override;
+
+    /**
+      Get the ARM emulator of the cart.
+    */
+    Thumbulator* thumbulator() override { return myThumbEmulator.get(); }
 #endif
 
   public:
@@ -266,7 +271,7 @@ class CartridgeCDF : public Cartridge
 
   private:
     // The ROM image of the cartridge
-    ByteBuffer myImage;
+    RomImage myImage;
 
     // Pointer to the program ROM image of the cartridge
     uInt8* myProgramImage{nullptr};
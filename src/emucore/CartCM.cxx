@@ -21,13 +21,13 @@
 #include "CartCM.hxx"
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-CartridgeCM::CartridgeCM(const ByteBuffer& image, size_t size,
+CartridgeCM::CartridgeCM(const RomImage& image, size_t size,
                          const string& md5, const Settings& settings)
   : Cartridge(settings, md5),
-    myImage(make_unique<uInt8[]>(16_KB))
+    myImage(16_KB)
 {
   // Copy the ROM image into my buffer
-  std::copy_n(image.get(), std::min(16_KB, size), myImage.get());
+  std::copy_n(image.get(), std::min(16_KB, size), myImage.modify());
   createRomAccessArrays(16_KB);
 }
 
@@ -179,13 +179,13 @@ bool CartridgeCM::patch(uInt16 address, uInt8 value)
   if((mySWCHA & 0x30) == 0x20)
     myRAM[address & 0x7FF] = value;
   else
-    myImage[myBankOffset + address] = value;
+    myImage.modify()[myBankOffset + address] = value;
 
   return myBankChanged = true;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-const ByteBuffer& CartridgeCM::getImage(size_t& size) const
+const RomImage& CartridgeCM::getImage(size_t& size) const
 {
   size = 16_KB;
   return myImage;
@@ -120,7 +120,7 @@ class CartridgeCM : public Cartridge
       @param md5       The md5sum of the ROM image
       @param settings  A reference to the various settings (read-only)
     */
-    CartridgeCM(const ByteBuffer& image, size_t size, const string& md5,
+    CartridgeCM(const RomImage& image, size_t size, const string& md5,
                 const Settings& settings);
     ~CartridgeCM() override = default;
 
@@ -175,7 +175,7 @@ class CartridgeCM : public Cartridge
       @param size  Set to the size of the internal ROM image data
       @return  A reference to the internal ROM image data
     */
-    const ByteBuffer& getImage(size_t& size) const override;
+    const RomImage& getImage(size_t& size) const override;
 
     /**
       Save the current state of this cart to the given Serializer.
@@ -246,7 +246,7 @@ class CartridgeCM : public Cartridge
     shared_ptr<CompuMate> myCompuMate;
 
     // The 16K ROM image of the cartridge
-    ByteBuffer myImage;
+    RomImage myImage;
 
     // The 2K of RAM
     std::array<uInt8, 2_KB> myRAM;
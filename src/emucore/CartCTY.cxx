@@ -22,13 +22,13 @@
 #include "CartCTY.hxx"
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-CartridgeCTY::CartridgeCTY(const ByteBuffer& image, size_t size,
+CartridgeCTY::CartridgeCTY(const RomImage& image, size_t size,
                            const string& md5, const Settings& settings)
   : Cartridge(settings, md5),
-    myImage(make_unique<uInt8[]>(32_KB))
+    myImage(32_KB)
 {
   // Copy the ROM image into my buffer
-  std::copy_n(image.get(), std::min(32_KB, size), myImage.get());
+  std::copy_n(image.get(), std::min(32_KB, size), myImage.modify());
   createRomAccessArrays(32_KB);
 
   // Default to no tune data in case user is utilizing an old ROM
@@ -274,13 +274,13 @@ bool CartridgeCTY::patch(uInt16 address, uInt8 value)
     myRAM[address & 0x003F] = value;
   }
   else
-    myImage[myBankOffset + address] = value;
+    myImage.modify()[myBankOffset + address] = value;
 
   return myBankChanged = true;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-const ByteBuffer& CartridgeCTY::getImage(size_t& size) const
+const RomImage& CartridgeCTY::getImage(size_t& size) const
 {
   size = 32_KB;
   return myImage;
@@ -118,7 +118,7 @@ class CartridgeCTY : public Cartridge
       @param md5       The md5sum of the ROM image
       @param settings  A reference to the settings object
     */
-    CartridgeCTY(const ByteBuffer& image, size_t size, const string& md5,
+    CartridgeCTY(const RomImage& image, size_t size, const string& md5,
                  const Settings& settings);
     ~CartridgeCTY() override = default;
 
@@ -173,7 +173,7 @@ class CartridgeCTY : public Cartridge
       @param size  Set to the size of the internal ROM image data
       @return  A reference to the internal ROM image data
     */
-    const ByteBuffer& getImage(size_t& size) const override;
+    const RomImage& getImage(size_t& size) const override;
 
     /**
       Save the current state of this cart to the given Serializer.
@@ -263,7 +263,7 @@ class CartridgeCTY : public Cartridge
 
   private:
     // The 32K ROM image of the cartridge
-    ByteBuffer myImage;
+    RomImage myImage;
 
     // The 28K ROM image of the music
     std::array<uInt8, 28_KB> myTuneData;
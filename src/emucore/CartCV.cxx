@@ -19,7 +19,7 @@
 #include "CartCV.hxx"
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-CartridgeCV::CartridgeCV(const ByteBuffer& image, size_t size,
+CartridgeCV::CartridgeCV(const RomImage& image, size_t size,
                          const string& md5, const Settings& settings,
                          size_t bsSize)
   : CartridgeEnhanced(image, size, md5, settings, bsSize)
@@ -34,7 +34,7 @@ CartridgeCV::CartridgeCV(const ByteBuffer& image, size_t size,
     // Useful for MagiCard program listings
 
     // Copy the ROM image into my buffer
-    std::copy_n(image.get() + 2_KB, 2_KB, myImage.get());
+    std::copy_n(image.get() + 2_KB, 2_KB, myImage.modify());
 
     myInitialRAM = make_unique<uInt8[]>(1_KB);
     // Copy the RAM image into a buffer for use in reset()
@@ -70,7 +70,7 @@
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 unique_ptr<Cartridge> CartCreator::create(const FilesystemNode& file,
-    const ByteBuffer& image, size_t size, string& md5,
+    const RomImage& image, size_t size, string& md5,
     const string& propertiesType, Settings& settings)
 {
   unique_ptr<Cartridge> cartridge;
@@ -214,7 +214,7 @@ unique_ptr<Cartridge> CartCreator::create(const FilesystemNode& file,
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 unique_ptr<Cartridge>
-CartCreator::createFromMultiCart(const ByteBuffer& image, size_t& size,
+CartCreator::createFromMultiCart(const RomImage& image, size_t& size,
     uInt32 numroms, string& md5, Bankswitch::Type type, string& id, Settings& settings)
 {
   // Get a piece of the larger image
@@ -242,12 +242,12 @@ CartCreator::createFromMultiCart(const ByteBuffer& image, size_t& size,
   else if(size == 8_KB)  type = Bankswitch::Type::_F8;
   else  /* default */    type = Bankswitch::Type::_4K;
 
-  return createFromImage(slice, size, type, md5, settings);
+  return createFromImage(RomImage(std::move(slice), size), size, type, md5, settings);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 unique_ptr<Cartridge>
-CartCreator::createFromImage(const ByteBuffer& image, size_t size, Bankswitch::Type type,
+CartCreator::createFromImage(const RomImage& image, size_t size, Bankswitch::Type type,
                              const string& md5, Settings& settings)
 {
   // We should know the cart's type by now so let's create it
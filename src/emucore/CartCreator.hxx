@@ -24,6 +24,7 @@ class Settings;
 
 #include "Bankswitch.hxx"
 #include "bspf.hxx"
+#include "RomImage.hxx"
 
 /**
   Create a cartridge based on the given information.  Internally, it will
@@ -46,7 +47,7 @@ class CartCreator
       @return   Pointer to the new cartridge object allocated on the heap
     */
     static unique_ptr<Cartridge> create(const FilesystemNode& file,
-                 const ByteBuffer& image, size_t size, string& md5,
+                 const RomImage& image, size_t size, string& md5,
                  const string& dtype, Settings& settings);
 
   private:
@@ -65,7 +66,7 @@ class CartCreator
       @return  Pointer to the new cartridge object allocated on the heap
     */
     static unique_ptr<Cartridge>
-      createFromMultiCart(const ByteBuffer& image, size_t& size,
+      createFromMultiCart(const RomImage& image, size_t& size,
         uInt32 numroms, string& md5, Bankswitch::Type type, string& id,
         Settings& settings);
 
@@ -81,7 +82,7 @@ class CartCreator
       @return  Pointer to the new cartridge object allocated on the heap
     */
     static unique_ptr<Cartridge>
-      createFromImage(const ByteBuffer& image, size_t size, Bankswitch::Type type,
+      createFromImage(const RomImage& image, size_t size, Bankswitch::Type type,
                       const string& md5, Settings& settings);
 
   private:
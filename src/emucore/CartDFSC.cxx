@@ -19,7 +19,7 @@
 #include "CartDFSC.hxx"
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-CartridgeDFSC::CartridgeDFSC(const ByteBuffer& image, size_t size,
+CartridgeDFSC::CartridgeDFSC(const RomImage& image, size_t size,
                              const string& md5, const Settings& settings,
                              size_t bsSize)
   : CartridgeDF(image, size, md5, settings, bsSize)
@@ -47,7 +47,7 @@ class CartridgeDFSC : public CartridgeDF
       @param settings  A reference to the various settings (read-only)
       @param bsSize    The size specified by the bankswitching scheme
     */
-    CartridgeDFSC(const ByteBuffer& image, size_t size, const string& md5,
+    CartridgeDFSC(const RomImage& image, size_t size, const string& md5,
                   const Settings& settings, size_t bsSize = 128_KB);
     ~CartridgeDFSC() override = default;
 
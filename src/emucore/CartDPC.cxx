@@ -21,7 +21,7 @@
 #include "CartDPC.hxx"
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-CartridgeDPC::CartridgeDPC(const ByteBuffer& image, size_t size,
+CartridgeDPC::CartridgeDPC(const RomImage& image, size_t size,
                            const string& md5, const Settings& settings,
                            size_t bsSize)
   : CartridgeF8(image, size, md5, settings, bsSize)
@@ -41,13 +41,15 @@ void CartridgeDPC::reset()
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void CartridgeDPC::install(System& system)
 {
+  // Pointer to the display ROM (2K @ 8K offset); it can be changed in the
+  // debugger, so the cart needs a private copy of the image (which must be
+  // made before the pages are set up)
+  myDisplayImage = myImage.modify() + 8_KB;
+
   CartridgeEnhanced::install(system);
 
   myRomOffset = 0x80;
 
-  // Pointer to the display ROM (2K @ 8K offset)
-  myDisplayImage = myImage.get() + 8_KB;
-
   createRomAccessArrays(8_KB);
 
   // Set the page accessing method for the DPC reading & writing pages
@@ -26,21 +26,19 @@
 #include "exception/FatalEmulationError.hxx"
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-CartridgeDPCPlus::CartridgeDPCPlus(const ByteBuffer& image, size_t size,
+CartridgeDPCPlus::CartridgeDPCPlus(const RomImage& image, size_t size,
                                    const string& md5, const Settings& settings)
   : Cartridge(settings, md5),
-    myImage(make_unique<uInt8[]>(32_KB)),
+    myImage(32_KB),
     mySize(std::min(size, 32_KB))
 {
   // Image is always 32K, but in the case of ROM < 32K, the image is
-  // copied to the end of the buffer
-  if(mySize < 32_KB)
-    std::fill_n(myImage.get(), mySize, 0);
-  std::copy_n(image.get(), size, myImage.get() + (32_KB - mySize));
+  // copied to the end of the buffer (which is initialized with all 0's)
+  std::copy_n(image.get(), size, myImage.modify() + (32_KB - mySize));
   createRomAccessArrays(24_KB);
 
   // Pointer to the program ROM (24K @ 3K offset; ignore first 3K)
-  myProgramImage = myImage.get() + 3_KB;
+  myProgramImage = myImage.modify() + 3_KB;
 
   // Pointer to the display RAM
   myDisplayImage = myDPCRAM.data() + 3_KB;
@@ -51,13 +49,14 @@ CartridgeDPCPlus::CartridgeDPCPlus(const ByteBuffer& image, size_t size,
   // Create Thumbulator ARM emulator
   bool devSettings = settings.getBool("dev.settings");
   myThumbEmulator = make_unique<Thumbulator>
-      (reinterpret_cast<uInt16*>(myImage.get()),
+      (reinterpret_cast<uInt16*>(myImage.modify()),
        reinterpret_cast<uInt16*>(myDPCRAM.data()),
        static_cast<uInt32>(32_KB),
       0x00000C00,
       0x00000C08,
       0x40001FDC,
        devSettings ? settings.getBool("dev.thumb.trapfatal") : false,
+       settings.getBool("thumbcache"),
        Thumbulator::ConfigureFor::DPCplus,
        this);
 
@@ -72,7 +71,7 @@ CartridgeDPCPlus::CartridgeDPCPlus(const ByteBuffer& image, size_t size,
   //
   // The default mask for DFxFRACLOW implements the Jitter behavior. This
   // changes the mask to implement the Stable behavior.
-  myDriverMD5 = MD5::hash(image, 3_KB);
+  myDriverMD5 = MD5::hash(image.get(), 3_KB);
   if(myDriverMD5 == "5f80b5a5adbe483addc3f6e6f1b472f8" ||
      myDriverMD5 == "8dd73b44fd11c488326ce507cbeb19d1" )
     myFractionalLowMask = 0x0F0000;
@@ -203,6 +202,8 @@ inline void CartridgeDPCPlus::callFunction(uInt8 value)
         Int32 cycles = Int32(mySystem->cycles() - myARMCycles);
         myARMCycles = mySystem->cycles();
 
+        SubsystemTimer::Scope timing(mySystem->subsystemTimer(),
+            SubsystemTimer::Subsystem::arm);
         myThumbEmulator->run(cycles);
       }
       catch(const runtime_error& e) {
@@ -644,7 +645,7 @@ bool CartridgeDPCPlus::patch(uInt16 address, uInt8 value)
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-const ByteBuffer& CartridgeDPCPlus::getImage(size_t& size) const
+const RomImage& CartridgeDPCPlus::getImage(size_t& size) const
 {
   size = mySize;
   return myImage;
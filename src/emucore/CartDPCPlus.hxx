@@ -56,7 +56,7 @@ class CartridgeDPCPlus : public Cartridge
       @param md5       The md5sum of the ROM image
       @param settings  A reference to the various settings (read-only)
     */
-    CartridgeDPCPlus(const ByteBuffer& image, size_t size, const string& md5,
+    CartridgeDPCPlus(const RomImage& image, size_t size, const string& md5,
                      const Settings& settings);
     ~CartridgeDPCPlus() override = default;
 
@@ -120,7 +120,7 @@ class CartridgeDPCPlus : public Cartridge
       @param size  Set to the size of the internal ROM image data
       @return  A reference to the internal ROM image data
     */
-    const ByteBuffer& getImage(size_t& size) const override;
+    const RomImage& getImage(size_t& size) const override;
 
     /**
       Save the current state of this cart to the given Serializer.
@@ -170,6 +170,11 @@ class CartridgeDPCPlus : public Cartridge
     {
       return new CartridgeDPCPlusWidget(boss, lfont, nfont, x, y, w, h, *this);
     }
+
+    /**
+      Get the ARM emulator of the cart.
+    */
+    Thumbulator* thumbulator() override { return myThumbEmulator.get(); }
   #endif
 
   public:
@@ -225,7 +230,7 @@ class CartridgeDPCPlus : public Cartridge
 
   private:
     // The ROM image and size
-    ByteBuffer myImage;
+    RomImage myImage;
     size_t mySize{0};
 
     // Pointer to the 24K program ROM image of the cartridge
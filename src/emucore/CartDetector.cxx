@@ -15,14 +15,100 @@
 // this file, and for a DISCLAIMER OF ALL WARRANTIES.
 //============================================================================
 
+#include <bitset>
+
 #include "bspf.hxx"
 #include "Logger.hxx"
 
 #include "CartDetector.hxx"
 
+namespace {
+  // The bytes of each CartDetector::Signature (in the same order), and the
+  // size of the area at the start of the image which may contain it
+  // (0 = the whole image)
+  struct SignatureBytes {
+    std::array<uInt8, 8> bytes;
+    uInt32 size;
+    size_t area;
+  };
+
+  constexpr std::array<SignatureBytes, 63> ourSignatures = {{
+    { { 0x8D, 0xF9, 0x1F }, 3, 0 },                    // STA $1FF9
+    { { 0x8D, 0xF9, 0xFF }, 3, 0 },                    // STA $FFF9
+    // ARM code contains the following 'loader' patterns in the first 1K
+    { { 0xA0, 0xC1, 0x1F, 0xE0 }, 4, 1_KB },
+    { { 0x00, 0x80, 0x02, 0xE0 }, 4, 1_KB },
+    { { 0xAD, 0x00, 0x08 }, 3, 0 },                    // LDA $0800
+    { { 0xAD, 0x40, 0x08 }, 3, 0 },                    // LDA $0840
+    { { 0x2C, 0x00, 0x08 }, 3, 0 },                    // BIT $0800
+    { { 0x0C, 0x00, 0x08, 0x4C }, 4, 0 },              // NOP $0800; JMP ...
+    { { 0x0C, 0xFF, 0x0F, 0x4C }, 4, 0 },              // NOP $0FFF; JMP ...
+    { { 0x85, 0x3E }, 2, 0 },                          // STA $3E
+    { { 0x85, 0x3F }, 2, 0 },                          // STA $3F
+    { { '3', 'E', 'X' }, 3, 0 },
+    { { 'T', 'J', '3', 'E' }, 4, 0 },
+    { { 'B', 'U', 'S' }, 3, 0 },
+    { { 'C', 'D', 'F' }, 3, 0 },
+    { { 'P', 'L', 'U', 'S', 'C', 'D', 'F', 'J' }, 8, 0 },
+    { { 'L', 'E', 'N', 'I', 'N' }, 5, 0 },
+    { { 'D', 'P', 'C', '+' }, 4, 0 },
+    { { 'M', 'D', 'M', 'C' }, 4, 8_KB },
+    { { 0x9D, 0xFF, 0xF3 }, 3, 0 },                    // STA $F3FF.X
+    { { 0x99, 0x00, 0xF4 }, 3, 0 },                    // STA $F400.Y
+    { { 0x8D, 0xE0, 0x1F }, 3, 0 },                    // STA $1FE0
+    { { 0x8D, 0xE0, 0x5F }, 3, 0 },                    // STA $5FE0
+    { { 0x8D, 0xE9, 0xFF }, 3, 0 },                    // STA $FFE9
+    { { 0x0C, 0xE0, 0x1F }, 3, 0 },                    // NOP $1FE0
+    { { 0xAD, 0xE0, 0x1F }, 3, 0 },                    // LDA $1FE0
+    { { 0xAD, 0xE9, 0xFF }, 3, 0 },                    // LDA $FFE9
+    { { 0xAD, 0xED, 0xFF }, 3, 0 },                    // LDA $FFED
+    { { 0xAD, 0xF3, 0xBF }, 3, 0 },                    // LDA $BFF3
+    { { 0xAD, 0xE2, 0xFF }, 3, 0 },                    // LDA $FFE2
+    { { 0xAD, 0xE5, 0xFF }, 3, 0 },                    // LDA $FFE5
+    { { 0xAD, 0xE5, 0x1F }, 3, 0 },                    // LDA $1FE5
+    { { 0xAD, 0xE7, 0x1F }, 3, 0 },                    // LDA $1FE7
+    { { 0x0C, 0xE7, 0x1F }, 3, 0 },                    // NOP $1FE7
+    { { 0x8D, 0xE7, 0xFF }, 3, 0 },                    // STA $FFE7
+    { { 0x8D, 0xE7, 0x1F }, 3, 0 },                    // STA $1FE7
+    { { 0xAD, 0xE4, 0xFF }, 3, 0 },                    // LDA $FFE4
+    { { 0xAD, 0xE6, 0xFF }, 3, 0 },                    // LDA $FFE6
+    { { 0x0C, 0xE0, 0xFF }, 3, 0 },                    // NOP $FFE0
+    { { 0xAD, 0xE0, 0xFF }, 3, 0 },                    // LDA $FFE0
+    // STA $1FF8, LSR, LSR, STA... Power Play Arcade Menus, 3-D Ghost Attack
+    { { 0x8D, 0xF8, 0x1F, 0x4A, 0x4A, 0x8D }, 6, 0 },
+    // STA $FFF8, STA $FFFC        Surf's Up (4K)
+    { { 0x8D, 0xF8, 0xFF, 0x8D, 0xFC, 0xFF }, 6, 0 },
+    // STY $FFF9, LDA $FFFC        3-D Havoc
+    { { 0x8C, 0xF9, 0xFF, 0xAD, 0xFC, 0xFF }, 6, 0 },
+    { { 0x20, 0x00, 0xD0, 0xC6, 0xC5 }, 5, 0 },        // JSR $D000; DEC $C5
+    { { 0x20, 0xC3, 0xF8, 0xA5, 0x82 }, 5, 0 },        // JSR $F8C3; LDA $82
+    { { 0xD0, 0xFB, 0x20, 0x73, 0xFE }, 5, 0 },        // BNE $FB; JSR $FE73
+    { { 0x20, 0x00, 0xF0, 0x84, 0xD6 }, 5, 0 },        // JSR $F000; $84, $D6
+    { { 0xBD, 0x00, 0x08 }, 3, 0 },                    // LDA $0800,x
+    { { 0x91, 0x82, 0x6C, 0xFC, 0xFF }, 5, 0 },        // STA ($82),Y; JMP ($FFFC)
+    { { 0x8D, 0x40, 0x02 }, 3, 0 },                    // STA $240 (Funky Fish, Pleiades)
+    { { 0xAD, 0x40, 0x02 }, 3, 0 },                    // LDA $240 (???)
+    { { 0xBD, 0x1F, 0x02 }, 3, 0 },                    // LDA $21F,X (Gingerbread Man)
+    { { 0x2C, 0xC0, 0x02 }, 3, 0 },                    // BIT $2C0 (Time Pilot)
+    { { 0x8D, 0xC0, 0x02 }, 3, 0 },                    // STA $2C0 (Fathom, Vanguard)
+    { { 0xAD, 0xC0, 0x02 }, 3, 0 },                    // LDA $2C0 (Mickey)
+    { { 0x2C, 0xC0, 0x0F }, 3, 0 },                    // BIT $FC0 (H.E.R.O., Kung-Fu Master)
+    { { 0xA5, 0x39, 0x4C }, 3, 0 },                    // LDA $39, JMP
+    { { 0xAD, 0x0D, 0x08 }, 3, 0 },                    // LDA $080D
+    { { 0xAD, 0x1D, 0x08 }, 3, 0 },                    // LDA $081D
+    { { 0xAD, 0x2D, 0x08 }, 3, 0 },                    // LDA $082D
+    { { 0x0C, 0x0D, 0x08 }, 3, 0 },                    // NOP $080D
+    { { 0x0C, 0x1D, 0x08 }, 3, 0 },                    // NOP $081D
+    { { 0x0C, 0x2D, 0x08 }, 3, 0 }                     // NOP $082D
+  }};
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-Bankswitch::Type CartDetector::autodetectType(const ByteBuffer& image, size_t size)
+Bankswitch::Type CartDetector::autodetectType(const RomImage& image, size_t size)
 {
+  // Count all signatures in one go; the checks below only look up the counts
+  const SignatureHits hits(image, size);
+
   // Guess type based on size
   Bankswitch::Type type = Bankswitch::Type::_AUTO;
 
@@ -37,15 +123,15 @@ Bankswitch::Type CartDetector::autodetectType(const ByteBuffer& image, size_t si
   else if((size == 2_KB) ||
           (size == 4_KB && std::memcmp(image.get(), image.get() + 2_KB, 2_KB) == 0))
   {
-    type = isProbablyCV(image, size) ? Bankswitch::Type::_CV : Bankswitch::Type::_2K;
+    type = isProbablyCV(hits) ? Bankswitch::Type::_CV : Bankswitch::Type::_2K;
   }
   else if(size == 4_KB)
   {
-    if(isProbablyCV(image, size))
+    if(isProbablyCV(hits))
       type = Bankswitch::Type::_CV;
     else if(isProbably4KSC(image, size))
       type = Bankswitch::Type::_4KSC;
-    else if (isProbablyFC(image, size))
+    else if (isProbablyFC(hits))
       type = Bankswitch::Type::_FC;
     else
       type = Bankswitch::Type::_4K;
@@ -53,36 +139,32 @@ Bankswitch::Type CartDetector::autodetectType(const ByteBuffer& image, size_t si
   else if(size == 8_KB)
   {
     // First check for *potential* F8
-    uInt8 signature[2][3] = {
-      { 0x8D, 0xF9, 0x1F },  // STA $1FF9
-      { 0x8D, 0xF9, 0xFF }   // STA $FFF9
-    };
-    bool f8 = searchForBytes(image, size, signature[0], 3, 2) ||
-              searchForBytes(image, size, signature[1], 3, 2);
+    bool f8 = hits.found(Signature::STA_1FF9, 2) ||
+              hits.found(Signature::STA_FFF9, 2);
 
     if(isProbablySC(image, size))
       type = Bankswitch::Type::_F8SC;
     else if(std::memcmp(image.get(), image.get() + 4_KB, 4_KB) == 0)
       type = Bankswitch::Type::_4K;
-    else if(isProbablyE0(image, size))
+    else if(isProbablyE0(hits))
       type = Bankswitch::Type::_E0;
-    else if(isProbably3EX(image, size))
+    else if(isProbably3EX(hits))
       type = Bankswitch::Type::_3EX;
-    else if(isProbably3E(image, size))
+    else if(isProbably3E(hits))
       type = Bankswitch::Type::_3E;
-    else if(isProbably3F(image, size))
+    else if(isProbably3F(hits))
       type = Bankswitch::Type::_3F;
-    else if(isProbablyUA(image, size))
+    else if(isProbablyUA(hits))
       type = Bankswitch::Type::_UA;
-    else if(isProbablyFE(image, size) && !f8)
+    else if(isProbablyFE(hits) && !f8)
       type = Bankswitch::Type::_FE;
-    else if(isProbably0840(image, size))
+    else if(isProbably0840(hits))
       type = Bankswitch::Type::_0840;
-    else if(isProbablyE78K(image, size))
+    else if(isProbablyE78K(hits))
       type = Bankswitch::Type::_E78K;
-    else if (isProbablyWD(image,size))
+    else if (isProbablyWD(hits))
       type = Bankswitch::Type::_WD;
-    else if (isProbablyFC(image, size))
+    else if (isProbablyFC(hits))
       type = Bankswitch::Type::_FC;
     else
       type = Bankswitch::Type::_F8;
@@ -103,16 +185,16 @@ Bankswitch::Type CartDetector::autodetectType(const ByteBuffer& image, size_t si
   {
     if(isProbablySC(image, size))
       type = Bankswitch::Type::_F6SC;
-    else if(isProbablyE7(image, size))
+    else if(isProbablyE7(hits))
       type = Bankswitch::Type::_E7;
-    else if (isProbablyFC(image, size))
+    else if (isProbablyFC(hits))
       type = Bankswitch::Type::_FC;
-    else if(isProbably3EX(image, size))
+    else if(isProbably3EX(hits))
       type = Bankswitch::Type::_3EX;
-    else if(isProbably3E(image, size))
+    else if(isProbably3E(hits))
       type = Bankswitch::Type::_3E;
   /* no known 16K 3F ROMS
-    else if(isProbably3F(image, size))
+    else if(isProbably3F(hits))
       type = Bankswitch::Type::_3F;
   */
     else
@@ -124,121 +206,121 @@ Bankswitch::Type CartDetector::autodetectType(const ByteBuffer& image, size_t si
   }
   else if(size == 29_KB)
   {
-    if(isProbablyARM(image, size))
+    if(isProbablyARM(hits))
       type = Bankswitch::Type::_FA2;
-    else /*if(isProbablyDPCplus(image, size))*/
+    else /*if(isProbablyDPCplus(hits))*/
       type = Bankswitch::Type::_DPCP;
   }
   else if(size == 32_KB)
   {
-    if (isProbablyCTY(image, size))
+    if (isProbablyCTY(hits))
       type = Bankswitch::Type::_CTY;
     else if(isProbablySC(image, size))
       type = Bankswitch::Type::_F4SC;
-    else if(isProbably3EX(image, size))
+    else if(isProbably3EX(hits))
       type = Bankswitch::Type::_3EX;
-    else if(isProbably3E(image, size))
+    else if(isProbably3E(hits))
       type = Bankswitch::Type::_3E;
-    else if(isProbably3F(image, size))
+    else if(isProbably3F(hits))
       type = Bankswitch::Type::_3F;
-    else if (isProbablyBUS(image, size))
+    else if (isProbablyBUS(hits))
       type = Bankswitch::Type::_BUS;
-    else if (isProbablyCDF(image, size))
+    else if (isProbablyCDF(hits))
       type = Bankswitch::Type::_CDF;
-    else if(isProbablyDPCplus(image, size))
+    else if(isProbablyDPCplus(hits))
       type = Bankswitch::Type::_DPCP;
     else if(isProbablyFA2(image, size))
       type = Bankswitch::Type::_FA2;
-    else if (isProbablyFC(image, size))
+    else if (isProbablyFC(hits))
       type = Bankswitch::Type::_FC;
     else
       type = Bankswitch::Type::_F4;
   }
   else if(size == 60_KB)
   {
-    if(isProbablyCTY(image, size))
+    if(isProbablyCTY(hits))
       type = Bankswitch::Type::_CTY;
     else
       type = Bankswitch::Type::_F4;
   }
   else if(size == 64_KB)
   {
-    if(isProbably3EX(image, size))
+    if(isProbably3EX(hits))
       type = Bankswitch::Type::_3EX;
-    else if(isProbably3E(image, size))
+    else if(isProbably3E(hits))
       type = Bankswitch::Type::_3E;
-    else if(isProbably3F(image, size))
+    else if(isProbably3F(hits))
       type = Bankswitch::Type::_3F;
-    else if (isProbablyCDF(image, size))
+    else if (isProbablyCDF(hits))
       type = Bankswitch::Type::_CDF;
     else if(isProbably4A50(image, size))
       type = Bankswitch::Type::_4A50;
-    else if(isProbablyEF(image, size, type))
+    else if(isProbablyEF(image, size, hits, type))
       ; // type has been set directly in the function
-    else if(isProbablyX07(image, size))
+    else if(isProbablyX07(hits))
       type = Bankswitch::Type::_X07;
     else
       type = Bankswitch::Type::_F0;
   }
   else if(size == 128_KB)
   {
-    if(isProbably3EX(image, size))
+    if(isProbably3EX(hits))
       type = Bankswitch::Type::_3EX;
-    else if(isProbably3E(image, size))
+    else if(isProbably3E(hits))
       type = Bankswitch::Type::_3E;
     else if(isProbablyDF(image, size, type))
       ; // type has been set directly in the function
-    else if(isProbably3F(image, size))
+    else if(isProbably3F(hits))
       type = Bankswitch::Type::_3F;
-    else if (isProbablyCDF(image, size))
+    else if (isProbablyCDF(hits))
       type = Bankswitch::Type::_CDF;
     else if(isProbably4A50(image, size))
       type = Bankswitch::Type::_4A50;
-    else /*if(isProbablySB(image, size))*/
+    else /*if(isProbablySB(hits))*/
       type = Bankswitch::Type::_SB;
   }
   else if(size == 256_KB)
   {
-    if(isProbably3EX(image, size))
+    if(isProbably3EX(hits))
       type = Bankswitch::Type::_3EX;
-    else if(isProbably3E(image, size))
+    else if(isProbably3E(hits))
       type = Bankswitch::Type::_3E;
     else if(isProbablyBF(image, size, type))
       ; // type has been set directly in the function
-    else if(isProbably3F(image, size))
+    else if(isProbably3F(hits))
       type = Bankswitch::Type::_3F;
-    else if (isProbablyCDF(image, size))
+    else if (isProbablyCDF(hits))
       type = Bankswitch::Type::_CDF;
-    else /*if(isProbablySB(image, size))*/
+    else /*if(isProbablySB(hits))*/
       type = Bankswitch::Type::_SB;
   }
   else if(size == 512_KB)
   {
-    if(isProbablyTVBoy(image, size))
+    if(isProbablyTVBoy(hits))
       type = Bankswitch::Type::_TVBOY;
-    else if(isProbably3EX(image, size))
+    else if(isProbably3EX(hits))
       type = Bankswitch::Type::_3EX;
-    else if(isProbably3E(image, size))
+    else if(isProbably3E(hits))
       type = Bankswitch::Type::_3E;
-    else if(isProbably3F(image, size))
+    else if(isProbably3F(hits))
       type = Bankswitch::Type::_3F;
-    else if (isProbablyCDF(image, size))
+    else if (isProbablyCDF(hits))
       type = Bankswitch::Type::_CDF;
   }
   else  // what else can we do?
   {
-    if(isProbably3EX(image, size))
+    if(isProbably3EX(hits))
       type = Bankswitch::Type::_3EX;
-    else if(isProbably3E(image, size))
+    else if(isProbably3E(hits))
       type = Bankswitch::Type::_3E;
-    else if(isProbably3F(image, size))
+    else if(isProbably3F(hits))
       type = Bankswitch::Type::_3F;
   }
 
   // Variable sized ROM formats are independent of image size and come last
-  if(isProbably3EPlus(image, size))
+  if(isProbably3EPlus(hits))
     type = Bankswitch::Type::_3EP;
-  else if(isProbablyMDM(image, size))
+  else if(isProbablyMDM(hits))
     type = Bankswitch::Type::_MDM;
 
   // If we get here and autodetection failed, then we force '4K'
@@ -280,7 +362,65 @@ bool CartDetector::searchForBytes(const uInt8* image, size_t imagesize,
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool CartDetector::isProbablySC(const ByteBuffer& image, size_t size)
+CartDetector::SignatureHits::SignatureHits(const RomImage& image, size_t size)
+{
+  static_assert(ourSignatures.size() == static_cast<uInt8>(Signature::NumSignatures),
+                "Signature bytes don't match the signatures");
+
+  // The signatures starting with each byte value, so that every position of
+  // the image is only compared against a few of them, and a filter for the
+  // first two bytes which rejects most positions right away
+  static const auto candidates = [] {
+    std::array<std::vector<uInt8>, 256> list;
+    for(uInt8 i = 0; i < ourSignatures.size(); ++i)
+      list[ourSignatures[i].bytes[0]].push_back(i);
+    return list;
+  }();
+  static const auto prefixes = [] {
+    std::bitset<256 * 256> set;
+    for(const auto& sig: ourSignatures)
+      set.set(sig.bytes[0] | (sig.bytes[1] << 8));
+    return set;
+  }();
+
+  // For each signature, where the next hit may start and where hits end;
+  // like searchForBytes(), hits don't overlap and never end at the last
+  // byte of the searched area
+  std::array<size_t, ourSignatures.size()> next, end;
+  size_t scanEnd = 0;
+  for(uInt8 i = 0; i < ourSignatures.size(); ++i)
+  {
+    const SignatureBytes& sig = ourSignatures[i];
+    const size_t area = sig.area ? std::min(sig.area, size) : size;
+
+    next[i] = 0;
+    end[i] = area > sig.size ? area - sig.size : 0;
+    scanEnd = std::max(scanEnd, end[i]);
+  }
+  myCounts.fill(0);
+
+  const uInt8* data = image.get();
+  for(size_t pos = 0; pos < scanEnd; ++pos)
+  {
+    if(!prefixes[data[pos] | (data[pos + 1] << 8)])
+      continue;
+
+    for(uInt8 i: candidates[data[pos]])
+    {
+      const SignatureBytes& sig = ourSignatures[i];
+
+      if(pos >= next[i] && pos < end[i] &&
+         std::memcmp(data + pos, sig.bytes.data(), sig.size) == 0)
+      {
+        ++myCounts[i];
+        next[i] = pos + sig.size + 1;
+      }
+    }
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool CartDetector::isProbablySC(const RomImage& image, size_t size)
 {
   // We assume a Superchip cart repeats the first 128 bytes for the second
   // 128 bytes in the RAM area, which is the first 256 bytes of each 4K bank
@@ -297,89 +437,63 @@ bool CartDetector::isProbablySC(const ByteBuffer& image, size_t size)
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool CartDetector::isProbablyARM(const ByteBuffer& image, size_t size)
+bool CartDetector::isProbablyARM(const SignatureHits& hits)
 {
   // ARM code contains the following 'loader' patterns in the first 1K
   // Thanks to Thomas Jentzsch of AtariAge for this advice
-  uInt8 signature[2][4] = {
-    { 0xA0, 0xC1, 0x1F, 0xE0 },
-    { 0x00, 0x80, 0x02, 0xE0 }
-  };
-  if(searchForBytes(image, std::min<size_t>(size, 1_KB), signature[0], 4))
-    return true;
-  else
-    return searchForBytes(image, std::min<size_t>(size, 1_KB), signature[1], 4);
+  return hits.found(Signature::ARM_LOADER_1) ||
+         hits.found(Signature::ARM_LOADER_2);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool CartDetector::isProbably0840(const ByteBuffer& image, size_t size)
+bool CartDetector::isProbably0840(const SignatureHits& hits)
 {
   // 0840 cart bankswitching is triggered by accessing addresses 0x0800
   // or 0x0840 at least twice
-  uInt8 signature1[3][3] = {
-    { 0xAD, 0x00, 0x08 },  // LDA $0800
-    { 0xAD, 0x40, 0x08 },  // LDA $0840
-    { 0x2C, 0x00, 0x08 }   // BIT $0800
-  };
-  for(uInt32 i = 0; i < 3; ++i)
-    if(searchForBytes(image, size, signature1[i], 3, 2))
-      return true;
-
-  uInt8 signature2[2][4] = {
-    { 0x0C, 0x00, 0x08, 0x4C },  // NOP $0800; JMP ...
-    { 0x0C, 0xFF, 0x0F, 0x4C }   // NOP $0FFF; JMP ...
-  };
-  for(uInt32 i = 0; i < 2; ++i)
-    if(searchForBytes(image, size, signature2[i], 4, 2))
-      return true;
-
-  return false;
+  return hits.found(Signature::LDA_0800, 2) ||
+         hits.found(Signature::LDA_0840, 2) ||
+         hits.found(Signature::BIT_0800, 2) ||
+         hits.found(Signature::NOP_0800_JMP, 2) ||
+         hits.found(Signature::NOP_0FFF_JMP, 2);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool CartDetector::isProbably3E(const ByteBuffer& image, size_t size)
+bool CartDetector::isProbably3E(const SignatureHits& hits)
 {
   // 3E cart RAM bankswitching is triggered by storing the bank number
   // in address 3E using 'STA $3E', ROM bankswitching is triggered by
   // storing the bank number in address 3F using 'STA $3F'.
   // We expect the latter will be present at least 2 times, since there
   // are at least two banks
-
-  uInt8 signature1[] = { 0x85, 0x3E };  // STA $3E
-  uInt8 signature2[] = { 0x85, 0x3F };  // STA $3F
-  return searchForBytes(image, size, signature1, 2)
-    && searchForBytes(image, size, signature2, 2, 2);
+  return hits.found(Signature::STA_3E) && hits.found(Signature::STA_3F, 2);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool CartDetector::isProbably3EX(const ByteBuffer& image, size_t size)
+bool CartDetector::isProbably3EX(const SignatureHits& hits)
 {
   // 3EX cart have at least 2 occurrences of the string "3EX"
-  uInt8 _3EX[] = { '3', 'E', 'X'};
-  return searchForBytes(image, size, _3EX, 3, 2);
+  return hits.found(Signature::ID_3EX, 2);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool CartDetector::isProbably3EPlus(const ByteBuffer& image, size_t size)
+bool CartDetector::isProbably3EPlus(const SignatureHits& hits)
 {
   // 3E+ cart is identified key 'TJ3E' in the ROM
-  uInt8 tj3e[] = { 'T', 'J', '3', 'E' };
-  return searchForBytes(image, size, tj3e, 4);
+  return hits.found(Signature::ID_TJ3E);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool CartDetector::isProbably3F(const ByteBuffer& image, size_t size)
+bool CartDetector::isProbably3F(const SignatureHits& hits)
 {
   // 3F cart bankswitching is triggered by storing the bank number
   // in address 3F using 'STA $3F'
   // We expect it will be present at least 2 times, since there are
   // at least two banks
-  uInt8 signature[] = { 0x85, 0x3F };  // STA $3F
-  return searchForBytes(image, size, signature, 2, 2);
+  return hits.found(Signature::STA_3F, 2);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool CartDetector::isProbably4A50(const ByteBuffer& image, size_t size)
+bool CartDetector::isProbably4A50(const RomImage& image, size_t size)
 {
   // 4A50 carts store address $4A50 at the NMI vector, which
   // in this scheme is always in the last page of ROM at
@@ -397,7 +511,7 @@ bool CartDetector::isProbably4A50(const ByteBuffer& image, size_t size)
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool CartDetector::isProbably4KSC(const ByteBuffer& image, size_t size)
+bool CartDetector::isProbably4KSC(const RomImage& image, size_t size)
 {
   // We check if the first 256 bytes are identical *and* if there's
   // an "SC" signature for one of our larger SC types at 1FFA.
@@ -414,7 +528,7 @@ bool CartDetector::isProbably4KSC(const ByteBuffer& image, size_t size)
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool CartDetector::isProbablyBF(const ByteBuffer& image, size_t size,
+bool CartDetector::isProbablyBF(const RomImage& image, size_t size,
                                 Bankswitch::Type& type)
 {
   // BF carts store strings 'BFBF' and 'BFSC' starting at address $FFF8
@@ -436,51 +550,39 @@ bool CartDetector::isProbablyBF(const ByteBuffer& image, size_t size,
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool CartDetector::isProbablyBUS(const ByteBuffer& image, size_t size)
+bool CartDetector::isProbablyBUS(const SignatureHits& hits)
 {
   // BUS ARM code has 2 occurrences of the string BUS
   // Note: all Harmony/Melody custom drivers also contain the value
   // 0x10adab1e (LOADABLE) if needed for future improvement
-  uInt8 bus[] = { 'B', 'U', 'S'};
-  return searchForBytes(image, size, bus, 3, 2);
+  return hits.found(Signature::ID_BUS, 2);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool CartDetector::isProbablyCDF(const ByteBuffer& image, size_t size)
+bool CartDetector::isProbablyCDF(const SignatureHits& hits)
 {
   // CDF ARM code has 3 occurrences of the string CDF
   // Note: all Harmony/Melody custom drivers also contain the value
   // 0x10adab1e (LOADABLE) if needed for future improvement
-  uInt8 cdf[] = { 'C', 'D', 'F' };
-  uInt8 cdfjplus[] = { 'P', 'L', 'U', 'S', 'C', 'D', 'F', 'J' };
-  return (searchForBytes(image, size, cdf, 3, 3) || 
-          searchForBytes(image, size, cdfjplus, 8, 1));
+  return hits.found(Signature::ID_CDF, 3) || hits.found(Signature::ID_PLUSCDFJ);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool CartDetector::isProbablyCTY(const ByteBuffer& image, size_t size)
+bool CartDetector::isProbablyCTY(const SignatureHits& hits)
 {
-  uInt8 lenin[] = { 'L', 'E', 'N', 'I', 'N' };
-  return searchForBytes(image, size, lenin, 5);
+  return hits.found(Signature::ID_LENIN);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool CartDetector::isProbablyCV(const ByteBuffer& image, size_t size)
+bool CartDetector::isProbablyCV(const SignatureHits& hits)
 {
   // CV RAM access occurs at addresses $f3ff and $f400
   // These signatures are attributed to the MESS project
-  uInt8 signature[2][3] = {
-    { 0x9D, 0xFF, 0xF3 },  // STA $F3FF.X
-    { 0x99, 0x00, 0xF4 }   // STA $F400.Y
-  };
-  if(searchForBytes(image, size, signature[0], 3))
-    return true;
-  else
-    return searchForBytes(image, size, signature[1], 3);
+  return hits.found(Signature::STA_F3FF_X) || hits.found(Signature::STA_F400_Y);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool CartDetector::isProbablyDF(const ByteBuffer& image, size_t size,
+bool CartDetector::isProbablyDF(const RomImage& image, size_t size,
                                 Bankswitch::Type& type)
 {
 
@@ -503,17 +605,16 @@ bool CartDetector::isProbablyDF(const ByteBuffer& image, size_t size,
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool CartDetector::isProbablyDPCplus(const ByteBuffer& image, size_t size)
+bool CartDetector::isProbablyDPCplus(const SignatureHits& hits)
 {
   // DPC+ ARM code has 2 occurrences of the string DPC+
   // Note: all Harmony/Melody custom drivers also contain the value
   // 0x10adab1e (LOADABLE) if needed for future improvement
-  uInt8 dpcp[] = { 'D', 'P', 'C', '+' };
-  return searchForBytes(image, size, dpcp, 4, 2);
+  return hits.found(Signature::ID_DPCplus, 2);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool CartDetector::isProbablyE0(const ByteBuffer& image, size_t size)
+bool CartDetector::isProbablyE0(const SignatureHits& hits)
 {
   // E0 cart bankswitching is triggered by accessing addresses
   // $FE0 to $FF9 using absolute non-indexed addressing
@@ -521,25 +622,14 @@ bool CartDetector::isProbablyE0(const ByteBuffer& image, size_t size)
   // search for only certain known signatures
   // Thanks to "stella@casperkitty.com" for this advice
   // These signatures are attributed to the MESS project
-  uInt8 signature[8][3] = {
-    { 0x8D, 0xE0, 0x1F },  // STA $1FE0
-    { 0x8D, 0xE0, 0x5F },  // STA $5FE0
-    { 0x8D, 0xE9, 0xFF },  // STA $FFE9
-    { 0x0C, 0xE0, 0x1F },  // NOP $1FE0
-    { 0xAD, 0xE0, 0x1F },  // LDA $1FE0
-    { 0xAD, 0xE9, 0xFF },  // LDA $FFE9
-    { 0xAD, 0xED, 0xFF },  // LDA $FFED
-    { 0xAD, 0xF3, 0xBF }   // LDA $BFF3
-  };
-  for(uInt32 i = 0; i < 8; ++i)
-    if(searchForBytes(image, size, signature[i], 3))
-      return true;
-
-  return false;
+  return hits.found(Signature::STA_1FE0) || hits.found(Signature::STA_5FE0) ||
+         hits.found(Signature::STA_FFE9) || hits.found(Signature::NOP_1FE0) ||
+         hits.found(Signature::LDA_1FE0) || hits.found(Signature::LDA_FFE9) ||
+         hits.found(Signature::LDA_FFED) || hits.found(Signature::LDA_BFF3);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool CartDetector::isProbablyE7(const ByteBuffer& image, size_t size)
+bool CartDetector::isProbablyE7(const SignatureHits& hits)
 {
   // E7 cart bankswitching is triggered by accessing addresses
   // $FE0 to $FE6 using absolute non-indexed addressing
@@ -547,44 +637,26 @@ bool CartDetector::isProbablyE7(const ByteBuffer& image, size_t size)
   // search for only certain known signatures
   // Thanks to "stella@casperkitty.com" for this advice
   // These signatures are attributed to the MESS project
-  uInt8 signature[7][3] = {
-    { 0xAD, 0xE2, 0xFF },  // LDA $FFE2
-    { 0xAD, 0xE5, 0xFF },  // LDA $FFE5
-    { 0xAD, 0xE5, 0x1F },  // LDA $1FE5
-    { 0xAD, 0xE7, 0x1F },  // LDA $1FE7
-    { 0x0C, 0xE7, 0x1F },  // NOP $1FE7
-    { 0x8D, 0xE7, 0xFF },  // STA $FFE7
-    { 0x8D, 0xE7, 0x1F }   // STA $1FE7
-  };
-  for(uInt32 i = 0; i < 7; ++i)
-    if(searchForBytes(image, size, signature[i], 3))
-      return true;
-
-  return false;
+  return hits.found(Signature::LDA_FFE2) || hits.found(Signature::LDA_FFE5) ||
+         hits.found(Signature::LDA_1FE5) || hits.found(Signature::LDA_1FE7) ||
+         hits.found(Signature::NOP_1FE7) || hits.found(Signature::STA_FFE7) ||
+         hits.found(Signature::STA_1FE7);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool CartDetector::isProbablyE78K(const ByteBuffer& image, size_t size)
+bool CartDetector::isProbablyE78K(const SignatureHits& hits)
 {
   // E78K cart bankswitching is triggered by accessing addresses
   // $FE4 to $FE6 using absolute non-indexed addressing
   // To eliminate false positives (and speed up processing), we
   // search for only certain known signatures
-  uInt8 signature[3][3] = {
-    { 0xAD, 0xE4, 0xFF },  // LDA $FFE4
-    { 0xAD, 0xE5, 0xFF },  // LDA $FFE5
-    { 0xAD, 0xE6, 0xFF },  // LDA $FFE6
-  };
-  for(uInt32 i = 0; i < 3; ++i)
-    if(searchForBytes(image, size, signature[i], 3))
-      return true;
-
-  return false;
+  return hits.found(Signature::LDA_FFE4) || hits.found(Signature::LDA_FFE5) ||
+         hits.found(Signature::LDA_FFE6);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool CartDetector::isProbablyEF(const ByteBuffer& image, size_t size,
-                                Bankswitch::Type& type)
+bool CartDetector::isProbablyEF(const RomImage& image, size_t size,
+                                const SignatureHits& hits, Bankswitch::Type& type)
 {
   // Newer EF carts store strings 'EFEF' and 'EFSC' starting at address $FFF8
   // This signature is attributed to "RevEng" of AtariAge
@@ -604,21 +676,8 @@ bool CartDetector::isProbablyEF(const ByteBuffer& image, size_t size,
   // Otherwise, EF cart bankswitching switches banks by accessing addresses
   // 0xFE0 to 0xFEF, usually with either a NOP or LDA
   // It's likely that the code will switch to bank 0, so that's what is tested
-  bool isEF = false;
-  uInt8 signature[4][3] = {
-    { 0x0C, 0xE0, 0xFF },  // NOP $FFE0
-    { 0xAD, 0xE0, 0xFF },  // LDA $FFE0
-    { 0x0C, 0xE0, 0x1F },  // NOP $1FE0
-    { 0xAD, 0xE0, 0x1F }   // LDA $1FE0
-  };
-  for(uInt32 i = 0; i < 4; ++i)
-  {
-    if(searchForBytes(image, size, signature[i], 3))
-    {
-      isEF = true;
-      break;
-    }
-  }
+  bool isEF = hits.found(Signature::NOP_FFE0) || hits.found(Signature::LDA_FFE0) ||
+              hits.found(Signature::NOP_1FE0) || hits.found(Signature::LDA_1FE0);
 
   // Now that we know that the ROM is EF, we need to check if it's
   // the SC variant
@@ -632,7 +691,7 @@ bool CartDetector::isProbablyEF(const ByteBuffer& image, size_t size,
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool CartDetector::isProbablyFA2(const ByteBuffer& image, size_t)
+bool CartDetector::isProbablyFA2(const RomImage& image, size_t)
 {
   // This currently tests only the 32K version of FA2; the 24 and 28K
   // versions are easy, in that they're the only possibility with those
@@ -647,72 +706,49 @@ bool CartDetector::isProbablyFA2(const ByteBuffer& image, size_t)
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool CartDetector::isProbablyFC(const ByteBuffer& image, size_t size)
+bool CartDetector::isProbablyFC(const SignatureHits& hits)
 {
   // FC bankswitching uses consecutive writes to 3 hotspots
-  uInt8 signature[3][6] = {
-    { 0x8d, 0xf8, 0x1f, 0x4a, 0x4a, 0x8d }, // STA $1FF8, LSR, LSR, STA... Power Play Arcade Menus, 3-D Ghost Attack
-    { 0x8d, 0xf8, 0xff, 0x8d, 0xfc, 0xff }, // STA $FFF8, STA $FFFC        Surf's Up (4K)
-    { 0x8c, 0xf9, 0xff, 0xad, 0xfc, 0xff }  // STY $FFF9, LDA $FFFC        3-D Havoc
-  };
-  for(uInt32 i = 0; i < 3; ++i)
-    if(searchForBytes(image, size, signature[i], 6))
-      return true;
-
-  return false;
+  return hits.found(Signature::STA_1FF8_LSR) ||
+         hits.found(Signature::STA_FFF8_STA) ||
+         hits.found(Signature::STY_FFF9_LDA);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool CartDetector::isProbablyFE(const ByteBuffer& image, size_t size)
+bool CartDetector::isProbablyFE(const SignatureHits& hits)
 {
   // FE bankswitching is very weird, but always seems to include a
   // 'JSR $xxxx'
   // These signatures are attributed to the MESS project
-  uInt8 signature[4][5] = {
-    { 0x20, 0x00, 0xD0, 0xC6, 0xC5 },  // JSR $D000; DEC $C5
-    { 0x20, 0xC3, 0xF8, 0xA5, 0x82 },  // JSR $F8C3; LDA $82
-    { 0xD0, 0xFB, 0x20, 0x73, 0xFE },  // BNE $FB; JSR $FE73
-    { 0x20, 0x00, 0xF0, 0x84, 0xD6 }   // JSR $F000; $84, $D6
-  };
-  for(uInt32 i = 0; i < 4; ++i)
-    if(searchForBytes(image, size, signature[i], 5))
-      return true;
-
-  return false;
+  return hits.found(Signature::JSR_D000_DEC) ||
+         hits.found(Signature::JSR_F8C3_LDA) ||
+         hits.found(Signature::BNE_JSR_FE73) ||
+         hits.found(Signature::JSR_F000_STY);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool CartDetector::isProbablyMDM(const ByteBuffer& image, size_t size)
+bool CartDetector::isProbablyMDM(const SignatureHits& hits)
 {
   // MDM cart is identified key 'MDMC' in the first 8K of ROM
-  uInt8 mdmc[] = { 'M', 'D', 'M', 'C' };
-  return searchForBytes(image, std::min<size_t>(size, 8_KB), mdmc, 4);
+  return hits.found(Signature::ID_MDMC);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool CartDetector::isProbablySB(const ByteBuffer& image, size_t size)
+bool CartDetector::isProbablySB(const SignatureHits& hits)
 {
   // SB cart bankswitching switches banks by accessing address 0x0800
-  uInt8 signature[2][3] = {
-    { 0xBD, 0x00, 0x08 },  // LDA $0800,x
-    { 0xAD, 0x00, 0x08 }   // LDA $0800
-  };
-  if(searchForBytes(image, size, signature[0], 3))
-    return true;
-  else
-    return searchForBytes(image, size, signature[1], 3);
+  return hits.found(Signature::LDA_0800_X) || hits.found(Signature::LDA_0800);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool CartDetector::isProbablyTVBoy(const ByteBuffer& image, size_t size)
+bool CartDetector::isProbablyTVBoy(const SignatureHits& hits)
 {
   // TV Boy cart bankswitching switches banks by accessing addresses 0x1800..$187F
-  uInt8 signature[5] = {0x91, 0x82, 0x6c, 0xfc, 0xff};  // STA ($82),Y; JMP ($FFFC)
-  return searchForBytes(image, size, signature, 5);
+  return hits.found(Signature::STA_82_JMP);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool CartDetector::isProbablyUA(const ByteBuffer& image, size_t size)
+bool CartDetector::isProbablyUA(const SignatureHits& hits)
 {
   // UA cart bankswitching switches to bank 1 by accessing address 0x240
   // using 'STA $240' or 'LDA $240'
@@ -720,47 +756,24 @@ bool CartDetector::isProbablyUA(const ByteBuffer& image, size_t size)
   // using 'BIT $2C0', 'STA $2C0' or 'LDA $2C0'
   // Other Brazilian (Atari Mania) ROM's bankswitching switches to bank 1 by accessing address 0xFC0
   // using 'BIT $FA0', 'BIT $FC0' or 'STA $FA0'
-  uInt8 signature[7][3] = {
-    { 0x8D, 0x40, 0x02 },  // STA $240 (Funky Fish, Pleiades)
-    { 0xAD, 0x40, 0x02 },  // LDA $240 (???)
-    { 0xBD, 0x1F, 0x02 },  // LDA $21F,X (Gingerbread Man)
-    { 0x2C, 0xC0, 0x02 },  // BIT $2C0 (Time Pilot)
-    { 0x8D, 0xC0, 0x02 },  // STA $2C0 (Fathom, Vanguard)
-    { 0xAD, 0xC0, 0x02 },  // LDA $2C0 (Mickey)
-    { 0x2C, 0xC0, 0x0F }   // BIT $FC0 (H.E.R.O., Kung-Fu Master)
-  };
-  for(uInt32 i = 0; i < 7; ++i)
-    if(searchForBytes(image, size, signature[i], 3))
-      return true;
-
-  return false;
+  return hits.found(Signature::STA_240) || hits.found(Signature::LDA_240) ||
+         hits.found(Signature::LDA_21F_X) || hits.found(Signature::BIT_2C0) ||
+         hits.found(Signature::STA_2C0) || hits.found(Signature::LDA_2C0) ||
+         hits.found(Signature::BIT_FC0);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool CartDetector::isProbablyWD(const ByteBuffer& image, size_t size)
+bool CartDetector::isProbablyWD(const SignatureHits& hits)
 {
   // WD cart bankswitching switches banks by accessing address 0x30..0x3f
-  uInt8 signature[1][3] = {
-    { 0xA5, 0x39, 0x4C }  // LDA $39, JMP
-  };
-  return searchForBytes(image, size, signature[0], 3);
+  return hits.found(Signature::LDA_39_JMP);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool CartDetector::isProbablyX07(const ByteBuffer& image, size_t size)
+bool CartDetector::isProbablyX07(const SignatureHits& hits)
 {
   // X07 bankswitching switches to bank 0, 1, 2, etc by accessing address 0x08xd
-  uInt8 signature[6][3] = {
-    { 0xAD, 0x0D, 0x08 },  // LDA $080D
-    { 0xAD, 0x1D, 0x08 },  // LDA $081D
-    { 0xAD, 0x2D, 0x08 },  // LDA $082D
-    { 0x0C, 0x0D, 0x08 },  // NOP $080D
-    { 0x0C, 0x1D, 0x08 },  // NOP $081D
-    { 0x0C, 0x2D, 0x08 }   // NOP $082D
-  };
-  for(uInt32 i = 0; i < 6; ++i)
-    if(searchForBytes(image, size, signature[i], 3))
-      return true;
-
-  return false;
+  return hits.found(Signature::LDA_080D) || hits.found(Signature::LDA_081D) ||
+         hits.found(Signature::LDA_082D) || hits.found(Signature::NOP_080D) ||
+         hits.found(Signature::NOP_081D) || hits.found(Signature::NOP_082D);
 }
@@ -20,6 +20,7 @@
 
 #include "Bankswitch.hxx"
 #include "bspf.hxx"
+#include "RomImage.hxx"
 
 /**
   Auto-detect cart type based on various attributes (file size, signatures,
@@ -38,9 +39,59 @@ class CartDetector
 
       @return The "best guess" for the cartridge type
     */
-    static Bankswitch::Type autodetectType(const ByteBuffer& image, size_t size);
+    static Bankswitch::Type autodetectType(const RomImage& image, size_t size);
 
   private:
+    /**
+      The byte signatures the detection heuristics look for; the bytes
+      themselves are listed in CartDetector.cxx
+    */
+    enum class Signature: uInt8 {
+      STA_1FF9, STA_FFF9,                                        // F8
+      ARM_LOADER_1, ARM_LOADER_2,                                // ARM
+      LDA_0800, LDA_0840, BIT_0800, NOP_0800_JMP, NOP_0FFF_JMP,  // 0840
+      STA_3E, STA_3F,                                            // 3E, 3F
+      ID_3EX, ID_TJ3E, ID_BUS, ID_CDF, ID_PLUSCDFJ, ID_LENIN,    // strings
+      ID_DPCplus, ID_MDMC,
+      STA_F3FF_X, STA_F400_Y,                                    // CV
+      STA_1FE0, STA_5FE0, STA_FFE9, NOP_1FE0, LDA_1FE0,          // E0
+      LDA_FFE9, LDA_FFED, LDA_BFF3,
+      LDA_FFE2, LDA_FFE5, LDA_1FE5, LDA_1FE7, NOP_1FE7,          // E7
+      STA_FFE7, STA_1FE7,
+      LDA_FFE4, LDA_FFE6,                                        // E78K
+      NOP_FFE0, LDA_FFE0,                                        // EF
+      STA_1FF8_LSR, STA_FFF8_STA, STY_FFF9_LDA,                  // FC
+      JSR_D000_DEC, JSR_F8C3_LDA, BNE_JSR_FE73, JSR_F000_STY,    // FE
+      LDA_0800_X,                                                // SB
+      STA_82_JMP,                                                // TV Boy
+      STA_240, LDA_240, LDA_21F_X, BIT_2C0, STA_2C0, LDA_2C0,    // UA
+      BIT_FC0,
+      LDA_39_JMP,                                                // WD
+      LDA_080D, LDA_081D, LDA_082D,                              // X07
+      NOP_080D, NOP_081D, NOP_082D,
+      NumSignatures
+    };
+
+    /**
+      The number of times each signature occurs in a ROM image, counted for
+      all signatures in a single pass over the image.
+    */
+    class SignatureHits
+    {
+      public:
+        SignatureHits(const RomImage& image, size_t size);
+
+        /**
+          Returns true if the signature was found at least 'minhits' times
+        */
+        bool found(Signature signature, uInt32 minhits = 1) const {
+          return myCounts[static_cast<uInt8>(signature)] >= minhits;
+        }
+
+      private:
+        std::array<uInt32, static_cast<uInt8>(Signature::NumSignatures)> myCounts;
+    };
+
     /**
       Search the image for the specified byte signature
 
@@ -56,163 +107,157 @@ class CartDetector
                                const uInt8* signature, uInt32 sigsize,
                                uInt32 minhits = 1);
 
-    static bool searchForBytes(const ByteBuffer& image, size_t imagesize,
-                               const uInt8* signature, uInt32 sigsize,
-                               uInt32 minhits = 1)
-    {
-      return searchForBytes(image.get(), imagesize, signature, sigsize, minhits);
-    }
-
     /**
       Returns true if the image is probably a SuperChip (128 bytes RAM)
       Note: should be called only on ROMs with size multiple of 4K
     */
-    static bool isProbablySC(const ByteBuffer& image, size_t size);
+    static bool isProbablySC(const RomImage& image, size_t size);
 
     /**
       Returns true if the image probably contains ARM code in the first 1K
     */
-    static bool isProbablyARM(const ByteBuffer& image, size_t size);
+    static bool isProbablyARM(const SignatureHits& hits);
 
     /**
       Returns true if the image is probably a 0840 bankswitching cartridge
     */
-    static bool isProbably0840(const ByteBuffer& image, size_t size);
+    static bool isProbably0840(const SignatureHits& hits);
 
     /**
       Returns true if the image is probably a 3E bankswitching cartridge
     */
-    static bool isProbably3E(const ByteBuffer& image, size_t size);
+    static bool isProbably3E(const SignatureHits& hits);
 
     /**
     Returns true if the image is probably a 3EX bankswitching cartridge
     */
-    static bool isProbably3EX(const ByteBuffer& image, size_t size);
+    static bool isProbably3EX(const SignatureHits& hits);
 
     /**
       Returns true if the image is probably a 3E+ bankswitching cartridge
     */
-    static bool isProbably3EPlus(const ByteBuffer& image, size_t size);
+    static bool isProbably3EPlus(const SignatureHits& hits);
 
     /**
       Returns true if the image is probably a 3F bankswitching cartridge
     */
-    static bool isProbably3F(const ByteBuffer& image, size_t size);
+    static bool isProbably3F(const SignatureHits& hits);
 
     /**
       Returns true if the image is probably a 4A50 bankswitching cartridge
     */
-    static bool isProbably4A50(const ByteBuffer& image, size_t size);
+    static bool isProbably4A50(const RomImage& image, size_t size);
 
     /**
       Returns true if the image is probably a 4K SuperChip (128 bytes RAM)
     */
-    static bool isProbably4KSC(const ByteBuffer& image, size_t size);
+    static bool isProbably4KSC(const RomImage& image, size_t size);
 
     /**
       Returns true if the image is probably a BF/BFSC bankswitching cartridge
     */
-    static bool isProbablyBF(const ByteBuffer& image, size_t size, Bankswitch::Type& type);
+    static bool isProbablyBF(const RomImage& image, size_t size, Bankswitch::Type& type);
 
     /**
       Returns true if the image is probably a BUS bankswitching cartridge
     */
-    static bool isProbablyBUS(const ByteBuffer& image, size_t size);
+    static bool isProbablyBUS(const SignatureHits& hits);
 
     /**
       Returns true if the image is probably a CDF bankswitching cartridge
     */
-    static bool isProbablyCDF(const ByteBuffer& image, size_t size);
+    static bool isProbablyCDF(const SignatureHits& hits);
 
     /**
       Returns true if the image is probably a CTY bankswitching cartridge
     */
-    static bool isProbablyCTY(const ByteBuffer& image, size_t size);
+    static bool isProbablyCTY(const SignatureHits& hits);
 
     /**
       Returns true if the image is probably a CV bankswitching cartridge
     */
-    static bool isProbablyCV(const ByteBuffer& image, size_t size);
+    static bool isProbablyCV(const SignatureHits& hits);
 
     /**
       Returns true if the image is probably a DF/DFSC bankswitching cartridge
     */
-    static bool isProbablyDF(const ByteBuffer& image, size_t size, Bankswitch::Type& type);
+    static bool isProbablyDF(const RomImage& image, size_t size, Bankswitch::Type& type);
 
     /**
       Returns true if the image is probably a DPC+ bankswitching cartridge
     */
-    static bool isProbablyDPCplus(const ByteBuffer& image, size_t size);
+    static bool isProbablyDPCplus(const SignatureHits& hits);
 
     /**
       Returns true if the image is probably a E0 bankswitching cartridge
     */
-    static bool isProbablyE0(const ByteBuffer& image, size_t size);
+    static bool isProbablyE0(const SignatureHits& hits);
 
     /**
       Returns true if the image is probably a E7 bankswitching cartridge
     */
-    static bool isProbablyE7(const ByteBuffer& image, size_t size);
+    static bool isProbablyE7(const SignatureHits& hits);
 
     /**
     Returns true if the image is probably a E78K bankswitching cartridge
     */
-    static bool isProbablyE78K(const ByteBuffer& image, size_t size);
+    static bool isProbablyE78K(const SignatureHits& hits);
 
     /**
       Returns true if the image is probably an EF/EFSC bankswitching cartridge
     */
-    static bool isProbablyEF(const ByteBuffer& image, size_t size, Bankswitch::Type& type);
+    static bool isProbablyEF(const RomImage& image, size_t size,
+                             const SignatureHits& hits, Bankswitch::Type& type);
 
     /**
       Returns true if the image is probably an F6 bankswitching cartridge
     */
-    //static bool isProbablyF6(const ByteBuffer& image, size_t size);
+    //static bool isProbablyF6(const RomImage& image, size_t size);
 
     /**
       Returns true if the image is probably an FA2 bankswitching cartridge
     */
-    static bool isProbablyFA2(const ByteBuffer& image, size_t size);
+    static bool isProbablyFA2(const RomImage& image, size_t size);
 
     /**
       Returns true if the image is probably an FC bankswitching cartridge
     */
-    static bool isProbablyFC(const ByteBuffer& image, size_t size);
+    static bool isProbablyFC(const SignatureHits& hits);
 
     /**
       Returns true if the image is probably an FE bankswitching cartridge
     */
-    static bool isProbablyFE(const ByteBuffer& image, size_t size);
+    static bool isProbablyFE(const SignatureHits& hits);
 
     /**
       Returns true if the image is probably a MDM bankswitching cartridge
     */
-    static bool isProbablyMDM(const ByteBuffer& image, size_t size);
+    static bool isProbablyMDM(const SignatureHits& hits);
 
     /**
       Returns true if the image is probably a SB bankswitching cartridge
     */
-    static bool isProbablySB(const ByteBuffer& image, size_t size);
+    static bool isProbablySB(const SignatureHits& hits);
 
     /**
       Returns true if the image is probably a TV Boy bankswitching cartridge
     */
-    static bool isProbablyTVBoy(const ByteBuffer& image, size_t size);
+    static bool isProbablyTVBoy(const SignatureHits& hits);
 
     /**
       Returns true if the image is probably a UA bankswitching cartridge
     */
-    static bool isProbablyUA(const ByteBuffer& image, size_t size);
+    static bool isProbablyUA(const SignatureHits& hits);
 
     /**
       Returns true if the image is probably a Wickstead Design bankswitching cartridge
     */
-    static bool isProbablyWD(const ByteBuffer& image, size_t size);
+    static bool isProbablyWD(const SignatureHits& hits);
 
     /**
       Returns true if the image is probably an X07 bankswitching cartridge
     */
-    static bool isProbablyX07(const ByteBuffer& image, size_t size);
+    static bool isProbablyX07(const SignatureHits& hits);
 
   private:
     // Following constructors and assignment operators not supported
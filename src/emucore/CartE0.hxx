@@ -55,7 +55,7 @@ class CartridgeE0 : public CartridgeEnhanced
       @param settings  A reference to the various settings (read-only)
       @param bsSize    The size specified by the bankswitching scheme
     */
-    CartridgeE0(const ByteBuffer& image, size_t size, const string& md5,
+    CartridgeE0(const RomImage& image, size_t size, const string& md5,
                 const Settings& settings, size_t bsSize = 8_KB);
     ~CartridgeE0() override = default;
 
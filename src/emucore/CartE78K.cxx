@@ -19,7 +19,7 @@
 #include "CartE78K.hxx"
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-CartridgeE78K::CartridgeE78K(const ByteBuffer& image, size_t size,
+CartridgeE78K::CartridgeE78K(const RomImage& image, size_t size,
                              const string& md5, const Settings& settings)
   : CartridgeMNetwork(image, size, md5, settings)
 {
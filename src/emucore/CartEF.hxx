@@ -47,7 +47,7 @@ class CartridgeEF : public CartridgeEnhanced
       @param settings  A reference to the various settings (read-only)
       @param bsSize    The size specified by the bankswitching scheme
     */
-    CartridgeEF(const ByteBuffer& image, size_t size, const string& md5,
+    CartridgeEF(const RomImage& image, size_t size, const string& md5,
                 const Settings& settings, size_t bsSize = 64_KB);
     ~CartridgeEF() override = default;
 
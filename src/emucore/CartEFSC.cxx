@@ -19,7 +19,7 @@
 #include "CartEFSC.hxx"
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-CartridgeEFSC::CartridgeEFSC(const ByteBuffer& image, size_t size,
+CartridgeEFSC::CartridgeEFSC(const RomImage& image, size_t size,
                              const string& md5, const Settings& settings,
                              size_t bsSize)
   : CartridgeEF(image, size, md5, settings, bsSize)
@@ -48,7 +48,7 @@ class CartridgeEFSC : public CartridgeEF
       @param settings  A reference to the various settings (read-only)
       @param bsSize    The size specified by the bankswitching scheme
     */
-    CartridgeEFSC(const ByteBuffer& image, size_t size, const string& md5,
+    CartridgeEFSC(const RomImage& image, size_t size, const string& md5,
                   const Settings& settings, size_t bsSize = 64_KB);
     ~CartridgeEFSC() override = default;
 
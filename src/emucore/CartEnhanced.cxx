@@ -20,7 +20,7 @@
 #include "CartEnhanced.hxx"
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-CartridgeEnhanced::CartridgeEnhanced(const ByteBuffer& image, size_t size,
+CartridgeEnhanced::CartridgeEnhanced(const RomImage& image, size_t size,
                                      const string& md5, const Settings& settings,
                                      size_t bsSize)
   : Cartridge(settings, md5)
@@ -46,14 +46,20 @@ CartridgeEnhanced::CartridgeEnhanced(const ByteBuffer& image, size_t size,
 
   mySize = bsSize;
 
-  // Initialize ROM with all 0's, to fill areas that the ROM may not cover
-  myImage = make_unique<uInt8[]>(mySize);
-  std::fill_n(myImage.get(), mySize, 0);
+  if(size >= mySize)
+  {
+    // Reference the ROM image directly; it is only copied when patched
+    myImage = image;
+  }
+  else
+  {
+    // Initialize ROM with all 0's, to fill areas that the ROM may not cover
+    myImage = RomImage(mySize);
 
-  // Directly copy the ROM image into the buffer
-  // Only copy up to the amount of data the ROM provides; extra unused
-  // space will be filled with 0's from above
-  std::copy_n(image.get(), std::min(mySize, size), myImage.get());
+    // Only copy up to the amount of data the ROM provides; extra unused
+    // space will be filled with 0's from above
+    std::copy_n(image.get(), size, myImage.modify());
+  }
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -341,14 +347,37 @@ bool CartridgeEnhanced::patch(uInt16 address, uInt8 value)
       myRAM[address & myRamMask] = value;
     }
     else
-      myImage[romAddressSegmentOffset(address) + (address & myBankMask)] = value;
+    {
+      // A shared image is copied on the first patch, so the pages have to
+      // be pointed to the copy
+      const uInt8* oldImage = myImage.get();
+      myImage.modify()[romAddressSegmentOffset(address) + (address & myBankMask)] = value;
+      if(myImage.get() != oldImage)
+        remapImage(oldImage);
+    }
   }
 
   return myBankChanged = true;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-const ByteBuffer& CartridgeEnhanced::getImage(size_t& size) const
+void CartridgeEnhanced::remapImage(const uInt8* oldImage)
+{
+  for(uInt16 addr = 0; addr < 0x2000; addr += System::PAGE_SIZE)
+  {
+    System::PageAccess access = mySystem->getPageAccess(addr);
+
+    if(access.device == this && access.directPeekBase >= oldImage &&
+       access.directPeekBase < oldImage + mySize)
+    {
+      access.directPeekBase = myImage.get() + (access.directPeekBase - oldImage);
+      mySystem->setPageAccess(addr, access);
+    }
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+const RomImage& CartridgeEnhanced::getImage(size_t& size) const
 {
   size = mySize;
   return myImage;
@@ -45,7 +45,7 @@ class CartridgeEnhanced : public Cartridge
       @param settings  A reference to the various settings (read-only)
       @param bsSize    The size specified by the bankswitching scheme
     */
-    CartridgeEnhanced(const ByteBuffer& image, size_t size,
+    CartridgeEnhanced(const RomImage& image, size_t size,
                       const string& md5, const Settings& settings,
                       size_t bsSize);
     ~CartridgeEnhanced() override = default;
@@ -122,7 +122,7 @@ class CartridgeEnhanced : public Cartridge
       @param size  Set to the size of the internal ROM image data
       @return  A reference to the internal ROM image data
     */
-    const ByteBuffer& getImage(size_t& size) const override;
+    const RomImage& getImage(size_t& size) const override;
 
     /**
       Save the current state of this cart to the given Serializer.
@@ -209,8 +209,9 @@ class CartridgeEnhanced : public Cartridge
     // Flag, true if write port is at high and read port is at low address
     bool myRamWpHigh{RAM_HIGH_WP};
 
-    // Pointer to a dynamically allocated ROM image of the cartridge
-    ByteBuffer myImage{nullptr};
+    // The ROM image of the cartridge; usually shared with the image the
+    // cart was created from, until it is patched
+    RomImage myImage;
 
     // Contains the offset into the ROM image for each of the bank segments
     DWordBuffer myCurrentSegOffset{nullptr};
@@ -290,6 +291,14 @@ class CartridgeEnhanced : public Cartridge
         ((address & ROM_MASK) >> myBankShift) % myBankSegs] - mySize) >> 1);
     }
 
+    /**
+      Point the direct peek pages which reference the given former ROM
+      image to the current one.
+
+      @param oldImage  The previous address of the ROM image
+    */
+    void remapImage(const uInt8* oldImage);
+
   private:
     // Following constructors and assignment operators not supported
     CartridgeEnhanced() = delete;
@@ -18,7 +18,7 @@
 #include "CartF4SC.hxx"
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-CartridgeF4SC::CartridgeF4SC(const ByteBuffer& image, size_t size,
+CartridgeF4SC::CartridgeF4SC(const RomImage& image, size_t size,
                              const string& md5, const Settings& settings,
                              size_t bsSize)
   : CartridgeF4(image, size, md5, settings, bsSize)
@@ -44,7 +44,7 @@ class CartridgeF4SC : public CartridgeF4
       @param settings  A reference to the various settings (read-only)
       @param bsSize    The size specified by the bankswitching scheme
     */
-    CartridgeF4SC(const ByteBuffer& image, size_t size, const string& md5,
+    CartridgeF4SC(const RomImage& image, size_t size, const string& md5,
                   const Settings& settings, size_t bsSize = 32_KB);
     ~CartridgeF4SC() override = default;
 
@@ -18,7 +18,7 @@
 #include "CartF6SC.hxx"
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-CartridgeF6SC::CartridgeF6SC(const ByteBuffer& image, size_t size,
+CartridgeF6SC::CartridgeF6SC(const RomImage& image, size_t size,
                              const string& md5, const Settings& settings,
                              size_t bsSize)
   : CartridgeF6(image, size, md5, settings, bsSize)
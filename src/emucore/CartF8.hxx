@@ -43,7 +43,7 @@ class CartridgeF8 : public CartridgeEnhanced
       @param settings  A reference to the various settings (read-only)
       @param bsSize    The size specified by the bankswitching scheme
     */
-    CartridgeF8(const ByteBuffer& image, size_t size, const string& md5,
+    CartridgeF8(const RomImage& image, size_t size, const string& md5,
                 const Settings& settings, size_t bsSize = 8_KB);
     ~CartridgeF8() override = default;
 
@@ -18,7 +18,7 @@
 #include "CartF8SC.hxx"
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-CartridgeF8SC::CartridgeF8SC(const ByteBuffer& image, size_t size,
+CartridgeF8SC::CartridgeF8SC(const RomImage& image, size_t size,
                              const string& md5, const Settings& settings,
                              size_t bsSize)
   : CartridgeF8(image, size, md5, settings, bsSize)
@@ -44,7 +44,7 @@ class CartridgeF8SC : public CartridgeF8
       @param settings  A reference to the various settings (read-only)
       @param bsSize    The size specified by the bankswitching scheme
     */
-    CartridgeF8SC(const ByteBuffer& image, size_t size, const string& md5,
+    CartridgeF8SC(const RomImage& image, size_t size, const string& md5,
                   const Settings& settings, size_t bsSize = 8_KB);
     ~CartridgeF8SC() override = default;
 
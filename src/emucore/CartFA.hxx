@@ -47,7 +47,7 @@ class CartridgeFA : public CartridgeEnhanced
       @param settings  A reference to the various settings (read-only)
       @param bsSize    The size specified by the bankswitching scheme
     */
-    CartridgeFA(const ByteBuffer& image, size_t size, const string& md5,
+    CartridgeFA(const RomImage& image, size_t size, const string& md5,
                 const Settings& settings, size_t bsSize = 12_KB);
     ~CartridgeFA() override = default;
 
@@ -19,7 +19,7 @@
 #include "CartFA2.hxx"
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-CartridgeFA2::CartridgeFA2(const ByteBuffer& image, size_t size,
+CartridgeFA2::CartridgeFA2(const RomImage& image, size_t size,
                            const string& md5, const Settings& settings,
                            size_t bsSize)
   : CartridgeFA(image, size, md5, settings, bsSize)
@@ -33,10 +33,10 @@ CartridgeFA2::CartridgeFA2(const ByteBuffer& image, size_t size,
   }
 
   // Allocate array for the ROM image
-  myImage = make_unique<uInt8[]>(mySize);
+  myImage = RomImage(mySize);
 
   // Copy the ROM image into my buffer
-  std::copy_n(img_ptr, mySize, myImage.get());
+  std::copy_n(img_ptr, mySize, myImage.modify());
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
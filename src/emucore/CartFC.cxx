@@ -19,7 +19,7 @@
 #include "CartFC.hxx"
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-CartridgeFC::CartridgeFC(const ByteBuffer& image, size_t size,
+CartridgeFC::CartridgeFC(const RomImage& image, size_t size,
                          const string& md5, const Settings& settings,
                          size_t bsSize)
   : CartridgeEnhanced(image, size, md5, settings,
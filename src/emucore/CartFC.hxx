@@ -50,7 +50,7 @@ class CartridgeFC : public CartridgeEnhanced
       @param bsSize    The size specified by the bankswitching scheme
                        (where 0 means variable-sized ROM)
     */
-    CartridgeFC(const ByteBuffer& image, size_t size, const string& md5,
+    CartridgeFC(const RomImage& image, size_t size, const string& md5,
                 const Settings& settings, size_t bsSize = 0);
     ~CartridgeFC() override = default;
 
@@ -89,7 +89,7 @@ class CartridgeFE : public CartridgeEnhanced
       @param settings  A reference to the various settings (read-only)
       @param bsSize    The size specified by the bankswitching scheme
     */
-    CartridgeFE(const ByteBuffer& image, size_t size, const string& md5,
+    CartridgeFE(const RomImage& image, size_t size, const string& md5,
                 const Settings& settings, size_t bsSize = 8_KB);
     ~CartridgeFE() override = default;
 
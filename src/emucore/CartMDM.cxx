@@ -19,7 +19,7 @@
 #include "CartMDM.hxx"
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-CartridgeMDM::CartridgeMDM(const ByteBuffer& image, size_t size,
+CartridgeMDM::CartridgeMDM(const RomImage& image, size_t size,
                            const string& md5, const Settings& settings,
                            size_t bsSize)
   : CartridgeEnhanced(image, size, md5, settings,
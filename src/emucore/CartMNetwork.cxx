@@ -19,7 +19,7 @@
 #include "CartMNetwork.hxx"
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-CartridgeMNetwork::CartridgeMNetwork(const ByteBuffer& image, size_t size,
+CartridgeMNetwork::CartridgeMNetwork(const RomImage& image, size_t size,
                                      const string& md5, const Settings& settings)
   : Cartridge(settings, md5),
     mySize(size)
@@ -27,13 +27,13 @@ CartridgeMNetwork::CartridgeMNetwork(const ByteBuffer& image, size_t size,
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-void CartridgeMNetwork::initialize(const ByteBuffer& image, size_t size)
+void CartridgeMNetwork::initialize(const RomImage& image, size_t size)
 {
   // Allocate array for the ROM image
-  myImage = make_unique<uInt8[]>(size);
+  myImage = RomImage(size);
 
   // Copy the ROM image into my buffer
-  std::copy_n(image.get(), std::min<size_t>(romSize(), size), myImage.get());
+  std::copy_n(image.get(), std::min<size_t>(romSize(), size), myImage.modify());
   createRomAccessArrays(romSize() + myRAM.size());
 
   myRAMBank = romBankCount() - 1;
@@ -57,7 +57,7 @@ void CartridgeMNetwork::reset()
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void CartridgeMNetwork::setAccess(uInt16 addrFrom, uInt16 size,
-    uInt16 directOffset, uInt8* directData, uInt16 codeOffset,
+    uInt16 directOffset, const uInt8* directData, uInt16 codeOffset,
     System::PageAccessType type, uInt16 addrMask)
 {
   if(addrMask == 0)
@@ -247,7 +247,7 @@ bool CartridgeMNetwork::patch(uInt16 address, uInt8 value)
       myRAM[address & 0x03FF] = value;
     }
     else
-      myImage[(myCurrentBank[0] << 11) + (address & (BANK_SIZE-1))] = value;
+      myImage.modify()[(myCurrentBank[0] << 11) + (address & (BANK_SIZE-1))] = value;
   }
   else if(address < 0x0900)
   {
@@ -257,13 +257,13 @@ bool CartridgeMNetwork::patch(uInt16 address, uInt8 value)
     myRAM[0x0400 + (myCurrentRAM << 8) + (address & 0x00FF)] = value;
   }
   else
-    myImage[(myCurrentBank[address >> 11] << 11) + (address & (BANK_SIZE-1))] = value;
+    myImage.modify()[(myCurrentBank[address >> 11] << 11) + (address & (BANK_SIZE-1))] = value;
 
   return myBankChanged = true;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-const ByteBuffer& CartridgeMNetwork::getImage(size_t& size) const
+const RomImage& CartridgeMNetwork::getImage(size_t& size) const
 {
   size = romBankCount() * BANK_SIZE;
   return myImage;
@@ -73,7 +73,7 @@ class CartridgeMNetwork : public Cartridge
       @param md5       The md5sum of the ROM image
       @param settings  A reference to the various settings (read-only)
     */
-    CartridgeMNetwork(const ByteBuffer& image, size_t size, const string& md5,
+    CartridgeMNetwork(const RomImage& image, size_t size, const string& md5,
                       const Settings& settings);
     ~CartridgeMNetwork() override = default;
 
@@ -128,7 +128,7 @@ class CartridgeMNetwork : public Cartridge
       @param size  Set to the size of the internal ROM image data
       @return  A reference to the internal ROM image data
     */
-    const ByteBuffer& getImage(size_t& size) const override;
+    const RomImage& getImage(size_t& size) const override;
 
     /**
       Save the current state of this cart to the given Serializer.
@@ -167,7 +167,7 @@ class CartridgeMNetwork : public Cartridge
     /**
       Class initialization
     */
-    void initialize(const ByteBuffer& image, size_t size);
+    void initialize(const RomImage& image, size_t size);
 
     /**
       Install pages for the specified 256 byte bank of RAM
@@ -195,12 +195,12 @@ class CartridgeMNetwork : public Cartridge
     */
     virtual void checkSwitchBank(uInt16 address) = 0;
 
-    void setAccess(uInt16 addrFrom, uInt16 size, uInt16 directOffset, uInt8* directData,
+    void setAccess(uInt16 addrFrom, uInt16 size, uInt16 directOffset, const uInt8* directData,
                    uInt16 codeOffset, System::PageAccessType type, uInt16 addrMask = 0);
 
   private:
     // Pointer to a dynamically allocated ROM image of the cartridge
-    ByteBuffer myImage;
+    RomImage myImage;
 
     // Size of the ROM image
     size_t mySize{0};
@@ -48,7 +48,7 @@ class CartridgeSB : public CartridgeEnhanced
       @param bsSize    The size specified by the bankswitching scheme
                        (where 0 means variable-sized ROM)
     */
-    CartridgeSB(const ByteBuffer& image, size_t size, const string& md5,
+    CartridgeSB(const RomImage& image, size_t size, const string& md5,
                 const Settings& settings, size_t bsSize = 0);
     ~CartridgeSB() override = default;
 
@@ -19,7 +19,7 @@
 #include "CartTVBoy.hxx"
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-CartridgeTVBoy::CartridgeTVBoy(const ByteBuffer& image, size_t size,
+CartridgeTVBoy::CartridgeTVBoy(const RomImage& image, size_t size,
                          const string& md5, const Settings& settings,
                          size_t bsSize)
   : CartridgeEnhanced(image, size, md5, settings, bsSize)
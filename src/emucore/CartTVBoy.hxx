@@ -46,7 +46,7 @@ class CartridgeTVBoy : public CartridgeEnhanced
       @param settings  A reference to the various settings (read-only)
       @param bsSize    The size specified by the bankswitching scheme
     */
-    CartridgeTVBoy(const ByteBuffer& image, size_t size, const string& md5,
+    CartridgeTVBoy(const RomImage& image, size_t size, const string& md5,
                  const Settings& settings, size_t bsSize = 512_KB);
     ~CartridgeTVBoy() override = default;
 
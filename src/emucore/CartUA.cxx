@@ -19,7 +19,7 @@
 #include "CartUA.hxx"
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-CartridgeUA::CartridgeUA(const ByteBuffer& image, size_t size,
+CartridgeUA::CartridgeUA(const RomImage& image, size_t size,
                          const string& md5, const Settings& settings,
                          bool swapHotspots)
   : CartridgeEnhanced(image, size, md5, settings, 8_KB),
@@ -21,7 +21,7 @@
 #include "CartWD.hxx"
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-CartridgeWD::CartridgeWD(const ByteBuffer& image, size_t size,
+CartridgeWD::CartridgeWD(const RomImage& image, size_t size,
                          const string& md5, const Settings& settings,
                          size_t bsSize)
   : CartridgeEnhanced(image, size, md5, settings, bsSize)
@@ -30,8 +30,8 @@ CartridgeWD::CartridgeWD(const ByteBuffer& image, size_t size,
   if(size == 8_KB + 3)
   {
     // swap banks 2 & 3 of bad dump and correct size
-    std::copy_n(image.get() + 1_KB * 3, 1_KB * 1, myImage.get() + 1_KB * 2);
-    std::copy_n(image.get() + 1_KB * 2, 1_KB * 1, myImage.get() + 1_KB * 3);
+    std::copy_n(image.get() + 1_KB * 3, 1_KB * 1, myImage.modify() + 1_KB * 2);
+    std::copy_n(image.get() + 1_KB * 2, 1_KB * 1, myImage.modify() + 1_KB * 3);
     mySize = 8_KB;
   }
   myDirectPeek = false;
@@ -67,7 +67,7 @@ class CartridgeWD : public CartridgeEnhanced
       @param settings  A reference to the various settings (read-only)
       @param bsSize    The size specified by the bankswitching scheme
     */
-    CartridgeWD(const ByteBuffer& image, size_t size, const string& md5,
+    CartridgeWD(const RomImage& image, size_t size, const string& md5,
                 const Settings& settings, size_t bsSize = 8_KB);
     ~CartridgeWD() override = default;
 
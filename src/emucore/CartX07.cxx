@@ -21,7 +21,7 @@
 #include "CartX07.hxx"
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-CartridgeX07::CartridgeX07(const ByteBuffer& image, size_t size,
+CartridgeX07::CartridgeX07(const RomImage& image, size_t size,
                            const string& md5, const Settings& settings,
                            size_t bsSize)
   : CartridgeEnhanced(image, size, md5, settings, bsSize)
@@ -56,7 +56,7 @@ class CartridgeX07 : public CartridgeEnhanced
       @param settings  A reference to the various settings (read-only)
       @param bsSize    The size specified by the bankswitching scheme
     */
-    CartridgeX07(const ByteBuffer& image, size_t size, const string& md5,
+    CartridgeX07(const RomImage& image, size_t size, const string& md5,
                  const Settings& settings, size_t bsSize = 64_KB);
     ~CartridgeX07() override = default;
 
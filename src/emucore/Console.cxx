@@ -46,6 +46,7 @@
 #include "Paddles.hxx"
 #include "Props.hxx"
 #include "PropsSet.hxx"
+#include "RomMetadataCache.hxx"
 #include "SaveKey.hxx"
 #include "Settings.hxx"
 #include "Sound.hxx"
@@ -172,7 +173,32 @@ Console::Console(OSystem& osystem, unique_ptr<Cartridge>& cart,
 
   if(myDisplayFormat == "AUTO" || myOSystem.settings().getBool("rominfo"))
   {
-    autodetectFrameLayout();
+    // Detection runs the emulation for a while, so reuse any earlier result
+    // (but not for parts of a multicart, which share the file), as long as
+    // it was detected with the same bankswitching type, controllers and
+    // start bank, which the properties may override
+    RomMetadataCache& cache = myOSystem.romCache();
+    RomMetadataCache::Metadata data;
+    const bool cached = cache.get(myOSystem.romFile(), data) && data.md5 == md5;
+    const string key = myCart->detectedType() + "," +
+      Controller::getName(myLeftControl->type()) + "," +
+      Controller::getName(myRightControl->type()) + "," +
+      myProperties.get(PropType::Cart_StartBank);
+
+    if(cached && data.displayFormat != "" && data.displayFormatKey == key &&
+       !myOSystem.settings().getBool("rominfo"))
+      myDisplayFormat = data.displayFormat;
+    else
+    {
+      autodetectFrameLayout();
+
+      if(cached)
+      {
+        data.displayFormat = myDisplayFormat;
+        data.displayFormatKey = key;
+        cache.put(myOSystem.romFile(), data);
+      }
+    }
 
     if(myProperties.get(PropType::Display_Format) == "AUTO")
     {
@@ -818,7 +844,7 @@ void Console::setControllers(const string& romMd5)
     Controller::Type rightType =
         Controller::getType(myProperties.get(PropType::Controller_Right));
     size_t size = 0;
-    const ByteBuffer& image = myCart->getImage(size);
+    const RomImage& image = myCart->getImage(size);
     const bool swappedPorts =
         myProperties.get(PropType::Console_SwapPorts) == "YES";
 
@@ -89,9 +89,14 @@ bool Controller::load(Serializer& in)
     setPin(DigitalPin::Four,  in.getBool());
     setPin(DigitalPin::Six,   in.getBool());
 
-    // Input the analog pins
-    setPin(AnalogPin::Five, in.getInt());
-    setPin(AnalogPin::Nine, in.getInt());
+    // Input the analog pins; only changes are passed on, so that loading a
+    // state doesn't disturb the paddle readout of the TIA
+    for(AnalogPin pin: {AnalogPin::Five, AnalogPin::Nine})
+    {
+      const Int32 value = in.getInt();
+      if(value != getPin(pin))
+        setPin(pin, value);
+    }
   }
   catch(...)
   {
@@ -23,7 +23,7 @@
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 Controller::Type ControllerDetector::detectType(
-    const ByteBuffer& image, size_t size,
+    const RomImage& image, size_t size,
     const Controller::Type type, const Controller::Jack port,
     const Settings& settings)
 {
@@ -45,7 +45,7 @@ Controller::Type ControllerDetector::detectType(
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-string ControllerDetector::detectName(const ByteBuffer& image, size_t size,
+string ControllerDetector::detectName(const RomImage& image, size_t size,
     const Controller::Type controller, const Controller::Jack port,
     const Settings& settings)
 {
@@ -54,7 +54,7 @@ string ControllerDetector::detectName(const ByteBuffer& image, size_t size,
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 Controller::Type ControllerDetector::autodetectPort(
-    const ByteBuffer& image, size_t size,
+    const RomImage& image, size_t size,
     Controller::Jack port, const Settings& settings)
 {
   // default type joystick
@@ -93,7 +93,7 @@ Controller::Type ControllerDetector::autodetectPort(
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool ControllerDetector::searchForBytes(const ByteBuffer& image, size_t imagesize,
+bool ControllerDetector::searchForBytes(const RomImage& image, size_t imagesize,
                                         const uInt8* signature, uInt32 sigsize)
 {
   if (imagesize >= sigsize)
@@ -117,7 +117,7 @@ bool ControllerDetector::searchForBytes(const ByteBuffer& image, size_t imagesiz
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool ControllerDetector::usesJoystickButton(const ByteBuffer& image, size_t size,
+bool ControllerDetector::usesJoystickButton(const RomImage& image, size_t size,
                                             Controller::Jack port)
 {
   if(port == Controller::Jack::Left)
@@ -248,7 +248,7 @@ bool ControllerDetector::usesJoystickButton(const ByteBuffer& image, size_t size
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool ControllerDetector::usesKeyboard(const ByteBuffer& image, size_t size,
+bool ControllerDetector::usesKeyboard(const RomImage& image, size_t size,
                                       Controller::Jack port)
 {
   if(port == Controller::Jack::Left)
@@ -389,7 +389,7 @@ bool ControllerDetector::usesKeyboard(const ByteBuffer& image, size_t size,
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool ControllerDetector::usesGenesisButton(const ByteBuffer& image, size_t size,
+bool ControllerDetector::usesGenesisButton(const RomImage& image, size_t size,
                                            Controller::Jack port)
 {
   if(port == Controller::Jack::Left)
@@ -447,7 +447,7 @@ bool ControllerDetector::usesGenesisButton(const ByteBuffer& image, size_t size,
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool ControllerDetector::usesPaddle(const ByteBuffer& image, size_t size,
+bool ControllerDetector::usesPaddle(const RomImage& image, size_t size,
                                     Controller::Jack port, const Settings& settings)
 {
   if(port == Controller::Jack::Left)
@@ -556,7 +556,7 @@ bool ControllerDetector::usesPaddle(const ByteBuffer& image, size_t size,
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool ControllerDetector::isProbablyTrakBall(const ByteBuffer& image, size_t size)
+bool ControllerDetector::isProbablyTrakBall(const RomImage& image, size_t size)
 {
   // check for TrakBall tables
   const int NUM_SIGS = 3;
@@ -575,7 +575,7 @@ bool ControllerDetector::isProbablyTrakBall(const ByteBuffer& image, size_t size
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool ControllerDetector::isProbablyAtariMouse(const ByteBuffer& image, size_t size)
+bool ControllerDetector::isProbablyAtariMouse(const RomImage& image, size_t size)
 {
   // check for Atari Mouse tables
   const int NUM_SIGS = 3;
@@ -594,7 +594,7 @@ bool ControllerDetector::isProbablyAtariMouse(const ByteBuffer& image, size_t si
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool ControllerDetector::isProbablyAmigaMouse(const ByteBuffer& image, size_t size)
+bool ControllerDetector::isProbablyAmigaMouse(const RomImage& image, size_t size)
 {
   // check for Amiga Mouse tables
   const int NUM_SIGS = 4;
@@ -614,7 +614,7 @@ bool ControllerDetector::isProbablyAmigaMouse(const ByteBuffer& image, size_t si
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool ControllerDetector::isProbablySaveKey(const ByteBuffer& image, size_t size,
+bool ControllerDetector::isProbablySaveKey(const RomImage& image, size_t size,
                                            Controller::Jack port)
 {
   // check for known SaveKey code, only supports right port
@@ -659,7 +659,7 @@ bool ControllerDetector::isProbablySaveKey(const ByteBuffer& image, size_t size,
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool ControllerDetector::isProbablyLightGun(const ByteBuffer& image, size_t size,
+bool ControllerDetector::isProbablyLightGun(const RomImage& image, size_t size,
                                             Controller::Jack port)
 {
   if (port == Controller::Jack::Left)
@@ -696,7 +696,7 @@ bool ControllerDetector::isProbablyLightGun(const ByteBuffer& image, size_t size
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool ControllerDetector::isProbablyQuadTari(const ByteBuffer& image, size_t size,
+bool ControllerDetector::isProbablyQuadTari(const RomImage& image, size_t size,
                                             Controller::Jack port)
 {
   uInt8 signatureBoth[] = { 0x1B, 0x1F, 0x0B, 0x0E, 0x1E, 0x0B, 0x1C, 0x13 }; // "QUADTARI"
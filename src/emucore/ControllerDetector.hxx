@@ -21,6 +21,7 @@
 class Settings;
 
 #include "Control.hxx"
+#include "RomImage.hxx"
 
 /**
   Auto-detect controller type by matching determining pattern.
@@ -41,7 +42,7 @@ class ControllerDetector
       @param settings   A reference to the various settings (read-only)
       @return   The detected controller type
     */
-    static Controller::Type detectType(const ByteBuffer& image, size_t size,
+    static Controller::Type detectType(const RomImage& image, size_t size,
         const Controller::Type controller, const Controller::Jack port,
         const Settings& settings);
 
@@ -57,7 +58,7 @@ class ControllerDetector
 
       @return   The (detected) controller name
     */
-    static string detectName(const ByteBuffer& image, size_t size,
+    static string detectName(const RomImage& image, size_t size,
         const Controller::Type type, const Controller::Jack port,
         const Settings& settings);
 
@@ -72,7 +73,7 @@ class ControllerDetector
 
       @return   The detected controller type
     */
-    static Controller::Type autodetectPort(const ByteBuffer& image, size_t size,
+    static Controller::Type autodetectPort(const RomImage& image, size_t size,
         Controller::Jack port, const Settings& settings);
 
     /**
@@ -85,44 +86,44 @@ class ControllerDetector
 
       @return  True if the signature was found, else false
     */
-    static bool searchForBytes(const ByteBuffer& image, size_t imagesize,
+    static bool searchForBytes(const RomImage& image, size_t imagesize,
                                const uInt8* signature, uInt32 sigsize);
 
     // Returns true if the port's joystick button access code is found.
-    static bool usesJoystickButton(const ByteBuffer& image, size_t size,
+    static bool usesJoystickButton(const RomImage& image, size_t size,
                                    Controller::Jack port);
 
     // Returns true if the port's keyboard access code is found.
-    static bool usesKeyboard(const ByteBuffer& image, size_t size,
+    static bool usesKeyboard(const RomImage& image, size_t size,
                              Controller::Jack port);
 
     // Returns true if the port's 2nd Genesis button access code is found.
-    static bool usesGenesisButton(const ByteBuffer& image, size_t size,
+    static bool usesGenesisButton(const RomImage& image, size_t size,
                                   Controller::Jack port);
 
     // Returns true if the port's paddle button access code is found.
-    static bool usesPaddle(const ByteBuffer& image, size_t size,
+    static bool usesPaddle(const RomImage& image, size_t size,
                            Controller::Jack port, const Settings& settings);
 
     // Returns true if a Trak-Ball table is found.
-    static bool isProbablyTrakBall(const ByteBuffer& image, size_t size);
+    static bool isProbablyTrakBall(const RomImage& image, size_t size);
 
     // Returns true if an Atari Mouse table is found.
-    static bool isProbablyAtariMouse(const ByteBuffer& image, size_t size);
+    static bool isProbablyAtariMouse(const RomImage& image, size_t size);
 
     // Returns true if an Amiga Mouse table is found.
-    static bool isProbablyAmigaMouse(const ByteBuffer& image, size_t size);
+    static bool isProbablyAmigaMouse(const RomImage& image, size_t size);
 
     // Returns true if a SaveKey code pattern is found.
-    static bool isProbablySaveKey(const ByteBuffer& image, size_t size,
+    static bool isProbablySaveKey(const RomImage& image, size_t size,
                                   Controller::Jack port);
 
     // Returns true if a Lightgun code pattern is found
-    static bool isProbablyLightGun(const ByteBuffer& image, size_t size,
+    static bool isProbablyLightGun(const RomImage& image, size_t size,
                                    Controller::Jack port);
 
     // Returns true if a QuadTari code pattern is found.
-    static bool isProbablyQuadTari(const ByteBuffer& image, size_t size,
+    static bool isProbablyQuadTari(const RomImage& image, size_t size,
                                    Controller::Jack port);
 
   private:
@@ -35,6 +35,7 @@
 #include "Settings.hxx"
 #include "Sound.hxx"
 #include "StateManager.hxx"
+#include "RunAheadManager.hxx"
 #include "RewindManager.hxx"
 #include "TimerManager.hxx"
 #ifdef GUI_SUPPORT
@@ -139,6 +140,7 @@ void EventHandler::reset(EventHandlerState state)
 {
   setState(state);
   myOSystem.state().reset();
+  myOSystem.runAhead().reset();
 #ifdef PNG_SUPPORT
   myOSystem.png().setContinuousSnapInterval(0);
 #endif
@@ -334,6 +334,18 @@ class FBSurface
     */
     virtual bool render() = 0;
 
+    /**
+      This method should be called before render() to tell the surface that
+      only the given rows of its pixel buffer changed since the previous
+      render(), so that only those have to be transferred to the screen.
+      It applies to the next render() only; without it, all rows are
+      assumed to have changed.
+
+      @param top     The first changed row
+      @param bottom  One past the last changed row (top == bottom: none)
+    */
+    virtual void setDirtyRows(uInt32 top, uInt32 bottom) { }
+
     /**
       This method should be called to reset the surface to empty
       pixels / colour black.
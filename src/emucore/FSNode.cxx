@@ -340,6 +340,18 @@ bool FilesystemNode::rename(const string& newfile)
   return (_realNode && _realNode->exists()) ? _realNode->rename(newfile) : false;
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool FilesystemNode::getSizeAndTime(size_t& size, uInt64& mtime) const
+{
+  return _realNode ? _realNode->getSizeAndTime(size, mtime) : false;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+FileMappingPtr FilesystemNode::map() const
+{
+  return _realNode ? _realNode->map() : nullptr;
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 size_t FilesystemNode::read(ByteBuffer& buffer) const
 {
@@ -34,6 +34,8 @@
 class FilesystemNode;
 class AbstractFSNode;
 using AbstractFSNodePtr = shared_ptr<AbstractFSNode>;
+class FileMapping;
+using FileMappingPtr = shared_ptr<const FileMapping>;
 
 /**
  * List of multiple file system nodes. E.g. the contents of a given directory.
@@ -42,6 +44,33 @@ using AbstractFSNodePtr = shared_ptr<AbstractFSNode>;
  */
 class FSList : public vector<FilesystemNode> { };
 
+/**
+ * A read-only view of the complete contents of a file, typically a memory
+ * mapping created by the platform-specific node.  The data stays valid for
+ * the lifetime of this object.
+ */
+class FileMapping
+{
+  public:
+    virtual ~FileMapping() = default;
+
+    const uInt8* data() const { return myData; }
+    size_t size() const { return mySize; }
+
+  protected:
+    FileMapping() = default;
+
+    const uInt8* myData{nullptr};
+    size_t mySize{0};
+
+  private:
+    // Following constructors and assignment operators not supported
+    FileMapping(const FileMapping&) = delete;
+    FileMapping(FileMapping&&) = delete;
+    FileMapping& operator=(const FileMapping&) = delete;
+    FileMapping& operator=(FileMapping&&) = delete;
+};
+
 /**
  * This class acts as a wrapper around the AbstractFSNode class defined
  * in backends/fs.
@@ -233,6 +262,26 @@ class FilesystemNode
      */
     bool rename(const string& newfile);
 
+    /**
+     * Get the size of the file and the time of its last modification, so
+     * that changes to the file can be detected.
+     *
+     * @param size   The size of the file in bytes
+     * @param mtime  The modification time (in platform-dependent units)
+     *
+     * @return  True if the information is available, else false
+     */
+    bool getSizeAndTime(size_t& size, uInt64& mtime) const;
+
+    /**
+     * Map the (non-empty) file read-only into memory, so that it can be
+     * accessed without reading it into a buffer.
+     *
+     * @return  The mapping, or nullptr if the file can't be mapped (e.g. it
+     *          is contained in a ZIP archive); use read() in that case
+     */
+    FileMappingPtr map() const;
+
     /**
      * Read data (binary format) into the given buffer.
      *
@@ -427,6 +476,20 @@ class AbstractFSNode
      */
     virtual bool rename(const string& newfile) = 0;
 
+    /**
+     * Get the size of the file and the time of its last modification.
+     *
+     * @return  True if the information is available, else false
+     */
+    virtual bool getSizeAndTime(size_t& size, uInt64& mtime) const { return false; }
+
+    /**
+     * Map the file read-only into memory.
+     *
+     * @return  The mapping, or nullptr if not supported or possible
+     */
+    virtual FileMappingPtr map() const { return nullptr; }
+
     /**
      * Read data (binary format) into the given buffer.
      *
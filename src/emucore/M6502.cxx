@@ -18,6 +18,9 @@
 #ifdef DEBUGGER_SUPPORT
   #include "Debugger.hxx"
   #include "Expression.hxx"
+  #include "CompiledExpression.hxx"
+  #include "TraceRecorder.hxx"
+  #include "Profiler.hxx"
   #include "Device.hxx"
   #include "Base.hxx"
 
@@ -45,12 +48,34 @@
 #include "exception/EmulationWarning.hxx"
 #include "exception/FatalEmulationError.hxx"
 
+#ifdef M6502_THREADED_DISPATCH
+  #define THREADED_INSTRUCTION(_opcode) op_##_opcode:
+
+  #define THREADED_NEXT_INSTRUCTION                                       \
+    if(debugging || myExecutionStatus ||                                  \
+       mySystem->cycles() - previousCycles >= cycles * SYSTEM_CYCLES_PER_CPU) \
+      goto instructionDone;                                               \
+    myDataAddressForPoke = 0;                                             \
+    icycles = 0;                                                          \
+    IR = peek(PC++, DISASM_CODE);                                         \
+    goto *dispatchTable[IR];
+
+  #define M6502_LABELS(_hi) \
+    &&op_0x##_hi##0, &&op_0x##_hi##1, &&op_0x##_hi##2, &&op_0x##_hi##3, \
+    &&op_0x##_hi##4, &&op_0x##_hi##5, &&op_0x##_hi##6, &&op_0x##_hi##7, \
+    &&op_0x##_hi##8, &&op_0x##_hi##9, &&op_0x##_hi##a, &&op_0x##_hi##b, \
+    &&op_0x##_hi##c, &&op_0x##_hi##d, &&op_0x##_hi##e, &&op_0x##_hi##f
+#endif
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 M6502::M6502(const Settings& settings)
   : mySettings(settings)
 {
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+M6502::~M6502() = default;
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void M6502::install(System& system)
 {
@@ -186,10 +211,34 @@ inline void M6502::handleHalt()
   }
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+template<bool threaded>
+inline void M6502::dispatch(uInt64 number, DispatchResult& result)
+{
+#ifdef DEBUGGER_SUPPORT
+  if(debuggerArmed())
+    _execute<true, threaded>(number, result);
+  else
+  {
+    // Nothing checks for illegal cart RAM accesses here, so just make sure
+    // that their list doesn't grow indefinitely
+    mySystem->cart().clearAllRAMAccesses();
+    _execute<false, threaded>(number, result);
+  }
+#else
+  _execute<false, threaded>(number, result);
+#endif
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void M6502::execute(uInt64 number, DispatchResult& result)
 {
-  _execute(number, result);
+#ifdef M6502_THREADED_DISPATCH
+  if(myThreadedDispatch)
+    dispatch<true>(number, result);
+  else
+#endif
+    dispatch<false>(number, result);
 
 #ifdef DEBUGGER_SUPPORT
   // Debugger hack: this ensures that stepping a "STA WSYNC" will actually end at the
@@ -217,6 +266,7 @@ bool M6502::execute(uInt64 number)
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+template<bool debugging, bool threaded>
 inline void M6502::_execute(uInt64 cycles, DispatchResult& result)
 {
   myExecutionStatus = 0;
@@ -236,7 +286,7 @@ inline void M6502::_execute(uInt64 cycles, DispatchResult& result)
     {
   #ifdef DEBUGGER_SUPPORT
       // Don't break if we haven't actually executed anything yet
-      if (myLastBreakCycle != mySystem->cycles()) {
+      if (debugging && myLastBreakCycle != mySystem->cycles()) {
         if(myJustHitReadTrapFlag || myJustHitWriteTrapFlag)
         {
           bool read = myJustHitReadTrapFlag;
@@ -285,15 +335,18 @@ inline void M6502::_execute(uInt64 cycles, DispatchResult& result)
         }
       }
 
-      int cond = evalCondSaveStates();
-      if(cond > -1)
+      if(debugging)
       {
-        ostringstream msg;
-        msg << "conditional savestate [" << Common::Base::HEX2 << cond << "]";
-        myDebugger->addState(msg.str());
-      }
+        int cond = evalCondSaveStates();
+        if(cond > -1)
+        {
+          ostringstream msg;
+          msg << "conditional savestate [" << Common::Base::HEX2 << cond << "]";
+          myDebugger->addState(msg.str());
+        }
 
-      mySystem->cart().clearAllRAMAccesses();
+        mySystem->cart().clearAllRAMAccesses();
+      }
   #endif  // DEBUGGER_SUPPORT
 
       // Reset the data poke address pointer
@@ -306,23 +359,74 @@ inline void M6502::_execute(uInt64 cycles, DispatchResult& result)
         icycles = 0;
     #ifdef DEBUGGER_SUPPORT
         uInt16 oldPC = PC;
+
+        if(debugging && myProfiler)
+        {
+          // Process a pending halt now, so that the time spent waiting for
+          // WSYNC counts for the previous instruction
+          handleHalt();
+          tia.updateEmulation();
+          myProfiler->next(PC, uInt8(mySystem->cart().getBank(PC)),
+                           tia.scanlines(), mySystem->cycles());
+        }
+
+        if(debugging && myTraceRecorder)
+          myTraceRecorder->begin(mySystem->cycles(), PC, A, X, Y, SP, PS(),
+                                 uInt8(mySystem->cart().getBank(PC)));
     #endif
 
         // Fetch instruction at the program counter
         IR = peek(PC++, DISASM_CODE);  // This address represents a code section
 
-        // Call code to execute the instruction
-        switch(IR)
+    #ifdef M6502_THREADED_DISPATCH
+        if constexpr(threaded)
         {
+          // Every instruction jumps directly to the code of the next one, which
+          // gives each of them its own (and thus much better predicted) branch.
+          // The debugger checks have to run between all instructions, though.
+          // Labels as values are an extension, which '-pedantic' warns about.
+          #pragma GCC diagnostic push
+          #pragma GCC diagnostic ignored "-Wpedantic"
+          static const void* const dispatchTable[256] = {
+            M6502_LABELS(0), M6502_LABELS(1), M6502_LABELS(2), M6502_LABELS(3),
+            M6502_LABELS(4), M6502_LABELS(5), M6502_LABELS(6), M6502_LABELS(7),
+            M6502_LABELS(8), M6502_LABELS(9), M6502_LABELS(a), M6502_LABELS(b),
+            M6502_LABELS(c), M6502_LABELS(d), M6502_LABELS(e), M6502_LABELS(f)
+          };
+
+          goto *dispatchTable[IR];
+
+          #define INSTRUCTION(_opcode) THREADED_INSTRUCTION(_opcode)
+          #define NEXT_INSTRUCTION THREADED_NEXT_INSTRUCTION
+
           // 6502 instruction emulation is generated by an M4 macro file
           #include "M6502.ins"
 
-          default:
-            FatalEmulationError::raise("invalid instruction");
+          #undef INSTRUCTION
+          #undef NEXT_INSTRUCTION
+          #pragma GCC diagnostic pop
+
+        instructionDone: ;
+        }
+        else
+    #endif
+        {
+          // Call code to execute the instruction
+          switch(IR)
+          {
+            // 6502 instruction emulation is generated by an M4 macro file
+            #include "M6502.ins"
+
+            default:
+              FatalEmulationError::raise("invalid instruction");
+          }
         }
 
     #ifdef DEBUGGER_SUPPORT
-        if(myReadFromWritePortBreak)
+        if(debugging && myTraceRecorder)
+          myTraceRecorder->end(IR, myLastAddress, mySystem->getDataBusState());
+
+        if(debugging && myReadFromWritePortBreak)
         {
           uInt16 rwpAddr = mySystem->cart().getIllegalRAMReadAccess();
           if(rwpAddr)
@@ -334,7 +438,7 @@ inline void M6502::_execute(uInt64 cycles, DispatchResult& result)
           }
         }
 
-        if (myWriteToReadPortBreak)
+        if (debugging && myWriteToReadPortBreak)
         {
           uInt16 wrpAddr = mySystem->cart().getIllegalRAMWriteAccess();
           if (wrpAddr)
@@ -357,7 +461,7 @@ inline void M6502::_execute(uInt64 cycles, DispatchResult& result)
       currentCycles = (mySystem->cycles() - previousCycles);
 
   #ifdef DEBUGGER_SUPPORT
-      if(myStepStateByInstruction)
+      if(debugging && myStepStateByInstruction)
       {
         // Check out M6502::execute for an explanation.
         handleHalt();
@@ -537,7 +641,7 @@ void M6502::attach(Debugger& debugger)
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 uInt32 M6502::addCondBreak(Expression* e, const string& name, bool oneShot)
 {
-  myCondBreaks.emplace_back(e);
+  myCondBreaks.emplace_back(make_unique<CompiledExpression>(e));
   myCondBreakNames.push_back(name);
 
   updateStepStateByInstruction();
@@ -578,7 +682,7 @@ const StringList& M6502::getCondBreakNames() const
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 uInt32 M6502::addCondSaveState(Expression* e, const string& name)
 {
-  myCondSaveStates.emplace_back(e);
+  myCondSaveStates.emplace_back(make_unique<CompiledExpression>(e));
   myCondSaveStateNames.push_back(name);
 
   updateStepStateByInstruction();
@@ -619,7 +723,7 @@ const StringList& M6502::getCondSaveStateNames() const
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 uInt32 M6502::addCondTrap(Expression* e, const string& name)
 {
-  myTrapConds.emplace_back(e);
+  myTrapConds.emplace_back(make_unique<CompiledExpression>(e));
   myTrapCondNames.push_back(name);
 
   updateStepStateByInstruction();
@@ -657,6 +761,36 @@ const StringList& M6502::getCondTrapNames() const
   return myTrapCondNames;
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+Int32 M6502::evalCondBreaks()
+{
+  for(Int32 i = Int32(myCondBreaks.size()) - 1; i >= 0; --i)
+    if(myCondBreaks[i]->evaluate())
+      return i;
+
+  return -1; // no break hit
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+Int32 M6502::evalCondSaveStates()
+{
+  for(Int32 i = Int32(myCondSaveStates.size()) - 1; i >= 0; --i)
+    if(myCondSaveStates[i]->evaluate())
+      return i;
+
+  return -1; // no save state point hit
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+Int32 M6502::evalCondTraps()
+{
+  for(Int32 i = Int32(myTrapConds.size()) - 1; i >= 0; --i)
+    if(myTrapConds[i]->evaluate())
+      return i;
+
+  return -1; // no trapif hit
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void M6502::updateStepStateByInstruction()
 {
@@ -27,6 +27,9 @@ class DispatchResult;
 #ifdef DEBUGGER_SUPPORT
   class Debugger;
   class CpuDebug;
+  class CompiledExpression;
+  class TraceRecorder;
+  class Profiler;
 
   #include "Expression.hxx"
   #include "TrapArray.hxx"
@@ -35,6 +38,13 @@ class DispatchResult;
 
 #include "bspf.hxx"
 #include "Device.hxx"
+
+// With M6502_THREADED_DISPATCH defined ('--enable-threadedcpu'), compilers
+// supporting labels as values ("computed goto") dispatch the instructions
+// through a table instead of a switch
+#if defined(M6502_THREADED_DISPATCH) && !(defined(__GNUC__) || defined(__clang__))
+  #undef M6502_THREADED_DISPATCH
+#endif
 #include "Serializable.hxx"
 
 /**
@@ -64,7 +74,7 @@ class M6502 : public Serializable
       Create a new 6502 microprocessor.
     */
     explicit M6502(const Settings& settings);
-    ~M6502() override = default;
+    ~M6502() override;
 
   public:
     /**
@@ -224,6 +234,17 @@ class M6502 : public Serializable
     */
     bool load(Serializer& in) override;
 
+#ifdef M6502_THREADED_DISPATCH
+    /**
+      Choose between the threaded (default) and the switch based dispatch
+      of the instructions.  Both of them are compiled into threaded builds,
+      so that they can be checked against each other ('make check').
+
+      @param enable  Use the threaded dispatch
+    */
+    void setThreadedDispatch(bool enable) { myThreadedDispatch = enable; }
+#endif
+
 #ifdef DEBUGGER_SUPPORT
   public:
     // Attach the specified debugger.
@@ -255,6 +276,14 @@ class M6502 : public Serializable
     void setGhostReadsTrap(bool enable) { myGhostReadsTrap = enable; }
     void setReadFromWritePortBreak(bool enable) { myReadFromWritePortBreak = enable; }
     void setWriteToReadPortBreak(bool enable) { myWriteToReadPortBreak = enable; }
+
+    // Record every executed instruction into the given recorder (or stop
+    // recording when it is the null pointer)
+    void setTraceRecorder(TraceRecorder* recorder) { myTraceRecorder = recorder; }
+
+    // Count the cycles of every executed instruction in the given profiler
+    // (or stop profiling when it is the null pointer)
+    void setProfiler(Profiler* profiler) { myProfiler = profiler; }
 #endif  // DEBUGGER_SUPPORT
 
   private:
@@ -325,10 +354,25 @@ class M6502 : public Serializable
     */
     void handleHalt();
 
+    /**
+      Run the instructions through the threaded or the switch based dispatch,
+      with or without the debugger checks.
+    */
+    template<bool threaded>
+    void dispatch(uInt64 cycles, DispatchResult& result);
+
     /**
       This is the actual dispatch function that does the grunt work. M6502::execute
       wraps it and makes sure that any pending halt is processed before returning.
+
+      With 'debugging' false, none of the (breakpoint, trap, etc.) checks
+      between the instructions are done; this is only valid while none of
+      them are armed.
+
+      With 'threaded' true, the instructions are dispatched through a table
+      of labels instead of a switch (only in threaded builds).
     */
+    template<bool debugging, bool threaded>
     void _execute(uInt64 cycles, DispatchResult& result);
 
 #ifdef DEBUGGER_SUPPORT
@@ -337,6 +381,20 @@ class M6502 : public Serializable
       with the CPU and update the flag accordingly.
     */
     void updateStepStateByInstruction();
+
+    /**
+      Answers whether any breakpoints, traps, conditional breaks, conditional
+      savestates or port breaks are armed, or a trace is being recorded or
+      the code is being profiled, which have to be checked between the
+      instructions.
+    */
+    bool debuggerArmed() const {
+      return myBreakPoints.size() || myReadTraps.isInitialized() ||
+             myWriteTraps.isInitialized() || myStepStateByInstruction ||
+             myReadFromWritePortBreak || myWriteToReadPortBreak ||
+             myJustHitReadTrapFlag || myJustHitWriteTrapFlag ||
+             myTraceRecorder || myProfiler;
+    }
 #endif  // DEBUGGER_SUPPORT
 
   private:
@@ -414,32 +472,15 @@ class M6502 : public Serializable
     /// Indicates whether RDY was pulled low
     bool myHaltRequested{false};
 
-#ifdef DEBUGGER_SUPPORT
-    Int32 evalCondBreaks() {
-      for(Int32 i = Int32(myCondBreaks.size()) - 1; i >= 0; --i)
-        if(myCondBreaks[i]->evaluate())
-          return i;
-
-      return -1; // no break hit
-    }
-
-    Int32 evalCondSaveStates()
-    {
-      for(Int32 i = Int32(myCondSaveStates.size()) - 1; i >= 0; --i)
-        if(myCondSaveStates[i]->evaluate())
-          return i;
-
-      return -1; // no save state point hit
-    }
-
-    Int32 evalCondTraps()
-    {
-      for(Int32 i = Int32(myTrapConds.size()) - 1; i >= 0; --i)
-        if(myTrapConds[i]->evaluate())
-          return i;
+#ifdef M6502_THREADED_DISPATCH
+    /// Indicates whether the instructions are dispatched through the table
+    bool myThreadedDispatch{true};
+#endif
 
-      return -1; // no trapif hit
-    }
+#ifdef DEBUGGER_SUPPORT
+    Int32 evalCondBreaks();
+    Int32 evalCondSaveStates();
+    Int32 evalCondTraps();
 
     /// Pointer to the debugger for this processor or the null pointer
     Debugger* myDebugger{nullptr};
@@ -457,12 +498,18 @@ class M6502 : public Serializable
     HitTrapInfo myHitTrapInfo;
 
     BreakpointMap myBreakPoints;
-    vector<unique_ptr<Expression>> myCondBreaks;
+    vector<unique_ptr<CompiledExpression>> myCondBreaks;
     StringList myCondBreakNames;
-    vector<unique_ptr<Expression>> myCondSaveStates;
+    vector<unique_ptr<CompiledExpression>> myCondSaveStates;
     StringList myCondSaveStateNames;
-    vector<unique_ptr<Expression>> myTrapConds;
+    vector<unique_ptr<CompiledExpression>> myTrapConds;
     StringList myTrapCondNames;
+
+    /// Pointer to the recorder of the executed instructions or the null pointer
+    TraceRecorder* myTraceRecorder{nullptr};
+
+    /// Pointer to the profiler of the executed instructions or the null pointer
+    Profiler* myProfiler{nullptr};
 #endif  // DEBUGGER_SUPPORT
 
     bool myGhostReadsTrap{false};          // trap on ghost reads
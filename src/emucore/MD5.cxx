@@ -46,266 +46,200 @@
 
 namespace MD5 {
 
-// Setup the types used by the MD5 routines
-using POINTER = uInt8*;
-
-// MD5 context.
-struct MD5_CTX
-{
-  uInt32 state[4];    /* state (ABCD) */
-  uInt32 count[2];    /* number of bits, modulo 2^64 (lsb first) */
-  uInt8 buffer[64];   /* input buffer */
-};
-
-// Constants for MD5Transform routine.
-#define S11 7
-#define S12 12
-#define S13 17
-#define S14 22
-#define S21 5
-#define S22 9
-#define S23 14
-#define S24 20
-#define S31 4
-#define S32 11
-#define S33 16
-#define S34 23
-#define S41 6
-#define S42 10
-#define S43 15
-#define S44 21
-
-static void MD5Init(MD5_CTX*);
-static void MD5Update(MD5_CTX*, const uInt8*, uInt32);
-static void MD5Final(uInt8[16], MD5_CTX*);
-static void MD5Transform(uInt32 [4], const uInt8 [64]);
-static void Encode(uInt8*, uInt32*, uInt32);
-static void Decode(uInt32*, const uInt8*, uInt32);
-
-static uInt8 PADDING[64] = {
-  0x80, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-  0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-  0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
-};
-
-// F, G, H and I are basic MD5 functions.
-#define F(x, y, z) (((x) & (y)) | ((~x) & (z)))
-#define G(x, y, z) (((x) & (z)) | ((y) & (~z)))
-#define H(x, y, z) ((x) ^ (y) ^ (z))
-#define I(x, y, z) ((y) ^ ((x) | (~z)))
-
-// ROTATE_LEFT rotates x left n bits.
-#define ROTATE_LEFT(x, n) (((x) << (n)) | ((x) >> (32-(n))))
-
-// FF, GG, HH, and II transformations for rounds 1, 2, 3, and 4.
-// Rotation is separate from addition to prevent recomputation.
-#define FF(a, b, c, d, x, s, ac) { \
- (a) += F ((b), (c), (d)) + (x) + uInt32(ac); \
- (a) = ROTATE_LEFT ((a), (s)); \
- (a) += (b); \
-  }
-#define GG(a, b, c, d, x, s, ac) { \
- (a) += G ((b), (c), (d)) + (x) + uInt32(ac); \
- (a) = ROTATE_LEFT ((a), (s)); \
- (a) += (b); \
-  }
-#define HH(a, b, c, d, x, s, ac) { \
- (a) += H ((b), (c), (d)) + (x) + uInt32(ac); \
- (a) = ROTATE_LEFT ((a), (s)); \
- (a) += (b); \
+namespace {
+  // Shift amounts for the four rounds of the transform
+  constexpr uInt32 S11 = 7,  S12 = 12, S13 = 17, S14 = 22;
+  constexpr uInt32 S21 = 5,  S22 = 9,  S23 = 14, S24 = 20;
+  constexpr uInt32 S31 = 4,  S32 = 11, S33 = 16, S34 = 23;
+  constexpr uInt32 S41 = 6,  S42 = 10, S43 = 15, S44 = 21;
+
+  // Read a little-endian 32-bit word; compilers turn this into a single
+  // load on little-endian hosts
+  inline uInt32 getWord(const uInt8* p)
+  {
+    return uInt32(p[0]) | (uInt32(p[1]) << 8) |
+          (uInt32(p[2]) << 16) | (uInt32(p[3]) << 24);
   }
-#define II(a, b, c, d, x, s, ac) { \
- (a) += I ((b), (c), (d)) + (x) + uInt32(ac); \
- (a) = ROTATE_LEFT ((a), (s)); \
- (a) += (b); \
+
+  inline uInt32 rotateLeft(uInt32 x, uInt32 n)
+  {
+    return (x << n) | (x >> (32 - n));
   }
 
-// MD5 initialization. Begins an MD5 operation, writing a new context.
-static void MD5Init(MD5_CTX* context)
-{
-  context->count[0] = context->count[1] = 0;
-  /* Load magic initialization constants. */
-  context->state[0] = 0x67452301;
-  context->state[1] = 0xefcdab89;
-  context->state[2] = 0x98badcfe;
-  context->state[3] = 0x10325476;
+  // F, G, H and I are the basic MD5 functions; F and G are written with
+  // one operation less than in RFC 1321, which gives the same results
+  inline uInt32 F(uInt32 x, uInt32 y, uInt32 z) { return z ^ (x & (y ^ z)); }
+  inline uInt32 G(uInt32 x, uInt32 y, uInt32 z) { return y ^ (z & (x ^ y)); }
+  inline uInt32 H(uInt32 x, uInt32 y, uInt32 z) { return x ^ y ^ z; }
+  inline uInt32 I(uInt32 x, uInt32 y, uInt32 z) { return y ^ (x | ~z); }
 }
 
-// MD5 block update operation. Continues an MD5 message-digest
-// operation, processing another message block, and updating the
-// context.
-static void MD5Update(MD5_CTX* context, const uInt8* input,
-    uInt32 inputLen)
-{
-  uInt32 i, index, partLen;
-
-  /* Compute number of bytes mod 64 */
-  index = uInt32((context->count[0] >> 3) & 0x3F);
-
-  /* Update number of bits */
-  if ((context->count[0] += (uInt32(inputLen) << 3))
-   < (uInt32(inputLen) << 3))
-    context->count[1]++;
-  context->count[1] += (uInt32(inputLen) >> 29);
-
-  partLen = 64 - index;
-
-  /* Transform as many times as possible. */
-  if (inputLen >= partLen) {
-    memcpy (const_cast<POINTER>(&context->buffer[index]),
-            const_cast<POINTER>(input), partLen);
-    MD5Transform (context->state, context->buffer);
-
-    for (i = partLen; i + 63 < inputLen; i += 64)
-      MD5Transform (context->state, &input[i]);
-
-    index = 0;
-  }
-  else
-    i = 0;
+// FF, GG, HH, and II transformations for rounds 1, 2, 3, and 4.
+#define STEP(f, a, b, c, d, x, s, ac) \
+  (a) = rotateLeft((a) + f((b), (c), (d)) + (x) + uInt32(ac), (s)) + (b);
+#define FF(a, b, c, d, x, s, ac) STEP(F, a, b, c, d, x, s, ac)
+#define GG(a, b, c, d, x, s, ac) STEP(G, a, b, c, d, x, s, ac)
+#define HH(a, b, c, d, x, s, ac) STEP(H, a, b, c, d, x, s, ac)
+#define II(a, b, c, d, x, s, ac) STEP(I, a, b, c, d, x, s, ac)
 
-  /* Buffer remaining input */
-  memcpy(const_cast<POINTER>(&context->buffer[index]),
-         const_cast<POINTER>(&input[i]), inputLen-i);
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void Context::reset()
+{
+  // Load magic initialization constants
+  myState = { 0x67452301, 0xefcdab89, 0x98badcfe, 0x10325476 };
+  myLength = 0;
 }
 
-// MD5 finalization. Ends an MD5 message-digest operation, writing the
-// the message digest and zeroizing the context.
-static void MD5Final(uInt8 digest[16], MD5_CTX* context)
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void Context::update(const uInt8* data, size_t length)
 {
-  uInt8 bits[8];
-  uInt32 index, padLen;
-
-  /* Save number of bits */
-  Encode (bits, context->count, 8);
+  size_t index = size_t(myLength % 64);
+  myLength += length;
 
-  /* Pad out to 56 mod 64. */
-  index = uInt32((context->count[0] >> 3) & 0x3f);
-  padLen = (index < 56) ? (56 - index) : (120 - index);
-  MD5Update (context, PADDING, padLen);
+  // Complete a partial block from the previous call first
+  if(index > 0)
+  {
+    const size_t n = std::min(length, 64 - index);
+    std::copy_n(data, n, myBuffer.begin() + index);
+    data += n;  length -= n;
+    if(index + n < 64)
+      return;
 
-  /* Append length (before padding) */
-  MD5Update (context, bits, 8);
-  /* Store state in digest */
-  Encode (digest, context->state, 16);
+    transform(myBuffer.data());
+  }
 
-  /* Zeroize sensitive information. */
-  memset (reinterpret_cast<POINTER>(context), 0, sizeof(*context));
-}
+  // Full blocks are processed directly from the input, without copying
+  for(; length >= 64; data += 64, length -= 64)
+    transform(data);
 
-// MD5 basic transformation. Transforms state based on block.
-static void MD5Transform(uInt32 state[4], const uInt8 block[64])
-{
-  uInt32 a = state[0], b = state[1], c = state[2], d = state[3], x[16];
-
-  Decode (x, block, 64);
-
-  /* Round 1 */
-  FF (a, b, c, d, x[ 0], S11, 0xd76aa478) /* 1 */
-  FF (d, a, b, c, x[ 1], S12, 0xe8c7b756) /* 2 */
-  FF (c, d, a, b, x[ 2], S13, 0x242070db) /* 3 */
-  FF (b, c, d, a, x[ 3], S14, 0xc1bdceee) /* 4 */
-  FF (a, b, c, d, x[ 4], S11, 0xf57c0faf) /* 5 */
-  FF (d, a, b, c, x[ 5], S12, 0x4787c62a) /* 6 */
-  FF (c, d, a, b, x[ 6], S13, 0xa8304613) /* 7 */
-  FF (b, c, d, a, x[ 7], S14, 0xfd469501) /* 8 */
-  FF (a, b, c, d, x[ 8], S11, 0x698098d8) /* 9 */
-  FF (d, a, b, c, x[ 9], S12, 0x8b44f7af) /* 10 */
-  FF (c, d, a, b, x[10], S13, 0xffff5bb1) /* 11 */
-  FF (b, c, d, a, x[11], S14, 0x895cd7be) /* 12 */
-  FF (a, b, c, d, x[12], S11, 0x6b901122) /* 13 */
-  FF (d, a, b, c, x[13], S12, 0xfd987193) /* 14 */
-  FF (c, d, a, b, x[14], S13, 0xa679438e) /* 15 */
-  FF (b, c, d, a, x[15], S14, 0x49b40821) /* 16 */
-
-  /* Round 2 */
-  GG (a, b, c, d, x[ 1], S21, 0xf61e2562) /* 17 */
-  GG (d, a, b, c, x[ 6], S22, 0xc040b340) /* 18 */
-  GG (c, d, a, b, x[11], S23, 0x265e5a51) /* 19 */
-  GG (b, c, d, a, x[ 0], S24, 0xe9b6c7aa) /* 20 */
-  GG (a, b, c, d, x[ 5], S21, 0xd62f105d) /* 21 */
-  GG (d, a, b, c, x[10], S22,  0x2441453) /* 22 */
-  GG (c, d, a, b, x[15], S23, 0xd8a1e681) /* 23 */
-  GG (b, c, d, a, x[ 4], S24, 0xe7d3fbc8) /* 24 */
-  GG (a, b, c, d, x[ 9], S21, 0x21e1cde6) /* 25 */
-  GG (d, a, b, c, x[14], S22, 0xc33707d6) /* 26 */
-  GG (c, d, a, b, x[ 3], S23, 0xf4d50d87) /* 27 */
-  GG (b, c, d, a, x[ 8], S24, 0x455a14ed) /* 28 */
-  GG (a, b, c, d, x[13], S21, 0xa9e3e905) /* 29 */
-  GG (d, a, b, c, x[ 2], S22, 0xfcefa3f8) /* 30 */
-  GG (c, d, a, b, x[ 7], S23, 0x676f02d9) /* 31 */
-  GG (b, c, d, a, x[12], S24, 0x8d2a4c8a) /* 32 */
-
-  /* Round 3 */
-  HH (a, b, c, d, x[ 5], S31, 0xfffa3942) /* 33 */
-  HH (d, a, b, c, x[ 8], S32, 0x8771f681) /* 34 */
-  HH (c, d, a, b, x[11], S33, 0x6d9d6122) /* 35 */
-  HH (b, c, d, a, x[14], S34, 0xfde5380c) /* 36 */
-  HH (a, b, c, d, x[ 1], S31, 0xa4beea44) /* 37 */
-  HH (d, a, b, c, x[ 4], S32, 0x4bdecfa9) /* 38 */
-  HH (c, d, a, b, x[ 7], S33, 0xf6bb4b60) /* 39 */
-  HH (b, c, d, a, x[10], S34, 0xbebfbc70) /* 40 */
-  HH (a, b, c, d, x[13], S31, 0x289b7ec6) /* 41 */
-  HH (d, a, b, c, x[ 0], S32, 0xeaa127fa) /* 42 */
-  HH (c, d, a, b, x[ 3], S33, 0xd4ef3085) /* 43 */
-  HH (b, c, d, a, x[ 6], S34,  0x4881d05) /* 44 */
-  HH (a, b, c, d, x[ 9], S31, 0xd9d4d039) /* 45 */
-  HH (d, a, b, c, x[12], S32, 0xe6db99e5) /* 46 */
-  HH (c, d, a, b, x[15], S33, 0x1fa27cf8) /* 47 */
-  HH (b, c, d, a, x[ 2], S34, 0xc4ac5665) /* 48 */
-
-  /* Round 4 */
-  II (a, b, c, d, x[ 0], S41, 0xf4292244) /* 49 */
-  II (d, a, b, c, x[ 7], S42, 0x432aff97) /* 50 */
-  II (c, d, a, b, x[14], S43, 0xab9423a7) /* 51 */
-  II (b, c, d, a, x[ 5], S44, 0xfc93a039) /* 52 */
-  II (a, b, c, d, x[12], S41, 0x655b59c3) /* 53 */
-  II (d, a, b, c, x[ 3], S42, 0x8f0ccc92) /* 54 */
-  II (c, d, a, b, x[10], S43, 0xffeff47d) /* 55 */
-  II (b, c, d, a, x[ 1], S44, 0x85845dd1) /* 56 */
-  II (a, b, c, d, x[ 8], S41, 0x6fa87e4f) /* 57 */
-  II (d, a, b, c, x[15], S42, 0xfe2ce6e0) /* 58 */
-  II (c, d, a, b, x[ 6], S43, 0xa3014314) /* 59 */
-  II (b, c, d, a, x[13], S44, 0x4e0811a1) /* 60 */
-  II (a, b, c, d, x[ 4], S41, 0xf7537e82) /* 61 */
-  II (d, a, b, c, x[11], S42, 0xbd3af235) /* 62 */
-  II (c, d, a, b, x[ 2], S43, 0x2ad7d2bb) /* 63 */
-  II (b, c, d, a, x[ 9], S44, 0xeb86d391) /* 64 */
-
-  state[0] += a;
-  state[1] += b;
-  state[2] += c;
-  state[3] += d;
-
-  /* Zeroize sensitive information. */
-  memset (reinterpret_cast<POINTER>(x), 0, sizeof(x));
+  std::copy_n(data, length, myBuffer.begin());
 }
 
-// Encodes input (uInt32) into output (uInt8). Assumes len is
-// a multiple of 4.
-static void Encode(uInt8* output, uInt32* input, uInt32 len)
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+string Context::finalize()
 {
-  uInt32 i, j;
-
-  for (i = 0, j = 0; j < len; ++i, j += 4) {
-    output[j]   = uInt8(input[i] & 0xff);
-    output[j+1] = uInt8((input[i] >> 8) & 0xff);
-    output[j+2] = uInt8((input[i] >> 16) & 0xff);
-    output[j+3] = uInt8((input[i] >> 24) & 0xff);
+  // Pad with 0x80 and zeroes to 56 bytes mod 64, then append the length
+  // of the message in bits
+  const uInt64 bits = myLength * 8;
+  const size_t index = size_t(myLength % 64);
+  std::array<uInt8, 72> padding{};
+  padding[0] = 0x80;
+  const size_t padLen = (index < 56) ? (56 - index) : (120 - index);
+  for(int i = 0; i < 8; ++i)
+    padding[padLen + i] = uInt8(bits >> (i * 8));
+  update(padding.data(), padLen + 8);
+
+  static constexpr char hex[] = "0123456789abcdef";
+  string result(32, '0');
+  for(size_t i = 0; i < 16; ++i)
+  {
+    const uInt8 byte = uInt8(myState[i / 4] >> ((i % 4) * 8));
+    result[i * 2]     = hex[byte >> 4];
+    result[i * 2 + 1] = hex[byte & 0x0f];
   }
+
+  return result;
 }
 
-// Decodes input (uInt8) into output (uInt32). Assumes len is
-// a multiple of 4.
-static void Decode(uInt32* output, const uInt8* input, uInt32 len)
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void Context::transform(const uInt8* block)
 {
-  uInt32 i, j;
-
-  for (i = 0, j = 0; j < len; ++i, j += 4)
-    output[i] = (uInt32(input[j])) | ((uInt32(input[j+1])) << 8) |
-    ((uInt32(input[j+2])) << 16) | ((uInt32(input[j+3])) << 24);
+  const uInt32
+    x0  = getWord(block),      x1  = getWord(block + 4),
+    x2  = getWord(block + 8),  x3  = getWord(block + 12),
+    x4  = getWord(block + 16), x5  = getWord(block + 20),
+    x6  = getWord(block + 24), x7  = getWord(block + 28),
+    x8  = getWord(block + 32), x9  = getWord(block + 36),
+    x10 = getWord(block + 40), x11 = getWord(block + 44),
+    x12 = getWord(block + 48), x13 = getWord(block + 52),
+    x14 = getWord(block + 56), x15 = getWord(block + 60);
+
+  uInt32 a = myState[0], b = myState[1], c = myState[2], d = myState[3];
+
+  // Round 1
+  FF(a, b, c, d, x0,  S11, 0xd76aa478)
+  FF(d, a, b, c, x1,  S12, 0xe8c7b756)
+  FF(c, d, a, b, x2,  S13, 0x242070db)
+  FF(b, c, d, a, x3,  S14, 0xc1bdceee)
+  FF(a, b, c, d, x4,  S11, 0xf57c0faf)
+  FF(d, a, b, c, x5,  S12, 0x4787c62a)
+  FF(c, d, a, b, x6,  S13, 0xa8304613)
+  FF(b, c, d, a, x7,  S14, 0xfd469501)
+  FF(a, b, c, d, x8,  S11, 0x698098d8)
+  FF(d, a, b, c, x9,  S12, 0x8b44f7af)
+  FF(c, d, a, b, x10, S13, 0xffff5bb1)
+  FF(b, c, d, a, x11, S14, 0x895cd7be)
+  FF(a, b, c, d, x12, S11, 0x6b901122)
+  FF(d, a, b, c, x13, S12, 0xfd987193)
+  FF(c, d, a, b, x14, S13, 0xa679438e)
+  FF(b, c, d, a, x15, S14, 0x49b40821)
+
+  // Round 2
+  GG(a, b, c, d, x1,  S21, 0xf61e2562)
+  GG(d, a, b, c, x6,  S22, 0xc040b340)
+  GG(c, d, a, b, x11, S23, 0x265e5a51)
+  GG(b, c, d, a, x0,  S24, 0xe9b6c7aa)
+  GG(a, b, c, d, x5,  S21, 0xd62f105d)
+  GG(d, a, b, c, x10, S22, 0x02441453)
+  GG(c, d, a, b, x15, S23, 0xd8a1e681)
+  GG(b, c, d, a, x4,  S24, 0xe7d3fbc8)
+  GG(a, b, c, d, x9,  S21, 0x21e1cde6)
+  GG(d, a, b, c, x14, S22, 0xc33707d6)
+  GG(c, d, a, b, x3,  S23, 0xf4d50d87)
+  GG(b, c, d, a, x8,  S24, 0x455a14ed)
+  GG(a, b, c, d, x13, S21, 0xa9e3e905)
+  GG(d, a, b, c, x2,  S22, 0xfcefa3f8)
+  GG(c, d, a, b, x7,  S23, 0x676f02d9)
+  GG(b, c, d, a, x12, S24, 0x8d2a4c8a)
+
+  // Round 3
+  HH(a, b, c, d, x5,  S31, 0xfffa3942)
+  HH(d, a, b, c, x8,  S32, 0x8771f681)
+  HH(c, d, a, b, x11, S33, 0x6d9d6122)
+  HH(b, c, d, a, x14, S34, 0xfde5380c)
+  HH(a, b, c, d, x1,  S31, 0xa4beea44)
+  HH(d, a, b, c, x4,  S32, 0x4bdecfa9)
+  HH(c, d, a, b, x7,  S33, 0xf6bb4b60)
+  HH(b, c, d, a, x10, S34, 0xbebfbc70)
+  HH(a, b, c, d, x13, S31, 0x289b7ec6)
+  HH(d, a, b, c, x0,  S32, 0xeaa127fa)
+  HH(c, d, a, b, x3,  S33, 0xd4ef3085)
+  HH(b, c, d, a, x6,  S34, 0x04881d05)
+  HH(a, b, c, d, x9,  S31, 0xd9d4d039)
+  HH(d, a, b, c, x12, S32, 0xe6db99e5)
+  HH(c, d, a, b, x15, S33, 0x1fa27cf8)
+  HH(b, c, d, a, x2,  S34, 0xc4ac5665)
+
+  // Round 4
+  II(a, b, c, d, x0,  S41, 0xf4292244)
+  II(d, a, b, c, x7,  S42, 0x432aff97)
+  II(c, d, a, b, x14, S43, 0xab9423a7)
+  II(b, c, d, a, x5,  S44, 0xfc93a039)
+  II(a, b, c, d, x12, S41, 0x655b59c3)
+  II(d, a, b, c, x3,  S42, 0x8f0ccc92)
+  II(c, d, a, b, x10, S43, 0xffeff47d)
+  II(b, c, d, a, x1,  S44, 0x85845dd1)
+  II(a, b, c, d, x8,  S41, 0x6fa87e4f)
+  II(d, a, b, c, x15, S42, 0xfe2ce6e0)
+  II(c, d, a, b, x6,  S43, 0xa3014314)
+  II(b, c, d, a, x13, S44, 0x4e0811a1)
+  II(a, b, c, d, x4,  S41, 0xf7537e82)
+  II(d, a, b, c, x11, S42, 0xbd3af235)
+  II(c, d, a, b, x2,  S43, 0x2ad7d2bb)
+  II(b, c, d, a, x9,  S44, 0xeb86d391)
+
+  myState[0] += a;
+  myState[1] += b;
+  myState[2] += c;
+  myState[3] += d;
 }
 
+#undef STEP
+#undef FF
+#undef GG
+#undef HH
+#undef II
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 string hash(const ByteBuffer& buffer, size_t length)
 {
@@ -315,28 +249,21 @@ string hash(const ByteBuffer& buffer, size_t length)
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 string hash(const uInt8* buffer, size_t length)
 {
-  char hex[] = "0123456789abcdef";
-  MD5_CTX context;
-  uInt8 md5[16];
-  uInt32 len32 = static_cast<uInt32>(length);  // Always use 32-bit for now
-
-  MD5Init(&context);
-  MD5Update(&context, buffer, len32);
-  MD5Final(md5, &context);
+  Context context;
+  context.update(buffer, length);
 
-  string result;
-  for(int t = 0; t < 16; ++t)
-  {
-    result += hex[(md5[t] >> 4) & 0x0f];
-    result += hex[md5[t] & 0x0f];
-  }
-
-  return result;
+  return context.finalize();
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 string hash(const FilesystemNode& node)
 {
+  // Plain files are hashed in place, others (e.g. in ZIP archives) must
+  // be read into memory first
+  const FileMappingPtr mapping = node.map();
+  if(mapping)
+    return hash(mapping->data(), mapping->size());
+
   ByteBuffer image;
   size_t size = 0;
   try
@@ -348,8 +275,7 @@ string hash(const FilesystemNode& node)
     return EmptyString;
   }
 
-  const string& md5 = hash(image, size);
-  return md5;
+  return hash(image, size);
 }
 
 }  // Namespace MD5
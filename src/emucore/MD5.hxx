@@ -24,15 +24,51 @@ class FilesystemNode;
 
 namespace MD5 {
 
+/**
+  Incremental computation of an MD5 Message-Digest, for messages which
+  aren't available in one piece.  The message is passed in any number of
+  consecutive parts, after which the digest can be retrieved.
+*/
+class Context
+{
+  public:
+    Context() { reset(); }
+
+    /**
+      Start a new message, discarding all data passed so far.
+    */
+    void reset();
+
+    /**
+      Append the given data to the message.
+
+      @param data   The next part of the message
+      @param length The length of this part
+    */
+    void update(const uInt8* data, size_t length);
+
+    /**
+      Get the digest of the message passed so far; afterwards, the context
+      must be reset before it can be used for another message.
+
+      @return The message-digest, consisting of 32 hexadecimal digits
+    */
+    string finalize();
+
+  private:
+    // Process one 64-byte block of the message
+    void transform(const uInt8* block);
+
+  private:
+    std::array<uInt32, 4> myState;
+    std::array<uInt8, 64> myBuffer;  // incomplete block not processed yet
+    uInt64 myLength{0};              // length of the message in bytes
+};
+
 /**
   Get the MD5 Message-Digest of the specified message with the
   given length.  The digest consists of 32 hexadecimal digits.
 
-  Note that currently, the length is truncated internally to
-  32 bits, until the MD5 routines are rewritten for 64-bit.
-  Based on the size of data we currently use, this may never
-  actually happen.
-
   @param buffer The message to compute the digest of
   @param length The length of the message
   @return The message-digest
@@ -44,8 +80,12 @@ string hash(const uInt8* buffer, size_t length);
   Get the MD5 Message-Digest of the file contained in 'node'.
   The digest consists of 32 hexadecimal digits.
 
+  Where possible, the file is hashed directly from a memory mapping,
+  without reading it into a buffer first.
+
   @param node The file node to compute the digest of
-  @return The message-digest
+  @return The message-digest, or the empty string if the file
+          couldn't be read
 */
 string hash(const FilesystemNode& node);
 
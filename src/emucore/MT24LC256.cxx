@@ -17,6 +17,7 @@
 
 #include <cstdio>
 
+#include "Serializer.hxx"
 #include "System.hxx"
 #include "MT24LC256.hxx"
 
@@ -165,6 +166,81 @@ bool MT24LC256::isPageUsed(uInt32 page) const
     return false;
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool MT24LC256::save(Serializer& out) const
+{
+  try
+  {
+    out.putByteArray(myData.get(), FLASH_SIZE);
+    for(bool hit: myPageHit)
+      out.putBool(hit);
+
+    out.putBool(mySDA);
+    out.putBool(mySCL);
+    out.putBool(myTimerActive);
+    out.putLong(myCyclesWhenTimerSet);
+    out.putLong(myCyclesWhenSDASet);
+    out.putLong(myCyclesWhenSCLSet);
+
+    out.putInt(jpee_mdat);
+    out.putInt(jpee_sdat);
+    out.putInt(jpee_mclk);
+    out.putInt(jpee_pptr);
+    out.putInt(jpee_state);
+    out.putInt(jpee_nb);
+    out.putInt(jpee_address);
+    out.putInt(jpee_ad_known);
+    out.putByteArray(jpee_packet.data(), jpee_packet.size());
+  }
+  catch(...)
+  {
+    cerr << "ERROR: MT24LC256::save() exception\n";
+    return false;
+  }
+  return true;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool MT24LC256::load(Serializer& in)
+{
+  try
+  {
+    std::array<uInt8, FLASH_SIZE> data;
+    in.getByteArray(data.data(), FLASH_SIZE);
+    // Only write the data file on exit when the data actually changed
+    if(!std::equal(data.begin(), data.end(), myData.get()))
+    {
+      std::copy_n(data.begin(), FLASH_SIZE, myData.get());
+      myDataChanged = true;
+    }
+    for(auto& hit: myPageHit)
+      hit = in.getBool();
+
+    mySDA = in.getBool();
+    mySCL = in.getBool();
+    myTimerActive = in.getBool();
+    myCyclesWhenTimerSet = in.getLong();
+    myCyclesWhenSDASet = in.getLong();
+    myCyclesWhenSCLSet = in.getLong();
+
+    jpee_mdat = in.getInt();
+    jpee_sdat = in.getInt();
+    jpee_mclk = in.getInt();
+    jpee_pptr = in.getInt();
+    jpee_state = in.getInt();
+    jpee_nb = in.getInt();
+    jpee_address = in.getInt();
+    jpee_ad_known = in.getInt();
+    in.getByteArray(jpee_packet.data(), jpee_packet.size());
+  }
+  catch(...)
+  {
+    cerr << "ERROR: MT24LC256::load() exception\n";
+    return false;
+  }
+  return true;
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void MT24LC256::jpee_init()
 {
@@ -175,6 +251,7 @@ void MT24LC256::jpee_init()
   jpee_pagemask = PAGE_SIZE - 1;
   jpee_smallmode = 0;
   jpee_logmode = -1;
+  jpee_packet.fill(0);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -18,6 +18,7 @@
 #ifndef MT24LC256_HXX
 #define MT24LC256_HXX
 
+class Serializer;
 class System;
 
 #include "Control.hxx"
@@ -73,6 +74,24 @@ class MT24LC256
     /** Returns true if the page is used by the current ROM */
     bool isPageUsed(uInt32 page) const;
 
+    /**
+      Save the current state of the EEPROM, including its data, to the
+      given Serializer.
+
+      @param out  The Serializer object to use
+      @return  False on any errors, else true
+    */
+    bool save(Serializer& out) const;
+
+    /**
+      Load the current state of the EEPROM, including its data, from the
+      given Serializer.
+
+      @param in  The Serializer object to use
+      @return  False on any errors, else true
+    */
+    bool load(Serializer& in);
+
   private:
     // I2C access code provided by Supercat
     void jpee_init();
@@ -54,11 +54,13 @@
 #include "TIAConstants.hxx"
 #include "Settings.hxx"
 #include "PropsSet.hxx"
+#include "RomMetadataCache.hxx"
 #include "EventHandler.hxx"
 #include "PNGLibrary.hxx"
 #include "Console.hxx"
 #include "Random.hxx"
 #include "StateManager.hxx"
+#include "RunAheadManager.hxx"
 #include "TimerManager.hxx"
 #ifdef GUI_SUPPORT
 #include "HighScoresManager.hxx"
@@ -162,6 +164,7 @@ bool OSystem::create()
   myEventHandler->initialize();
 
   myStateManager = make_unique<StateManager>(*this);
+  myRunAheadManager = make_unique<RunAheadManager>(*this);
   myTimerManager = make_unique<TimerManager>();
 
 #ifdef GUI_SUPPORT
@@ -243,6 +246,7 @@ void OSystem::loadConfig(const Settings::Options& options)
 #endif
 
   mySettings->setRepository(createSettingsRepository());
+  myRomCache = make_unique<RomMetadataCache>(createRomCacheRepository());
 
   mySettings->load(options);
 
@@ -596,8 +600,8 @@ unique_ptr<Console> OSystem::openConsole(const FilesystemNode& romfile, string&
 {
   unique_ptr<Console> console;
 
-  // Open the cartridge image and read it in
-  ByteBuffer image;
+  // Open the cartridge image
+  RomImage image;
   size_t size = 0;
   if((image = openROM(romfile, md5, size)) != nullptr)
   {
@@ -695,22 +699,31 @@ void OSystem::closeConsole()
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-ByteBuffer OSystem::openROM(const FilesystemNode& rom, string& md5, size_t& size)
+RomImage OSystem::openROM(const FilesystemNode& rom, string& md5, size_t& size)
 {
   // This method has a documented side-effect:
-  // It not only loads a ROM and creates an array with its contents,
+  // It not only loads a ROM and creates an image of its contents,
   // but also adds a properties entry if the one for the ROM doesn't
   // contain a valid name
 
-  ByteBuffer image;
-  if((size = rom.read(image)) == 0)
+  RomImage image = RomImage::load(rom);
+  if((size = image.size()) == 0)
     return nullptr;
 
   // If we get to this point, we know we have a valid file to open
   // Now we make sure that the file has a valid properties entry
   // To save time, only generate an MD5 if we really need one
   if(md5 == "")
-    md5 = MD5::hash(image, size);
+  {
+    RomMetadataCache::Metadata data;
+    if(myRomCache->get(rom, data) && data.md5 != "")
+      md5 = data.md5;
+    else
+    {
+      md5 = data.md5 = MD5::hash(image.get(), size);
+      myRomCache->put(rom, data);
+    }
+  }
 
   // Make sure to load a per-ROM properties entry, if one exists
   myPropSet->loadPerROM(rom, md5);
@@ -755,7 +768,7 @@ double OSystem::dispatchEmulation(EmulationWorker& emulationWorker)
   // the worker is started to avoid racing.
   if (framePending) {
     myFpsMeter.render(tia.framesSinceLastRender());
-    tia.renderToFrameBuffer();
+    if (!myRunAheadManager->renderFrame()) tia.renderToFrameBuffer();
   }
 
   // Start emulation on a dedicated thread. It will do its own scheduling to sync 6507 and real time
@@ -890,6 +903,20 @@ shared_ptr<KeyValueRepository> OSystem::createSettingsRepository()
   #endif
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+shared_ptr<KeyValueRepository> OSystem::createRomCacheRepository()
+{
+  #ifdef SQLITE_SUPPORT
+    return mySettingsDb
+      ? shared_ptr<KeyValueRepository>(mySettingsDb, &mySettingsDb->romCacheRepository())
+      : make_shared<KeyValueRepositoryNoop>();
+  #else
+    // The config file isn't suited for thousands of entries, so there is
+    // no persistent cache without a database
+    return make_shared<KeyValueRepositoryNoop>();
+  #endif
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 string OSystem::ourOverrideBaseDir = "";
 bool OSystem::ourOverrideBaseDirWithApp = false;
@@ -24,6 +24,8 @@ class EventHandler;
 class Properties;
 class PropertiesSet;
 class Random;
+class RomMetadataCache;
+class RunAheadManager;
 class Sound;
 class StateManager;
 class TimerManager;
@@ -55,6 +57,7 @@ class AudioSettings;
 #include <chrono>
 
 #include "FSNode.hxx"
+#include "RomImage.hxx"
 #include "FrameBufferConstants.hxx"
 #include "EventHandlerConstants.hxx"
 #include "FpsMeter.hxx"
@@ -134,6 +137,13 @@ class OSystem
     */
     PropertiesSet& propSet() const { return *myPropSet; }
 
+    /**
+      Get the cache of ROM information (MD5, autodetected types etc).
+
+      @return The ROM metadata cache object
+    */
+    RomMetadataCache& romCache() const { return *myRomCache; }
+
     /**
       Get the console of the system.  The console won't always exist,
       so we should test if it's available.
@@ -166,6 +176,13 @@ class OSystem
     */
     StateManager& state() const { return *myStateManager; }
 
+    /**
+      Get the run-ahead manager of the system.
+
+      @return The runaheadmanager object
+    */
+    RunAheadManager& runAhead() const { return *myRunAheadManager; }
+
     /**
       Get the timer/callback manager of the system.
 
@@ -325,7 +342,7 @@ class OSystem
     const FilesystemNode& defaultLoadDir() const { return myDefaultLoadDir; }
 
     /**
-      Open the given ROM and return an array containing its contents.
+      Open the given ROM and return an image of its contents.
       Also, the properties database is updated with a valid ROM name
       for this ROM (if necessary).
 
@@ -334,9 +351,9 @@ class OSystem
                     (will be recalculated if necessary)
       @param size   The amount of data read into the image array
 
-      @return  Unique pointer to the array
+      @return  The image of the ROM
     */
-    ByteBuffer openROM(const FilesystemNode& rom, string& md5, size_t& size);
+    RomImage openROM(const FilesystemNode& rom, string& md5, size_t& size);
 
     /**
       Creates a new game console from the specified romfile, and correctly
@@ -449,6 +466,8 @@ class OSystem
 
     virtual shared_ptr<KeyValueRepository> createSettingsRepository();
 
+    virtual shared_ptr<KeyValueRepository> createRomCacheRepository();
+
     //////////////////////////////////////////////////////////////////////
     // The following methods are system-specific and *must* be
     // implemented in derived classes.
@@ -492,6 +511,9 @@ class OSystem
     // Pointer to the PropertiesSet object
     unique_ptr<PropertiesSet> myPropSet;
 
+    // Pointer to the ROM metadata cache
+    unique_ptr<RomMetadataCache> myRomCache;
+
     // Pointer to the (currently defined) Console object
     unique_ptr<Console> myConsole;
 
@@ -536,6 +558,9 @@ class OSystem
     // Pointer to the StateManager object
     unique_ptr<StateManager> myStateManager;
 
+    // Pointer to the RunAheadManager object
+    unique_ptr<RunAheadManager> myRunAheadManager;
+
     // Pointer to the TimerManager object
     unique_ptr<TimerManager> myTimerManager;
 
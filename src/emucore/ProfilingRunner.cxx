@@ -15,8 +15,10 @@
 // this file, and for a DISCLAIMER OF ALL WARRANTIES.
 //============================================================================
 
+#include <atomic>
 #include <chrono>
 #include <cmath>
+#include <thread>
 
 #include "ProfilingRunner.hxx"
 #include "FSNode.hxx"
@@ -33,11 +35,17 @@
 #include "EmulationTiming.hxx"
 #include "ConsoleTiming.hxx"
 #include "System.hxx"
+#include "Serializer.hxx"
 #include "Joystick.hxx"
 #include "Random.hxx"
+#include "Settings.hxx"
+#include "Props.hxx"
 #include "DispatchResult.hxx"
+#include "Version.hxx"
+#include "json_lib.hxx"
 
 using namespace std::chrono;
+using json = nlohmann::json;
 
 namespace {
   static constexpr uInt32 RUNTIME_DEFAULT = 60;
@@ -56,79 +64,220 @@ namespace {
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 ProfilingRunner::ProfilingRunner(int argc, char* argv[])
-  : profilingRuns(std::max(argc - 2, 0))
 {
   for (int i = 2; i < argc; i++) {
-    ProfilingRun& run(profilingRuns[i-2]);
-
     string arg = argv[i];
-    size_t splitPoint = arg.find_first_of(':');
-
-    run.romFile = splitPoint == string::npos ? arg : arg.substr(0, splitPoint);
 
-    if (splitPoint == string::npos) run.runtime = RUNTIME_DEFAULT;
-    else  {
-      int runtime = BSPF::stringToInt(arg.substr(splitPoint+1, string::npos));
-      run.runtime = runtime > 0 ? runtime : RUNTIME_DEFAULT;
+    if (arg == "-breakdown") myBreakdown = true;
+    else if (arg == "-frames" || arg == "-manifest" || arg == "-json" || arg == "-threads" ||
+             arg == "-states" || arg == "-thumbcache") {
+      if (++i == argc) {
+        cout << "ERROR: missing value for " << arg << endl;
+        myArgumentsValid = false;
+        break;
+      }
+
+      if (arg == "-frames") myFrames = std::max(BSPF::stringToInt(argv[i]), 0);
+      else if (arg == "-threads") myThreads = std::max(BSPF::stringToInt(argv[i]), 0);
+      else if (arg == "-states") myStates = std::max(BSPF::stringToInt(argv[i]), 0);
+      else if (arg == "-thumbcache") myThumbCache = BSPF::stringToInt(argv[i]) != 0;
+      else if (arg == "-json") myJsonFile = argv[i];
+      else if (!addManifest(argv[i])) myArgumentsValid = false;
     }
+    else addRun(arg);
+  }
+
+  // A fixed frame count overrides the runtime given for the individual ROMs
+  if (myFrames > 0)
+    for (ProfilingRun& run : profilingRuns) run.frames = myFrames;
+
+  // '-threads 0' uses all available cores
+  if (myThreads == 0) myThreads = std::max(std::thread::hardware_concurrency(), 1u);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void ProfilingRunner::addRun(const string& spec)
+{
+  ProfilingRun run;
+  size_t splitPoint = spec.find_first_of(':');
+
+  run.romFile = splitPoint == string::npos ? spec : spec.substr(0, splitPoint);
+
+  if (splitPoint == string::npos) run.runtime = RUNTIME_DEFAULT;
+  else  {
+    int runtime = BSPF::stringToInt(spec.substr(splitPoint+1, string::npos));
+    run.runtime = runtime > 0 ? runtime : RUNTIME_DEFAULT;
   }
 
-  mySettings.setValue("fastscbios", true);
+  profilingRuns.push_back(run);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool ProfilingRunner::addManifest(const string& manifest)
+{
+  FilesystemNode manifestFile(manifest);
+  stringstream in;
+
+  try {
+    if (!manifestFile.isFile() || manifestFile.read(in) == 0) throw runtime_error("");
+  }
+  catch (...) {
+    cout << "ERROR: unable to read manifest " << manifest << endl;
+    return false;
+  }
+
+  string line;
+  while (getline(in, line)) {
+    const size_t first = line.find_first_not_of(" \t\r");
+    if (first == string::npos || line[first] == '#') continue;
+
+    addRun(line.substr(first, line.find_last_not_of(" \t\r") - first + 1));
+  }
+
+  return true;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 bool ProfilingRunner::run()
 {
+  if (!myArgumentsValid) return false;
+
   cout << "Profiling Stella..." << endl;
 
-  for (ProfilingRun& run : profilingRuns) {
-    cout << endl << "running " << run.romFile << " for " << run.runtime << " seconds..." << endl;
+  vector<ProfilingResult> results(profilingRuns.size());
 
-    if (!runOne(run)) return false;
+  if (myThreads > 1 && profilingRuns.size() > 1) {
+    if (!runParallel(results)) return false;
   }
+  else
+    for (size_t i = 0; i < profilingRuns.size(); ++i) {
+      const ProfilingRun& run = profilingRuns[i];
 
-  return true;
+      cout << endl << "running " << run.romFile << " for " << describeRun(run) << "..." << endl;
+
+      if (!runOne(run, results[i], cout, true)) return false;
+
+      printResult(results[i], cout);
+    }
+
+  return myJsonFile.empty() || writeJson(results);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool ProfilingRunner::runParallel(vector<ProfilingResult>& results)
+{
+  const size_t numWorkers = std::min(size_t(myThreads), profilingRuns.size());
+
+  cout << endl << "running " << profilingRuns.size() << " ROMs on "
+       << numWorkers << " threads..." << endl;
+
+  // Every worker picks the next pending run and emulates it on a console of
+  // its own; the output of each run is buffered and printed in order once
+  // all workers have finished
+  vector<stringstream> logs(profilingRuns.size());
+  unique_ptr<bool[]> succeeded = make_unique<bool[]>(profilingRuns.size());
+  std::atomic<size_t> nextRun(0);
+
+  auto worker = [&]() {
+    size_t i;
+    while ((i = nextRun++) < profilingRuns.size()) {
+      const ProfilingRun& run = profilingRuns[i];
+
+      logs[i] << endl << "running " << run.romFile << " for " << describeRun(run) << "..." << endl;
+
+      try {
+        succeeded[i] = runOne(run, results[i], logs[i], false);
+      }
+      catch (const runtime_error& e) {
+        logs[i] << "ERROR: " << e.what() << endl;
+        succeeded[i] = false;
+      }
+
+      if (succeeded[i]) printResult(results[i], logs[i]);
+    }
+  };
+
+  time_point<high_resolution_clock> tp = high_resolution_clock::now();
+
+  vector<std::thread> workers;
+  for (size_t i = 0; i < numWorkers; ++i) workers.emplace_back(worker);
+  for (std::thread& t : workers) t.join();
+
+  double realtimeUsed = duration_cast<duration<double>>(high_resolution_clock::now () - tp).count();
+
+  bool ok = true;
+  for (size_t i = 0; i < profilingRuns.size(); ++i) {
+    cout << logs[i].str();
+    ok = ok && succeeded[i];
+  }
+
+  cout << endl << "total real time: " << realtimeUsed << " seconds" << endl;
+
+  return ok;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool ProfilingRunner::runOne(const ProfilingRun& run)
+string ProfilingRunner::describeRun(const ProfilingRun& run)
+{
+  ostringstream buf;
+
+  if (run.frames > 0) buf << run.frames << " frames";
+  else buf << run.runtime << " seconds";
+
+  return buf.str();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool ProfilingRunner::runOne(const ProfilingRun& run, ProfilingResult& result,
+                             ostream& out, bool showProgress)
 {
   FilesystemNode imageFile(run.romFile);
 
   if (!imageFile.isFile()) {
-    cout << "ERROR: " << run.romFile << " is not a ROM image" << endl;
+    out << "ERROR: " << run.romFile << " is not a ROM image" << endl;
     return false;
   }
 
-  ByteBuffer image;
-  size_t size = imageFile.read(image);
+  RomImage image = RomImage::load(imageFile);
+  size_t size = image.size();
   if (size == 0) {
-    cout << "ERROR: unable to read " << run.romFile << endl;
+    out << "ERROR: unable to read " << run.romFile << endl;
     return false;
   }
 
-  string md5 = MD5::hash(image, size);
+  // Settings and properties are private to each run, so that consoles
+  // running concurrently never share any mutable state
+  Settings settings;
+  Properties props;
+  settings.setValue("fastscbios", true);
+  settings.setValue("thumbcache", myThumbCache);
+
+  string md5 = MD5::hash(image.get(), size);
   string type = "";
   unique_ptr<Cartridge> cartridge = CartCreator::create(
-      imageFile, image, size, md5, type, mySettings);
+      imageFile, image, size, md5, type, settings);
 
   if (!cartridge) {
-    cout << "ERROR: unable to determine cartridge type" << endl;
+    out << "ERROR: unable to determine cartridge type" << endl;
     return false;
   }
 
+  result.romFile = run.romFile;
+  result.md5 = md5;
+  result.type = cartridge->detectedType();
+
   IO consoleIO;
   Random rng(0);
   Event event;
 
-  M6502 cpu(mySettings);
-  M6532 riot(consoleIO, mySettings);
-  TIA tia(consoleIO, []() { return ConsoleTiming::ntsc; }, mySettings);
+  M6502 cpu(settings);
+  M6532 riot(consoleIO, settings);
+  TIA tia(consoleIO, []() { return ConsoleTiming::ntsc; }, settings);
   System system(rng, cpu, riot, tia, *cartridge);
 
   consoleIO.myLeftControl = make_unique<Joystick>(Controller::Jack::Left, event, system);
   consoleIO.myRightControl = make_unique<Joystick>(Controller::Jack::Right, event, system);
-  consoleIO.mySwitches = make_unique<Switches>(event, myProps, mySettings);
+  consoleIO.mySwitches = make_unique<Switches>(event, props, settings);
 
   tia.bindToControllers();
   cartridge->setStartBankFromPropsFunc([]() { return -1; });
@@ -138,7 +287,7 @@ bool ProfilingRunner::runOne(const ProfilingRun& run)
   tia.setFrameManager(&frameLayoutDetector);
   system.reset();
 
-  (cout << "detecting frame layout... ").flush();
+  (out << "detecting frame layout... ").flush();
   for(int i = 0; i < 60; ++i) tia.update();
 
   FrameLayout frameLayout = frameLayoutDetector.detectedLayout();
@@ -146,17 +295,17 @@ bool ProfilingRunner::runOne(const ProfilingRun& run)
 
   switch (frameLayout) {
     case FrameLayout::ntsc:
-      cout << "NTSC";
+      result.layout = "NTSC";
       consoleTiming = ConsoleTiming::ntsc;
       break;
 
     case FrameLayout::pal:
-      cout << "PAL";
+      result.layout = "PAL";
       consoleTiming = ConsoleTiming::pal;
       break;
   }
 
-  (cout << endl).flush();
+  (out << result.layout << endl).flush();
 
   FrameManager frameManager;
   tia.setFrameManager(&frameManager);
@@ -164,39 +313,183 @@ bool ProfilingRunner::runOne(const ProfilingRun& run)
 
   system.reset();
 
+  SubsystemTimer subsystemTimer;
+  if (myBreakdown) system.setSubsystemTimer(&subsystemTimer);
+
   EmulationTiming emulationTiming(frameLayout, consoleTiming);
-  uInt64 cycles = 0;
+  uInt64 cycles = 0, frames = 0;
   uInt64 cyclesTarget = uInt64(run.runtime) * emulationTiming.cyclesPerSecond();
 
   DispatchResult dispatchResult;
   dispatchResult.setOk(0);
 
   uInt32 percent = 0;
-  (cout << "0%").flush();
+  if (showProgress) (cout << "0%").flush();
 
   time_point<high_resolution_clock> tp = high_resolution_clock::now();
+  subsystemTimer.start();
 
-  while (cycles < cyclesTarget && dispatchResult.getStatus() == DispatchResult::Status::ok) {
+  while (
+    (run.frames > 0 ? frames < run.frames : cycles < cyclesTarget) &&
+    dispatchResult.getStatus() == DispatchResult::Status::ok
+  ) {
     tia.update(dispatchResult);
     cycles += dispatchResult.getCycles();
 
-    if (tia.newFramePending()) tia.renderToFrameBuffer();
+    if (tia.newFramePending()) {
+      frames += tia.framesSinceLastRender();
+      tia.renderToFrameBuffer();
+    }
 
-    uInt32 percentNow = uInt32(std::min((100 * cycles) / cyclesTarget, static_cast<uInt64>(100)));
+    if (!showProgress) continue;
+
+    uInt32 percentNow = run.frames > 0
+      ? uInt32(std::min((100 * frames) / run.frames, static_cast<uInt64>(100)))
+      : uInt32(std::min((100 * cycles) / cyclesTarget, static_cast<uInt64>(100)));
     updateProgress(percent, percentNow);
 
     percent = percentNow;
   }
 
+  subsystemTimer.stop();
   double realtimeUsed = duration_cast<duration<double>>(high_resolution_clock::now () - tp).count();
 
+  system.setSubsystemTimer(nullptr);
+
   if (dispatchResult.getStatus() != DispatchResult::Status::ok) {
-    cout << endl << "ERROR: emulation failed after " << cycles << " cycles";
+    out << endl << "ERROR: emulation failed after " << cycles << " cycles" << endl;
+    return false;
+  }
+
+  if (showProgress) (cout << "100%" << endl).flush();
+
+  result.frames = frames;
+  result.cycles = cycles;
+  result.realtime = realtimeUsed;
+
+  if (myBreakdown)
+    for (uInt32 i = 0; i < SubsystemTimer::NUM_SUBSYSTEMS; ++i)
+      result.subsystemTime[i] = subsystemTimer.seconds(SubsystemTimer::Subsystem(i));
+
+  return myStates == 0 || benchmarkStates(system, result, out);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool ProfilingRunner::benchmarkStates(System& system, ProfilingResult& result,
+                                      ostream& out) const
+{
+  Serializer state;
+
+  // The first save grows the buffer to its final size
+  if (!system.save(state)) {
+    out << "ERROR: unable to save state" << endl;
     return false;
   }
+  result.stateSize = state.size();
 
-  (cout << "100%" << endl).flush();
-  cout << "real time: " << realtimeUsed << " seconds" << endl;
+  time_point<high_resolution_clock> tp = high_resolution_clock::now();
+  for (uInt32 i = 0; i < myStates; ++i) {
+    state.rewind();
+    system.save(state);
+  }
+  result.stateSaveTime = duration_cast<duration<double>>(high_resolution_clock::now() - tp).count() / myStates;
+
+  tp = high_resolution_clock::now();
+  for (uInt32 i = 0; i < myStates; ++i) {
+    state.rewind();
+    if (!system.load(state)) {
+      out << "ERROR: unable to load state" << endl;
+      return false;
+    }
+  }
+  result.stateLoadTime = duration_cast<duration<double>>(high_resolution_clock::now() - tp).count() / myStates;
 
   return true;
 }
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void ProfilingRunner::printResult(const ProfilingResult& result, ostream& out) const
+{
+  const double realtime = std::max(result.realtime, 1e-9);
+
+  out << "real time: " << result.realtime << " seconds" << endl;
+  out << "frames: " << result.frames << " (" << (result.frames / realtime)
+       << " frames/sec)" << endl;
+  out << "cycles: " << result.cycles << " (" << (result.cycles / realtime)
+       << " cycles/sec)" << endl;
+
+  if (myStates > 0)
+    out << "state: " << result.stateSize << " bytes, save "
+        << (result.stateSaveTime * 1e6) << " us, load "
+        << (result.stateLoadTime * 1e6) << " us" << endl;
+
+  if (!myBreakdown) return;
+
+  for (uInt32 i = 0; i < SubsystemTimer::NUM_SUBSYSTEMS; ++i)
+    out << "  " << std::left << std::setw(12)
+         << SubsystemTimer::name(SubsystemTimer::Subsystem(i))
+         << std::right << std::setw(10) << result.subsystemTime[i] << " seconds ("
+         << std::setw(5) << std::fixed << std::setprecision(1)
+         << (100 * result.subsystemTime[i] / realtime) << "%)"
+         << std::defaultfloat << std::setprecision(6) << endl;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool ProfilingRunner::writeJson(const vector<ProfilingResult>& results) const
+{
+  json runs = json::array();
+
+  for (const ProfilingResult& result : results) {
+    const double realtime = std::max(result.realtime, 1e-9);
+
+    json run = {
+      {"rom", result.romFile},
+      {"md5", result.md5},
+      {"type", result.type},
+      {"layout", result.layout},
+      {"frames", result.frames},
+      {"cycles", result.cycles},
+      {"seconds", result.realtime},
+      {"framesPerSecond", result.frames / realtime},
+      {"cyclesPerSecond", result.cycles / realtime}
+    };
+
+    if (myBreakdown) {
+      json breakdown = json::object();
+
+      for (uInt32 i = 0; i < SubsystemTimer::NUM_SUBSYSTEMS; ++i)
+        breakdown[SubsystemTimer::name(SubsystemTimer::Subsystem(i))] = result.subsystemTime[i];
+
+      run["breakdown"] = breakdown;
+    }
+
+    if (myStates > 0)
+      run["state"] = {
+        {"size", result.stateSize},
+        {"saveSeconds", result.stateSaveTime},
+        {"loadSeconds", result.stateLoadTime}
+      };
+
+    runs.push_back(run);
+  }
+
+  json root = {
+    {"version", STELLA_VERSION},
+    {"breakdown", myBreakdown},
+    {"runs", runs}
+  };
+
+  stringstream out;
+  out << root.dump(2) << endl;
+
+  try {
+    if (FilesystemNode(myJsonFile).write(out) > 0) {
+      cout << endl << "results written to " << myJsonFile << endl;
+      return true;
+    }
+  }
+  catch (...) { }
+
+  cout << "ERROR: unable to write " << myJsonFile << endl;
+  return false;
+}
@@ -21,10 +21,39 @@
 #include "bspf.hxx"
 #include "Control.hxx"
 #include "Switches.hxx"
-#include "Settings.hxx"
 #include "ConsoleIO.hxx"
-#include "Props.hxx"
+#include "SubsystemTimer.hxx"
 
+class System;
+
+/**
+  Headless benchmark runner, invoked as
+
+    stella -profile [-frames <n>] [-manifest <file>] [-json <file>]
+                    [-breakdown] [-threads <n>] [-states <n>]
+                    [-thumbcache <1|0>] [rom[:seconds]] ...
+
+  Each ROM is emulated without any frontend for the given number of seconds
+  of emulated time (or for a fixed number of frames if '-frames' is given).
+  A manifest is a text file listing one 'rom[:seconds]' entry per line;
+  empty lines and lines starting with '#' are ignored.
+
+  '-breakdown' additionally times the individual parts of the emulation
+  core (CPU, TIA, RIOT, cartridge and ARM).  This adds some overhead, so the
+  absolute numbers of such a run should not be compared against a run
+  without it.  '-json' writes all results to the given file.
+
+  '-threads' distributes the ROMs over a pool of worker threads (0 uses
+  all cores).  Every run creates its own console, settings and properties,
+  so no mutable state is shared between the workers.
+
+  '-states' measures the average time to save and load the complete system
+  state to/from memory, repeating both the given number of times after the
+  emulation has finished.
+
+  '-thumbcache 0' runs the ARM code of BUS, CDF and DPC+ cartridges without
+  the block cache, in order to compare against the plain interpreter.
+*/
 class ProfilingRunner {
   public:
 
@@ -36,7 +65,22 @@ class ProfilingRunner {
 
     struct ProfilingRun {
       string romFile;
-      uInt32 runtime;
+      uInt32 runtime{0};
+      uInt32 frames{0};
+    };
+
+    struct ProfilingResult {
+      string romFile;
+      string md5;
+      string type;
+      string layout;
+      uInt64 frames{0};
+      uInt64 cycles{0};
+      double realtime{0.0};
+      std::array<double, SubsystemTimer::NUM_SUBSYSTEMS> subsystemTime{};
+      size_t stateSize{0};
+      double stateSaveTime{0.0};
+      double stateLoadTime{0.0};
     };
 
     struct IO: public ConsoleIO {
@@ -51,15 +95,34 @@ class ProfilingRunner {
 
   private:
 
-    bool runOne(const ProfilingRun& run);
+    void addRun(const string& spec);
+
+    bool addManifest(const string& manifest);
+
+    bool runOne(const ProfilingRun& run, ProfilingResult& result,
+                ostream& out, bool showProgress);
+
+    bool runParallel(vector<ProfilingResult>& results);
+
+    bool benchmarkStates(System& system, ProfilingResult& result, ostream& out) const;
+
+    void printResult(const ProfilingResult& result, ostream& out) const;
+
+    static string describeRun(const ProfilingRun& run);
+
+    bool writeJson(const vector<ProfilingResult>& results) const;
 
   private:
 
     vector<ProfilingRun> profilingRuns;
 
-    Settings mySettings;
-
-    Properties myProps;
+    uInt32 myFrames{0};
+    uInt32 myThreads{1};
+    uInt32 myStates{0};
+    bool myBreakdown{false};
+    bool myThumbCache{true};
+    string myJsonFile;
+    bool myArgumentsValid{true};
 };
 
 #endif // PROFILING_RUNNER
@@ -0,0 +1,125 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2020 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+#include "FSNode.hxx"
+#include "RomImage.hxx"
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+RomImage::RomImage(ByteBuffer&& buffer, size_t size)
+  : myOwner(shared_ptr<uInt8[]>(buffer.release())),
+    myData(static_cast<const uInt8*>(myOwner.get())),
+    mySize(size)
+{
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+RomImage::RomImage(const FileMappingPtr& mapping)
+  : myOwner(mapping),
+    myData(mapping ? mapping->data() : nullptr),
+    mySize(mapping ? mapping->size() : 0)
+{
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+RomImage::RomImage(size_t size)
+  : RomImage(make_unique<uInt8[]>(size), size)
+{
+  std::fill_n(const_cast<uInt8*>(myData), mySize, 0);
+  myPrivate = true;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+RomImage::RomImage(const RomImage& other)
+  : myOwner(other.myOwner),
+    myData(other.myData),
+    mySize(other.mySize)
+{
+  if(other.myPrivate)
+    makePrivate();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+RomImage::RomImage(RomImage&& other) noexcept
+  : myOwner(std::move(other.myOwner)),
+    myData(std::exchange(other.myData, nullptr)),
+    mySize(std::exchange(other.mySize, 0)),
+    myPrivate(std::exchange(other.myPrivate, false))
+{
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+RomImage& RomImage::operator=(const RomImage& other)
+{
+  if(this != &other)
+  {
+    myOwner = other.myOwner;
+    myData = other.myData;
+    mySize = other.mySize;
+    myPrivate = false;
+    if(other.myPrivate)
+      makePrivate();
+  }
+  return *this;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+RomImage& RomImage::operator=(RomImage&& other) noexcept
+{
+  myOwner = std::move(other.myOwner);
+  myData = std::exchange(other.myData, nullptr);
+  mySize = std::exchange(other.mySize, 0);
+  myPrivate = std::exchange(other.myPrivate, false);
+
+  return *this;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+RomImage RomImage::load(const FilesystemNode& node)
+{
+  ByteBuffer buffer;
+  const size_t size = node.read(buffer);
+
+  return RomImage(std::move(buffer), size);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+RomImage RomImage::map(const FilesystemNode& node)
+{
+  const FileMappingPtr mapping = node.map();
+
+  return mapping ? RomImage(mapping) : load(node);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+uInt8* RomImage::modify()
+{
+  if(!myPrivate)
+    makePrivate();
+
+  return const_cast<uInt8*>(myData);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void RomImage::makePrivate()
+{
+  ByteBuffer copy = make_unique<uInt8[]>(mySize);
+  std::copy_n(myData, mySize, copy.get());
+
+  myOwner = shared_ptr<uInt8[]>(copy.release());
+  myData = static_cast<const uInt8*>(myOwner.get());
+  myPrivate = true;
+}
@@ -0,0 +1,128 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2020 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+#ifndef ROM_IMAGE_HXX
+#define ROM_IMAGE_HXX
+
+class FilesystemNode;
+class FileMapping;
+
+#include "bspf.hxx"
+
+/**
+  The contents of a ROM file, as used by the cart detection and the
+  cartridges.
+
+  An image loaded from a file is read-only, and shared by all its copies;
+  the data is either a buffer or a memory mapping of the file.  This way,
+  a cartridge can reference the image it was created from instead of
+  copying it, and several consoles running the same ROM (e.g. the
+  run-ahead instance) use the same memory.
+
+  A cartridge which changes its image (e.g. when patching ROM) gets a
+  private copy on the first call to modify().  Private images are copied
+  completely when the image itself is copied, so pointers into them stay
+  valid until the image is destroyed.
+
+  Copies of a shared image may be used from different threads.
+*/
+class RomImage
+{
+  public:
+    RomImage() = default;
+    RomImage(std::nullptr_t) { }  // NOLINT: allows 'image = nullptr'
+
+    /**
+      Create a shared image from a buffer, taking ownership of it.
+
+      @param buffer  The buffer containing the data
+      @param size    The size of the data
+    */
+    RomImage(ByteBuffer&& buffer, size_t size);
+
+    /**
+      Create a shared image referencing a file mapping.
+    */
+    explicit RomImage(const shared_ptr<const FileMapping>& mapping);
+
+    /**
+      Create a private, zero-filled image of the given size.
+    */
+    explicit RomImage(size_t size);
+
+    RomImage(const RomImage& other);
+    RomImage(RomImage&& other) noexcept;
+    RomImage& operator=(const RomImage& other);
+    RomImage& operator=(RomImage&& other) noexcept;
+    ~RomImage() = default;
+
+    /**
+      Read the given file into a shared buffer.
+
+      @param node  The file to load
+
+      @return  The image; this method can throw exceptions (see
+               FilesystemNode::read())
+    */
+    static RomImage load(const FilesystemNode& node);
+
+    /**
+      Map the given file into memory, or read it if that isn't possible.
+      This avoids any copying, but the image must only be used briefly
+      (e.g. for hashing and autodetection): a mapped file which is
+      truncated (e.g. rebuilt by an assembler) can't be accessed anymore,
+      and on some systems mapped files can't be written.
+
+      @param node  The file to map
+
+      @return  The image; this method can throw exceptions (see
+               FilesystemNode::read())
+    */
+    static RomImage map(const FilesystemNode& node);
+
+    const uInt8* get() const { return myData; }
+    size_t size() const { return mySize; }
+
+    const uInt8& operator[](size_t i) const { return myData[i]; }
+
+    explicit operator bool() const { return myData != nullptr; }
+    bool operator==(std::nullptr_t) const { return myData == nullptr; }
+    bool operator!=(std::nullptr_t) const { return myData != nullptr; }
+
+    /**
+      Get write access to the data.  A shared image is turned into a
+      private copy first, so the pointer may differ from get() before
+      the call.
+    */
+    uInt8* modify();
+
+  private:
+    // Replace the data by a private copy
+    void makePrivate();
+
+  private:
+    // Keeps the data alive; either a buffer or a file mapping
+    shared_ptr<const void> myOwner;
+
+    const uInt8* myData{nullptr};
+    size_t mySize{0};
+
+    // The data belongs to this image alone, and may be changed
+    bool myPrivate{false};
+};
+
+#endif
@@ -0,0 +1,166 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2020 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+#include "FSNode.hxx"
+#include "MD5.hxx"
+#include "repository/KeyValueRepository.hxx"
+
+#include "RomMetadataCache.hxx"
+
+namespace {
+  // Bump this whenever the meaning of the stored values changes (e.g. an
+  // improved autodetection), so that outdated entries are ignored
+  constexpr uInt32 VERSION = 2;
+  constexpr char SEPARATOR = '|';
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+RomMetadataCache::RomMetadataCache(shared_ptr<KeyValueRepository> repository)
+  : myRepository(repository)
+{
+  for(const auto& [path, value]: myRepository->load())
+  {
+    Entry entry;
+    if(fromString(value.toString(), entry))
+      myEntries[path] = std::move(entry);
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool RomMetadataCache::get(const FilesystemNode& rom, Metadata& data) const
+{
+  size_t size = 0;
+  uInt64 mtime = 0;
+  if(!rom.getSizeAndTime(size, mtime))
+    return false;
+
+  std::lock_guard<std::mutex> lock(myMutex);
+
+  const auto iter = myEntries.find(rom.getPath());
+  if(iter == myEntries.end() ||
+     iter->second.size != size || iter->second.mtime != mtime)
+    return false;
+
+  data = iter->second.data;
+  return true;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void RomMetadataCache::put(const FilesystemNode& rom, const Metadata& data)
+{
+  Entry entry;
+  if(!rom.getSizeAndTime(entry.size, entry.mtime))
+    return;
+
+  entry.data = data;
+  myRepository->save(rom.getPath(), toString(entry));
+
+  std::lock_guard<std::mutex> lock(myMutex);
+  myEntries[rom.getPath()] = std::move(entry);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void RomMetadataCache::put(const vector<std::pair<FilesystemNode, Metadata>>& entries)
+{
+  std::map<string, Entry> updated;
+  std::map<string, Variant> values;
+
+  for(const auto& [rom, data]: entries)
+  {
+    Entry entry;
+    if(!rom.getSizeAndTime(entry.size, entry.mtime))
+      continue;
+
+    entry.data = data;
+    values[rom.getPath()] = toString(entry);
+    updated[rom.getPath()] = std::move(entry);
+  }
+  if(updated.empty())
+    return;
+
+  // The repository writes all values in a single transaction
+  myRepository->save(values);
+
+  std::lock_guard<std::mutex> lock(myMutex);
+  for(auto& [path, entry]: updated)
+    myEntries[path] = std::move(entry);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+string RomMetadataCache::md5(const FilesystemNode& rom)
+{
+  Metadata data;
+  if(get(rom, data) && data.md5 != "")
+    return data.md5;
+
+  data.md5 = MD5::hash(rom);
+  if(data.md5 != "")
+    put(rom, data);
+
+  return data.md5;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+string RomMetadataCache::toString(const Entry& entry)
+{
+  ostringstream buf;
+  buf << VERSION << SEPARATOR << entry.size << SEPARATOR << entry.mtime
+      << SEPARATOR << entry.data.md5
+      << SEPARATOR << entry.data.bsType
+      << SEPARATOR << entry.data.leftController
+      << SEPARATOR << entry.data.rightController
+      << SEPARATOR << entry.data.displayFormat
+      << SEPARATOR << entry.data.displayFormatKey;
+
+  return buf.str();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool RomMetadataCache::fromString(const string& value, Entry& entry)
+{
+  std::vector<string> fields;
+  string::size_type pos = 0;
+  for(;;)
+  {
+    const string::size_type sep = value.find(SEPARATOR, pos);
+    fields.push_back(value.substr(pos, sep - pos));
+    if(sep == string::npos)
+      break;
+    pos = sep + 1;
+  }
+
+  if(fields.size() != 9 || BSPF::stringToInt(fields[0]) != int(VERSION))
+    return false;
+
+  try
+  {
+    entry.size = std::stoull(fields[1]);
+    entry.mtime = std::stoull(fields[2]);
+  }
+  catch(const std::exception&)
+  {
+    return false;
+  }
+  entry.data.md5              = fields[3];
+  entry.data.bsType           = fields[4];
+  entry.data.leftController   = fields[5];
+  entry.data.rightController  = fields[6];
+  entry.data.displayFormat    = fields[7];
+  entry.data.displayFormatKey = fields[8];
+
+  return true;
+}
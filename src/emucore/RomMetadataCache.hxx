@@ -0,0 +1,141 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2020 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+#ifndef ROM_METADATA_CACHE_HXX
+#define ROM_METADATA_CACHE_HXX
+
+#include <map>
+#include <mutex>
+
+#include "bspf.hxx"
+
+class FilesystemNode;
+class KeyValueRepository;
+
+/**
+  This class remembers information about ROM files which is expensive to
+  determine (the MD5 and the autodetected bankswitch type, controllers and
+  display format), so that it doesn't have to be recalculated each time a
+  ROM is selected in the launcher or started.
+
+  The entries are persisted in a key/value repository, keyed by the full
+  path of the ROM.  Each entry also records the size and modification time
+  (at the finest resolution the platform offers) of the file, and is
+  ignored once the file has changed.  Files for which
+  this information isn't available (e.g. inside ZIP archives) are never
+  cached.
+
+  The lookups are thread-safe, so background threads can use the cache
+  while the main thread adds entries.
+*/
+class RomMetadataCache
+{
+  public:
+    /**
+      The cached information; an empty string means 'not determined yet'.
+      The controllers are the autodetected ones for the left and right
+      jacks, independent of any properties (e.g. swapped ports).  The
+      display format however is detected by running the emulation, so it
+      depends on the (possibly overridden) properties it ran with, which
+      'displayFormatKey' describes.
+    */
+    struct Metadata
+    {
+      string md5;
+      string bsType;
+      string leftController;
+      string rightController;
+      string displayFormat;
+      string displayFormatKey;
+    };
+
+  public:
+    explicit RomMetadataCache(shared_ptr<KeyValueRepository> repository);
+    ~RomMetadataCache() = default;
+
+  public:
+    /**
+      Get the cached information for the given ROM file.
+
+      @param rom   The ROM file
+      @param data  Receives the cached information
+
+      @return  False if the file isn't cached or has changed since it was
+               cached (in which case 'data' isn't changed)
+    */
+    bool get(const FilesystemNode& rom, Metadata& data) const;
+
+    /**
+      Store information for the given ROM file, replacing any previous entry.
+      Nothing is stored if the file size and modification time can't be
+      determined.  Only the main thread may store entries.
+
+      @param rom   The ROM file
+      @param data  The information to store
+    */
+    void put(const FilesystemNode& rom, const Metadata& data);
+
+    /**
+      Store information for several ROM files at once, which is much faster
+      than storing them one by one.
+
+      @param entries  The ROM files and the information to store
+    */
+    void put(const vector<std::pair<FilesystemNode, Metadata>>& entries);
+
+    /**
+      Get the MD5 of the given ROM file, calculating and caching it when
+      necessary.
+
+      @param rom  The ROM file
+
+      @return  The MD5, or the empty string if the file couldn't be read
+    */
+    string md5(const FilesystemNode& rom);
+
+  private:
+    struct Entry
+    {
+      size_t size{0};
+      uInt64 mtime{0};
+      Metadata data;
+    };
+
+    // Convert between an entry and its representation in the repository
+    static string toString(const Entry& entry);
+    static bool fromString(const string& value, Entry& entry);
+
+  private:
+    // The repository the entries are persisted in
+    shared_ptr<KeyValueRepository> myRepository;
+
+    // All entries, indexed by the full path of the ROM
+    std::map<string, Entry> myEntries;
+
+    // Protects the entries
+    mutable std::mutex myMutex;
+
+  private:
+    // Following constructors and assignment operators not supported
+    RomMetadataCache() = delete;
+    RomMetadataCache(const RomMetadataCache&) = delete;
+    RomMetadataCache(RomMetadataCache&&) = delete;
+    RomMetadataCache& operator=(const RomMetadataCache&) = delete;
+    RomMetadataCache& operator=(RomMetadataCache&&) = delete;
+};
+
+#endif
@@ -98,6 +98,18 @@ void SaveKey::close()
   myEEPROM.reset();
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool SaveKey::save(Serializer& out) const
+{
+  return Controller::save(out) && (!myEEPROM || myEEPROM->save(out));
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool SaveKey::load(Serializer& in)
+{
+  return Controller::load(in) && (!myEEPROM || myEEPROM->load(in));
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void SaveKey::eraseAll()
 {
@@ -102,6 +102,24 @@ class SaveKey : public Controller
     */
     void close() override;
 
+    /**
+      Saves the current state of this controller, including the EEPROM,
+      to the given Serializer.
+
+      @param out The serializer device to save to.
+      @return The result of the save.  True on success, false on failure.
+    */
+    bool save(Serializer& out) const override;
+
+    /**
+      Loads the current state of this controller, including the EEPROM,
+      from the given Serializer.
+
+      @param in The serializer device to load from.
+      @return The result of the load.  True on success, false on failure.
+    */
+    bool load(Serializer& in) override;
+
     /** Erase entire EEPROM to known state ($FF) */
     void eraseAll();
 
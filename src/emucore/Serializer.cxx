@@ -15,6 +15,8 @@
 // this file, and for a DISCLAIMER OF ALL WARRANTIES.
 //============================================================================
 
+#include <cstring>
+
 #include "FSNode.hxx"
 #include "Serializer.hxx"
 
@@ -66,41 +68,82 @@ Serializer::Serializer(const string& filename, Mode m)
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 Serializer::Serializer()
-  : myStream(nullptr)
+  : myStream(nullptr),
+    myBuffer(allocate(INITIAL_CAPACITY)),
+    myCapacity(INITIAL_CAPACITY)
 {
-  myStream = make_unique<stringstream>(ios::in | ios::out | ios::binary);
+}
 
-  // For some reason, Windows and possibly macOS needs to store something in
-  // the stream before it is used for the first time
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void Serializer::rewind()
+{
   if(myStream)
   {
-    myStream->exceptions( ios_base::failbit | ios_base::badbit | ios_base::eofbit );
-    putBool(true);
-    rewind();
+    myStream->clear();
+    myStream->seekg(ios_base::beg);
+    myStream->seekp(ios_base::beg);
   }
+  else
+    myReadPos = myWritePos = 0;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-void Serializer::rewind()
+size_t Serializer::size() const
 {
-  myStream->clear();
-  myStream->seekg(ios_base::beg);
-  myStream->seekp(ios_base::beg);
+  if(myStream)
+  {
+    myStream->seekp(0, std::ios::end);
+
+    return myStream->tellp();
+  }
+  // Like for file streams, this moves the write pointer to the end
+  myWritePos = mySize;
+
+  return mySize;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-size_t Serializer::size() const
+void Serializer::read(void* data, size_t size) const
+{
+  if(myStream)
+    myStream->read(static_cast<char*>(data), size);
+  else
+  {
+    if(size > mySize - myReadPos)
+      throw runtime_error("Serializer: read beyond end of data");
+
+    std::memcpy(data, myBuffer.get() + myReadPos, size);
+    myReadPos += size;
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void Serializer::write(const void* data, size_t size)
 {
-  myStream->seekp(0, std::ios::end);
+  if(myStream)
+    myStream->write(static_cast<const char*>(data), size);
+  else
+  {
+    if(size > myCapacity - myWritePos)
+    {
+      const size_t capacity = std::max(myCapacity * 2, myWritePos + size);
+      ByteBuffer buffer = allocate(capacity);
 
-  return myStream->tellp();
+      std::copy_n(myBuffer.get(), mySize, buffer.get());
+      myBuffer = std::move(buffer);
+      myCapacity = capacity;
+    }
+    std::memcpy(myBuffer.get() + myWritePos, data, size);
+    myWritePos += size;
+    mySize = std::max(mySize, myWritePos);
+  }
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 uInt8 Serializer::getByte() const
 {
   char buf;
-  myStream->read(&buf, 1);
+  read(&buf, 1);
 
   return buf;
 }
@@ -108,14 +151,14 @@ uInt8 Serializer::getByte() const
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void Serializer::getByteArray(uInt8* array, size_t size) const
 {
-  myStream->read(reinterpret_cast<char*>(array), size);
+  read(array, size);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 uInt16 Serializer::getShort() const
 {
   uInt16 val = 0;
-  myStream->read(reinterpret_cast<char*>(&val), sizeof(uInt16));
+  read(&val, sizeof(uInt16));
 
   return val;
 }
@@ -123,14 +166,14 @@ uInt16 Serializer::getShort() const
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void Serializer::getShortArray(uInt16* array, size_t size) const
 {
-  myStream->read(reinterpret_cast<char*>(array), sizeof(uInt16)*size);
+  read(array, sizeof(uInt16)*size);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 uInt32 Serializer::getInt() const
 {
   uInt32 val = 0;
-  myStream->read(reinterpret_cast<char*>(&val), sizeof(uInt32));
+  read(&val, sizeof(uInt32));
 
   return val;
 }
@@ -138,14 +181,14 @@ uInt32 Serializer::getInt() const
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void Serializer::getIntArray(uInt32* array, size_t size) const
 {
-  myStream->read(reinterpret_cast<char*>(array), sizeof(uInt32)*size);
+  read(array, sizeof(uInt32)*size);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 uInt64 Serializer::getLong() const
 {
   uInt64 val = 0;
-  myStream->read(reinterpret_cast<char*>(&val), sizeof(uInt64));
+  read(&val, sizeof(uInt64));
 
   return val;
 }
@@ -154,7 +197,7 @@ uInt64 Serializer::getLong() const
 double Serializer::getDouble() const
 {
   double val = 0.0;
-  myStream->read(reinterpret_cast<char*>(&val), sizeof(double));
+  read(&val, sizeof(double));
 
   return val;
 }
@@ -165,7 +208,7 @@ string Serializer::getString() const
   int len = getInt();
   string str;
   str.resize(len);
-  myStream->read(&str[0], len);
+  read(&str[0], len);
 
   return str;
 }
@@ -179,49 +222,49 @@ bool Serializer::getBool() const
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void Serializer::putByte(uInt8 value)
 {
-  myStream->write(reinterpret_cast<char*>(&value), 1);
+  write(&value, 1);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void Serializer::putByteArray(const uInt8* array, size_t size)
 {
-  myStream->write(reinterpret_cast<const char*>(array), size);
+  write(array, size);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void Serializer::putShort(uInt16 value)
 {
-  myStream->write(reinterpret_cast<char*>(&value), sizeof(uInt16));
+  write(&value, sizeof(uInt16));
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void Serializer::putShortArray(const uInt16* array, size_t size)
 {
-  myStream->write(reinterpret_cast<const char*>(array), sizeof(uInt16)*size);
+  write(array, sizeof(uInt16)*size);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void Serializer::putInt(uInt32 value)
 {
-  myStream->write(reinterpret_cast<char*>(&value), sizeof(uInt32));
+  write(&value, sizeof(uInt32));
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void Serializer::putIntArray(const uInt32* array, size_t size)
 {
-  myStream->write(reinterpret_cast<const char*>(array), sizeof(uInt32)*size);
+  write(array, sizeof(uInt32)*size);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void Serializer::putLong(uInt64 value)
 {
-  myStream->write(reinterpret_cast<char*>(&value), sizeof(uInt64));
+  write(&value, sizeof(uInt64));
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void Serializer::putDouble(double value)
 {
-  myStream->write(reinterpret_cast<char*>(&value), sizeof(double));
+  write(&value, sizeof(double));
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -229,7 +272,7 @@ void Serializer::putString(const string& str)
 {
   uInt32 len = uInt32(str.length());
   putInt(len);
-  myStream->write(str.data(), len);
+  write(str.data(), len);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -237,3 +280,11 @@ void Serializer::putBool(bool b)
 {
   putByte(b ? TruePattern: FalsePattern);
 }
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+ByteBuffer Serializer::allocate(size_t size)
+{
+  // Unlike make_unique, this doesn't zero the buffer; only the data written
+  // to it is ever read
+  return ByteBuffer(new uInt8[size]);
+}
@@ -25,6 +25,11 @@
   read from/written to a binary stream in a system-independent way.  The
   stream can be either an actual file, or an in-memory structure.
 
+  In-memory streams are backed by a flat, growable byte buffer instead of
+  an iostream, since they are used for every rewind state and libretro
+  save state.  Reading beyond the end of the data throws an exception,
+  just like reading past the end of a file does.
+
   Bytes are written as characters, shorts as 2 characters (16-bits),
   integers as 4 characters (32-bits), long integers as 8 bytes (64-bits),
   strings are written as characters prepended by the length of the string,
@@ -57,7 +62,9 @@ class Serializer
       Answers whether the serializer is currently initialized for reading
       and writing.
     */
-    explicit operator bool() const { return myStream != nullptr; }
+    explicit operator bool() const {
+      return myStream != nullptr || myBuffer != nullptr;
+    }
 
     /**
       Resets the read/write location to the beginning of the stream.
@@ -69,6 +76,12 @@ class Serializer
     */
     size_t size() const;
 
+    /**
+      Returns the data of an in-memory stream, or nullptr for a file stream.
+      The pointer is valid until the next write operation.
+    */
+    const uInt8* data() const { return myBuffer.get(); }
+
     /**
       Reads a byte value (unsigned 8-bit) from the current input stream.
 
@@ -216,9 +229,29 @@ class Serializer
     void putBool(bool b);
 
   private:
-    // The stream to send the serialized data to.
+    /**
+      Reads/writes raw bytes from/to the underlying file or memory stream.
+    */
+    void read(void* data, size_t size) const;
+    void write(const void* data, size_t size);
+
+    // Allocate an in-memory buffer (without initializing it)
+    static ByteBuffer allocate(size_t size);
+
+  private:
+    // The stream to send the serialized data to (file streams only)
     unique_ptr<iostream> myStream;
 
+    // The buffer for in-memory streams
+    ByteBuffer myBuffer;
+    size_t myCapacity{0};
+    size_t mySize{0};
+    mutable size_t myReadPos{0};
+    mutable size_t myWritePos{0};
+
+    // Initial size of the in-memory buffer, large enough for most states
+    static constexpr size_t INITIAL_CAPACITY = 64 * 1024;
+
     static constexpr uInt8 TruePattern = 0xfe, FalsePattern = 0x01;
 
   private:
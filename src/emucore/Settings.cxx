@@ -23,6 +23,7 @@
 #include "AudioSettings.hxx"
 #include "PaletteHandler.hxx"
 #include "Paddles.hxx"
+#include "RewindManager.hxx"
 
 #ifdef DEBUGGER_SUPPORT
   #include "DebuggerDialog.hxx"
@@ -133,6 +134,8 @@ Settings::Settings()
   setPermanent("ssinterval", "2");
   setPermanent("autoslot", "false");
   setPermanent("saveonexit", "none");
+  setPermanent("runahead", "0");
+  setPermanent("runahead.second", "false");
 
   // Config files and paths
   setPermanent("romdir", "");
@@ -175,6 +178,8 @@ Settings::Settings()
   setPermanent("avoxport", "");
   setPermanent("fastscbios", "true");
   setPermanent("threads", "false");
+  setPermanent("pinthreads", "false");
+  setPermanent("thumbcache", "true");
   setTemporary("romloadcount", "0");
   setTemporary("maxres", "");
   setPermanent("initials", "");
@@ -209,6 +214,7 @@ Settings::Settings()
   setPermanent("plr.tm.uncompressed", 60);
   setPermanent("plr.tm.interval", "30f"); // = 0.5 seconds
   setPermanent("plr.tm.horizon", "10m"); // = ~10 minutes
+  setPermanent("plr.tm.deltas", "true");
   setPermanent("plr.detectedinfo", "false");
   setPermanent("plr.eepromaccess", "false");
 
@@ -238,6 +244,7 @@ Settings::Settings()
   setPermanent("dev.tm.uncompressed", 600);
   setPermanent("dev.tm.interval", "1f"); // = 1 frame
   setPermanent("dev.tm.horizon", "30s"); // = ~30 seconds
+  setPermanent("dev.tm.deltas", "true");
   // Thumb ARM emulation options
   setPermanent("dev.thumb.trapfatal", "true");
   setPermanent("dev.detectedinfo", "true");
@@ -284,6 +291,9 @@ void Settings::validate()
   f = getFloat("speed");
   if (f <= 0) setValue("speed", "1.0");
 
+  i = getInt("runahead");
+  if(i < 0 || i > 4)  setValue("runahead", "0");
+
   i = getInt("tia.vsizeadjust");
   if(i < -5 || i > 5)  setValue("tia.vsizeadjust", 0);
 
@@ -304,10 +314,13 @@ void Settings::validate()
   if(i < 1 || i > 20) setValue("dev.tv.jitter_recovery", "2");
 
   int size = getInt("dev.tm.size");
-  if(size < 20 || size > 1000)
+  // Without deltas, every state is a complete one
+  int maxSize = getBool("dev.tm.deltas")
+    ? RewindManager::MAX_BUF_SIZE : RewindManager::MAX_KEYFRAME_BUF_SIZE;
+  if(size < 20 || size > maxSize)
   {
-    setValue("dev.tm.size", 20);
-    size = 20;
+    size = BSPF::clamp(size, 20, maxSize);
+    setValue("dev.tm.size", size);
   }
 
   i = getInt("dev.tm.uncompressed");
@@ -323,10 +336,12 @@ void Settings::validate()
   if(i < 1 || i > 20) setValue("plr.tv.jitter_recovery", "10");
 
   size = getInt("plr.tm.size");
-  if(size < 20 || size > 1000)
+  maxSize = getBool("plr.tm.deltas")
+    ? RewindManager::MAX_BUF_SIZE : RewindManager::MAX_KEYFRAME_BUF_SIZE;
+  if(size < 20 || size > maxSize)
   {
-    setValue("plr.tm.size", 20);
-    size = 20;
+    size = BSPF::clamp(size, 20, maxSize);
+    setValue("plr.tm.size", size);
   }
 
   i = getInt("plr.tm.uncompressed");
@@ -515,6 +530,8 @@ void Settings::usage() const
     << "  -fastscbios   <1|0>          Disable Supercharger BIOS progress loading bars\n"
     << "  -threads      <1|0>          Whether to using multi-threading during\n"
     << "                                emulation\n"
+    << "  -pinthreads   <1|0>          Bind each rendering thread to its own core\n"
+    << "  -thumbcache   <1|0>          Cache predecoded blocks of ARM code\n"
     << "  -snapsavedir  <path>         The directory to save snapshot files to\n"
     << "  -snaploaddir  <path>         The directory to load snapshot files from\n"
     << "  -snapname     <int|rom>      Name snapshots according to internal database or\n"
@@ -529,6 +546,10 @@ void Settings::usage() const
     << "                 all>           emulation\n"
     << "  -autoslot     <1|0>          Automatically change to next save slot when\n"
     << "                                state saving\n"
+    << "  -runahead     <0-4>          Number of frames to run ahead of the emulation\n"
+    << "                                to reduce input latency (0 means off)\n"
+    << "  -runahead.second <1|0>       Run ahead using a second instance instead of\n"
+    << "                                saving and restoring the emulation\n"
     << endl
     << "  -rominfo      <rom>          Display detailed information for the given ROM\n"
     << "  -listrominfo                 Display contents of stella.pro, one line per ROM\n"
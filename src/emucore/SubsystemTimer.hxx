@@ -0,0 +1,137 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2020 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+#ifndef SUBSYSTEM_TIMER_HXX
+#define SUBSYSTEM_TIMER_HXX
+
+#include <chrono>
+
+#include "bspf.hxx"
+
+/**
+  Accumulates wall-clock time spent in the different parts of the emulation
+  core.  Time is always attributed to exactly one subsystem: entering a
+  nested subsystem (for example the ARM driver called from a cartridge
+  hotspot) pauses the outer one until the nested scope is left.  Whatever
+  is not claimed by any other subsystem is accounted to the CPU.
+
+  The timer is opt-in; the core only touches it when one has been attached
+  to the System, so regular emulation pays a single null check per hook.
+*/
+class SubsystemTimer
+{
+  public:
+    enum class Subsystem : uInt8 {
+      cpu, tia, riot, cart, arm,
+      numSubsystems
+    };
+    static constexpr uInt32 NUM_SUBSYSTEMS = uInt32(Subsystem::numSubsystems);
+
+    /**
+      Attribute the time spent during the lifetime of a scope to a subsystem.
+      Passing a null timer turns the scope into a no-op.
+    */
+    class Scope
+    {
+      public:
+        Scope(SubsystemTimer* timer, Subsystem subsystem)
+          : myTimer(timer)
+        {
+          if(myTimer) myPrevious = myTimer->enter(subsystem);
+        }
+        ~Scope()
+        {
+          if(myTimer) myTimer->enter(myPrevious);
+        }
+
+      private:
+        SubsystemTimer* myTimer{nullptr};
+        Subsystem myPrevious{Subsystem::cpu};
+
+      private:
+        Scope(const Scope&) = delete;
+        Scope(Scope&&) = delete;
+        Scope& operator=(const Scope&) = delete;
+        Scope& operator=(Scope&&) = delete;
+    };
+
+  public:
+    SubsystemTimer() = default;
+
+    /**
+      Clear all accumulated times and start accounting to the CPU.
+    */
+    void start() {
+      myTotals.fill(clock::duration::zero());
+      myCurrent = Subsystem::cpu;
+      myTimestamp = clock::now();
+    }
+
+    /**
+      Account the time since the last switch and stop accumulating.
+    */
+    void stop() { enter(Subsystem::cpu); }
+
+    /**
+      Switch accounting to the given subsystem.
+
+      @return  The subsystem that was active before the switch
+    */
+    Subsystem enter(Subsystem subsystem) {
+      const clock::time_point now = clock::now();
+      const Subsystem previous = myCurrent;
+
+      myTotals[uInt32(previous)] += now - myTimestamp;
+      myTimestamp = now;
+      myCurrent = subsystem;
+
+      return previous;
+    }
+
+    /**
+      Answer the time accumulated for the given subsystem, in seconds.
+    */
+    double seconds(Subsystem subsystem) const {
+      return std::chrono::duration<double>(myTotals[uInt32(subsystem)]).count();
+    }
+
+    /**
+      Answer a short, lowercase name for the given subsystem.
+    */
+    static string name(Subsystem subsystem) {
+      static const std::array<string, NUM_SUBSYSTEMS> NAMES = {
+        "m6502", "tia", "m6532", "cart", "thumbulator"
+      };
+      return NAMES[uInt32(subsystem)];
+    }
+
+  private:
+    using clock = std::chrono::high_resolution_clock;
+
+    std::array<clock::duration, NUM_SUBSYSTEMS> myTotals{};
+    Subsystem myCurrent{Subsystem::cpu};
+    clock::time_point myTimestamp;
+
+  private:
+    // Following constructors and assignment operators not supported
+    SubsystemTimer(const SubsystemTimer&) = delete;
+    SubsystemTimer(SubsystemTimer&&) = delete;
+    SubsystemTimer& operator=(const SubsystemTimer&) = delete;
+    SubsystemTimer& operator=(SubsystemTimer&&) = delete;
+};
+
+#endif // SUBSYSTEM_TIMER_HXX
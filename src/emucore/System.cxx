@@ -124,7 +124,11 @@ uInt8 System::peek(uInt16 addr, Device::AccessFlags flags)
   if(access.directPeekBase)
     result = *(access.directPeekBase + (addr & PAGE_MASK));
   else
+  {
+    SubsystemTimer::Scope timing(mySubsystemTimer,
+        mySubsystemTimer ? timedSubsystem(access.device) : SubsystemTimer::Subsystem::cpu);
     result = access.device->peek(addr);
+  }
 
 #ifdef DEBUGGER_SUPPORT
   if(!myDataBusLocked)
@@ -165,6 +169,8 @@ void System::poke(uInt16 addr, uInt8 value, Device::AccessFlags flags)
   }
   else
   {
+    SubsystemTimer::Scope timing(mySubsystemTimer,
+        mySubsystemTimer ? timedSubsystem(access.device) : SubsystemTimer::Subsystem::cpu);
     // The specific device informs us if the poke succeeded
     myPageIsDirtyTable[page] = access.device->poke(addr, value);
   }
@@ -175,6 +181,19 @@ void System::poke(uInt16 addr, uInt8 value, Device::AccessFlags flags)
     myDataBusState = value;
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+SubsystemTimer::Subsystem System::timedSubsystem(const Device* device) const
+{
+  if(device == &myCart)
+    return SubsystemTimer::Subsystem::cart;
+  else if(device == &myTIA)
+    return SubsystemTimer::Subsystem::tia;
+  else if(device == &myM6532)
+    return SubsystemTimer::Subsystem::riot;
+  else
+    return SubsystemTimer::Subsystem::cpu;
+}
+
 #ifdef DEBUGGER_SUPPORT
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 Device::AccessFlags System::getAccessFlags(uInt16 addr) const
@@ -28,6 +28,7 @@ class Cartridge;
 #include "NullDev.hxx"
 #include "Random.hxx"
 #include "Serializable.hxx"
+#include "SubsystemTimer.hxx"
 
 /**
   This class represents a system consisting of a 6502 microprocessor
@@ -159,6 +160,17 @@ class System : public Serializable
     */
     bool autodetectMode() const { return mySystemInAutodetect; }
 
+    /**
+      Attach a timer that accumulates the time spent in the individual
+      devices (used for benchmarking), or detach it by passing nullptr.
+    */
+    void setSubsystemTimer(SubsystemTimer* timer) { mySubsystemTimer = timer; }
+
+    /**
+      Answer the attached subsystem timer, or nullptr if there is none.
+    */
+    SubsystemTimer* subsystemTimer() const { return mySubsystemTimer; }
+
   public:
     /**
       Get the current state of the data bus in the system.  The current
@@ -246,7 +258,7 @@ class System : public Serializable
         to this page, while other values are the base address of an array
         to directly access for reads to this page.
       */
-      uInt8* directPeekBase{nullptr};
+      const uInt8* directPeekBase{nullptr};
 
       /**
         Pointer to a block of memory or the null pointer.  The null pointer
@@ -365,6 +377,12 @@ class System : public Serializable
     */
     bool load(Serializer& in) override;
 
+  private:
+    /**
+      Answer the subsystem that accesses to the given device are timed as.
+    */
+    SubsystemTimer::Subsystem timedSubsystem(const Device* device) const;
+
   private:
     // The system RNG
     Random& myRandom;
@@ -406,6 +424,9 @@ class System : public Serializable
     // Some parts of the codebase need to act differently in such a case
     bool mySystemInAutodetect{false};
 
+    // Optional timer for benchmarking the individual devices (not owned)
+    SubsystemTimer* mySubsystemTimer{nullptr};
+
   private:
     // Following constructors and assignment operators not supported
     System() = delete;
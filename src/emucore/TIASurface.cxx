@@ -89,7 +89,8 @@ TIASurface::TIASurface(OSystem& system)
   myRGBFramebuffer.fill(0);
 
   // Enable/disable threading in the NTSC TV effects renderer
-  myNTSCFilter.enableThreading(myOSystem.settings().getBool("threads"));
+  myNTSCFilter.enableThreading(myOSystem.settings().getBool("threads"),
+                               myOSystem.settings().getBool("pinthreads"));
 
   myPaletteHandler = make_unique<PaletteHandler>(myOSystem);
   myPaletteHandler->loadConfig(myOSystem.settings());
@@ -105,6 +106,7 @@ void TIASurface::initialize(const Console& console,
                             const VideoModeHandler::Mode& mode)
 {
   myTIA = &(console.tia());
+  myRenderedValid = false;
 
   myTiaSurface->setDstPos(mode.imageR.x(), mode.imageR.y());
   myTiaSurface->setDstSize(mode.imageR.w(), mode.imageR.h());
@@ -149,6 +151,7 @@ void TIASurface::setPalette(const PaletteArray& tia_palette,
                             const PaletteArray& rgb_palette)
 {
   myPalette = tia_palette;
+  myRenderedValid = false;
 
   // The NTSC filtering needs access to the raw RGB data, since it calculates
   // its own internal palette
@@ -292,6 +295,7 @@ void TIASurface::enablePhosphor(bool enable, int blend)
   {
     myFilter = Filter(enable ? uInt8(myFilter) | 0x01 : uInt8(myFilter) & 0x10);
     myRGBFramebuffer.fill(0);
+    myRenderedValid = false;
   }
 }
 
@@ -318,6 +322,7 @@ void TIASurface::enableNTSC(bool enable)
   mySLineSurface->applyAttributes();
 
   myRGBFramebuffer.fill(0);
+  myRenderedValid = false;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -379,23 +384,43 @@ void TIASurface::render(bool shade)
   uInt32 *out, outPitch;
   myTiaSurface->basePtr(out, outPitch);
 
+  // Only the normal filter keeps the surface in sync with the framebuffer
+  const bool renderedValid = myRenderedValid && height == myRenderedHeight;
+  myRenderedValid = false;
+
   switch(myFilter)
   {
     case Filter::Normal:
     {
       uInt8* tiaIn = myTIA->frameBuffer();
+      const uInt32 revision = myTIA->frameBufferRevision();
+
+      // If the surface holds the previous revision of the framebuffer, only
+      // the scanlines changed since then have to be converted (and uploaded)
+      const bool unchanged = renderedValid && revision == myRenderedRevision;
+      const bool partial = renderedValid && revision == myRenderedRevision + 1;
+      const TIA::ScanlineMask& dirty = myTIA->dirtyScanlines();
 
-      uInt32 bufofs = 0, screenofsY = 0, pos;
-      for(uInt32 y = 0; y < height; ++y)
+      uInt32 top = height, bottom = 0;
+      for(uInt32 y = 0; y < height && !unchanged; ++y)
       {
-        pos = screenofsY;
+        if(partial && !dirty[y])
+          continue;
+
+        uInt32 bufofs = y * width, pos = y * outPitch;
         for (uInt32 x = width / 2; x; --x)
         {
           out[pos++] = myPalette[tiaIn[bufofs++]];
           out[pos++] = myPalette[tiaIn[bufofs++]];
         }
-        screenofsY += outPitch;
+        top = std::min(top, y);
+        bottom = y + 1;
       }
+      myTiaSurface->setDirtyRows(top, bottom);
+
+      myRenderedRevision = revision;
+      myRenderedHeight = height;
+      myRenderedValid = true;
       break;
     }
 
@@ -408,20 +433,26 @@ void TIASurface::render(bool shade)
         std::copy_n(myRGBFramebuffer.begin(), width * height,
                     myPrevRGBFramebuffer.begin());
 
-      uInt32 bufofs = 0, screenofsY = 0, pos;
-      for(uInt32 y = height; y ; --y)
-      {
-        pos = screenofsY;
-        for(uInt32 x = width / 2; x ; --x)
+      // Split the blending into slices, using the threads of the NTSC filter
+      myNTSCFilter.workerPool().run([&](uInt32 slice, uInt32 numSlices) {
+        const uInt32 yStart = height * slice / numSlices;
+        const uInt32 yEnd = height * (slice + 1) / numSlices;
+
+        uInt32 bufofs = width * yStart, screenofsY = outPitch * yStart;
+        for(uInt32 y = yStart; y < yEnd; ++y)
         {
+          uInt32* line = out + screenofsY;
+          for(uInt32 x = 0; x < width; ++x)
+            line[x] = myPalette[tiaIn[bufofs + x]];
+
           // Store back into displayed frame buffer (for next frame)
-          rgbIn[bufofs] = out[pos++] = PhosphorHandler::getPixel(myPalette[tiaIn[bufofs]], rgbIn[bufofs]);
-          ++bufofs;
-          rgbIn[bufofs] = out[pos++] = PhosphorHandler::getPixel(myPalette[tiaIn[bufofs]], rgbIn[bufofs]);
-          ++bufofs;
+          PhosphorHandler::getPixels(line, rgbIn + bufofs, width);
+          std::copy_n(rgbIn + bufofs, width, line);
+
+          bufofs += width;
+          screenofsY += outPitch;
         }
-        screenofsY += outPitch;
-      }
+      });
       break;
     }
 
@@ -514,6 +545,9 @@ void TIASurface::renderForSnapshot()
       break;
   }
 
+  // The surface may no longer hold the plain framebuffer image
+  myRenderedValid = false;
+
   if(myPhosphorHandler.phosphorEnabled())
   {
     // Draw TIA image
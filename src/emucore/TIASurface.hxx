@@ -224,6 +224,12 @@ class TIASurface
         TIAConstants::frameBufferHeight> myPrevRGBFramebuffer;
     /////////////////////////////////////////////////////////////
 
+    // The framebuffer revision (see TIA::frameBufferRevision()) and height
+    // the TIA surface was last rendered from in normal mode, and whether the
+    // surface still holds exactly that image
+    uInt32 myRenderedRevision{0}, myRenderedHeight{0};
+    bool myRenderedValid{false};
+
     // Use scanlines in TIA rendering mode
     bool myScanlinesEnabled{false};
 
@@ -26,6 +26,9 @@
 #include "Base.hxx"
 #include "Cart.hxx"
 #include "Thumbulator.hxx"
+#ifdef DEBUGGER_SUPPORT
+  #include "ThumbProfiler.hxx"
+#endif
 using Common::Base;
 
 // Uncomment the following to enable specific functionality
@@ -55,8 +58,8 @@ using Common::Base;
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 Thumbulator::Thumbulator(const uInt16* rom_ptr, uInt16* ram_ptr, uInt32 rom_size,
                          const uInt32 c_base, const uInt32 c_start, const uInt32 c_stack,
-                         bool traponfatal, Thumbulator::ConfigureFor configurefor,
-                         Cartridge* cartridge)
+                         bool traponfatal, bool cacheblocks,
+                         Thumbulator::ConfigureFor configurefor, Cartridge* cartridge)
   : rom(rom_ptr),
     romSize(rom_size),
     cBase(c_base),
@@ -70,10 +73,17 @@ Thumbulator::Thumbulator(const uInt16* rom_ptr, uInt16* ram_ptr, uInt32 rom_size
   for(uInt32 i = 0; i < romSize / 2; ++i)
     decodedRom[i] = decodeInstructionWord(CONV_RAMROM(rom[i]));
 
+  romBlocks.index.resize(romSize / 2);
+#ifndef UNSAFE_OPTIMIZATIONS
+  ramBlocks.index.resize(RAMSIZE / 2);
+  ramCode.resize(RAMSIZE / 2);
+#endif
+
   setConsoleTiming(ConsoleTiming::ntsc);
 #ifndef UNSAFE_OPTIMIZATIONS
   trapFatalErrors(traponfatal);
 #endif
+  cacheBlocks(cacheblocks);
   reset();
 }
 
@@ -81,14 +91,33 @@ Thumbulator::Thumbulator(const uInt16* rom_ptr, uInt16* ram_ptr, uInt32 rom_size
 string Thumbulator::run()
 {
   reset();
+#ifndef UNSAFE_OPTIMIZATIONS
+  // The cartridge may have modified the RAM since the last call
+  clearRamBlocks();
+#endif
+#ifdef DEBUGGER_SUPPORT
+  if(profiler)
+    profiler->beginRun(read_register(15) - 2);
+#endif
   for(;;)
   {
-    if(execute()) break;
+#ifdef DEBUGGER_SUPPORT
+    if(profiler)
+    {
+      if(executeProfiled()) break;
+    }
+    else
+#endif
+    if(blockCache ? executeBlock() : execute()) break;
 #ifndef UNSAFE_OPTIMIZATIONS
     if(instructions > 500000) // way more than would otherwise be possible
       throw runtime_error("instructions > 500000");
 #endif
   }
+#ifdef DEBUGGER_SUPPORT
+  if(profiler)
+    profiler->endRun();
+#endif
 #if defined(THUMB_DISS) || defined(THUMB_DBUG)
   dump_counters();
   cout << statusMsg.str() << endl;
@@ -241,6 +270,9 @@ void Thumbulator::write16(uInt32 addr, uInt32 data)
       addr &= RAMADDMASK;
       addr >>= 1;
       ram[addr] = CONV_DATA(data);
+#ifndef UNSAFE_OPTIMIZATIONS
+      if(ramCode[addr]) ramCodeModified = true;
+#endif
       return;
 
 #ifndef UNSAFE_OPTIMIZATIONS
@@ -813,16 +845,13 @@ Thumbulator::Op Thumbulator::decodeInstructionWord(uint16_t inst) {
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 int Thumbulator::execute()
 {
-  uInt32 pc, sp, inst, ra, rb, rc, rm, rd, rn, rs, op;
-
-  pc = read_register(15);
+  uInt32 pc = read_register(15);
 
   uInt32 instructionPtr = pc - 2;
-  inst = fetch16(instructionPtr);
+  uInt32 inst = fetch16(instructionPtr);
 
   pc += 2;
   write_register(15, pc);
-  DO_DISS(statusMsg << Base::HEX8 << (pc-5) << ": " << Base::HEX4 << inst << " ");
 
 #ifndef UNSAFE_OPTIMIZATIONS
   ++instructions;
@@ -838,6 +867,251 @@ int Thumbulator::execute()
   decodedOp = decodedRom[(instructionPtr & ROMADDMASK) >> 1];
 #endif
 
+  return execute(decodedOp, inst, pc, CPSR_C | CPSR_V);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+int Thumbulator::executeBlock()
+{
+  const uInt32 instructionPtr = read_register(15) - 2;
+  BlockCache* cache;
+  uInt32 index;
+
+#ifndef UNSAFE_OPTIMIZATIONS
+  if((instructionPtr & 0xF0000000) == 0 && instructionPtr >= 0x50 &&
+     instructionPtr < romSize)
+  {
+    cache = &romBlocks;
+    index = instructionPtr >> 1;
+    if(!cache->index[index])
+      buildBlock(*cache, rom, index, romSize >> 1, true);
+  }
+  else if((instructionPtr & 0xF0000000) == 0x40000000)
+  {
+    if(ramCodeModified) clearRamBlocks();
+
+    cache = &ramBlocks;
+    index = (instructionPtr & RAMADDMASK) >> 1;
+    if(!cache->index[index])
+    {
+      const Block& block =
+        cache->blocks[buildBlock(*cache, ram, index, RAMSIZE >> 1, false) - 1];
+      std::fill_n(ramCode.begin() + block.start, block.size, 1);
+    }
+  }
+  else
+    // Let the interpreter report the invalid fetch
+    return execute();
+#else
+  cache = &romBlocks;
+  index = (instructionPtr & ROMADDMASK) >> 1;
+  if(!cache->index[index])
+    buildBlock(*cache, rom, index, ROMSIZE >> 1, true);
+#endif
+
+  const Block& block = cache->blocks[cache->index[index] - 1];
+  const BlockOp* blockOp = &cache->ops[block.first];
+  uInt32 pc = instructionPtr + 4;
+
+  for(uInt32 i = 0; i < block.size; ++i, ++blockOp, pc += 2)
+  {
+    reg_norm[15] = pc;
+#ifndef UNSAFE_OPTIMIZATIONS
+    ++instructions;
+#endif
+#ifndef NO_THUMB_STATS
+    ++fetches;
+#endif
+    if(execute(blockOp->op, blockOp->inst, pc, uInt32(blockOp->flags) << 24))
+      return 1;
+#ifndef UNSAFE_OPTIMIZATIONS
+    // The remaining instructions may have been overwritten
+    if(ramCodeModified) break;
+#endif
+  }
+
+  return 0;
+}
+
+#ifdef DEBUGGER_SUPPORT
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+int Thumbulator::executeProfiled()
+{
+  const uInt32 instructionPtr = read_register(15) - 2;
+  const uInt32 lr = reg_norm[14];
+#ifndef NO_THUMB_STATS
+  const uInt64 memCycles = fetches + reads + writes;
+#endif
+
+  const int result = execute();
+
+#ifndef NO_THUMB_STATS
+  const uInt32 cycles = uInt32(fetches + reads + writes - memCycles);
+#else
+  // Without the statistics, every instruction counts as a single cycle
+  const uInt32 cycles = 1;
+#endif
+
+  // BL and BLX set LR to the address following them
+  const uInt32 next = read_register(15) - 2;
+  const bool isCall = reg_norm[14] != lr && reg_norm[14] == ((instructionPtr + 2) | 1) &&
+                      next != instructionPtr + 2;
+
+  profiler->instruction(instructionPtr, cycles, next, isCall);
+  return result;
+}
+
+#endif
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+uInt32 Thumbulator::buildBlock(BlockCache& cache, const uInt16* code,
+                               uInt32 start, uInt32 end, bool predecoded)
+{
+  const uInt32 first = uInt32(cache.ops.size());
+
+  end = std::min(end, start + MAX_BLOCK_SIZE);
+  for(uInt32 i = start; i < end; ++i)
+  {
+    const uInt16 inst = CONV_RAMROM(code[i]);
+    const Op op = predecoded ? decodedRom[i] : decodeInstructionWord(inst);
+
+    cache.ops.push_back({op, 0, inst});
+    if(endsBlock(op, inst)) break;
+  }
+
+  // Work backwards to determine which of the flags written by each
+  // instruction are read before being overwritten; at the end of the block
+  // all flags are assumed to be needed
+  uInt32 live = CPSR_C | CPSR_V;
+  for(uInt32 i = uInt32(cache.ops.size()); i-- > first; )
+  {
+    BlockOp& blockOp = cache.ops[i];
+
+    blockOp.flags = uInt8(live >> 24);
+    live = (live & ~flagsWritten(blockOp.op)) | flagsRead(blockOp.op);
+#ifndef UNSAFE_OPTIMIZATIONS
+    // A write may modify the cached RAM code, which ends the block right
+    // after it, before any later instruction can write the flags
+    if(writesMemory(blockOp.op))
+      live = CPSR_C | CPSR_V;
+#endif
+  }
+
+  cache.blocks.push_back({start, first, uInt32(cache.ops.size()) - first});
+
+  return cache.index[start] = uInt32(cache.blocks.size());
+}
+
+#ifndef UNSAFE_OPTIMIZATIONS
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void Thumbulator::clearRamBlocks()
+{
+  for(const Block& block: ramBlocks.blocks)
+  {
+    ramBlocks.index[block.start] = 0;
+    std::fill_n(ramCode.begin() + block.start, block.size, 0);
+  }
+  ramBlocks.blocks.clear();
+  ramBlocks.ops.clear();
+  ramCodeModified = false;
+}
+#endif
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool Thumbulator::endsBlock(Op op, uInt16 inst)
+{
+  switch(op)
+  {
+    case Op::b1:
+    case Op::b2:
+    case Op::blx2:
+    case Op::bx:
+    case Op::bkpt:
+    case Op::cps:
+    case Op::setend:
+    case Op::swi:
+    case Op::invalid:
+      return true;
+
+    case Op::blx1:
+      // the first half of a BL only sets up LR
+      return (inst & 0x1800) != 0x1000;
+
+    case Op::add4:
+    case Op::mov3:
+      // rd == 15
+      return (inst & 0x87) == 0x87;
+
+    case Op::pop:
+      return (inst & 0x100) != 0;
+
+    default:
+      return false;
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+uInt32 Thumbulator::flagsWritten(Op op)
+{
+  // Only C and V are of interest, since N and Z are cheap to compute anyway;
+  // instructions which only write them under some conditions don't count
+  switch(op)
+  {
+    case Op::adc:
+    case Op::add1: case Op::add2: case Op::add3:
+    case Op::cmn:
+    case Op::cmp1: case Op::cmp2: case Op::cmp3:
+    case Op::mov2:
+    case Op::neg:
+    case Op::sbc:
+    case Op::sub1: case Op::sub2: case Op::sub3:
+      return CPSR_C | CPSR_V;
+
+    default:
+      return 0;
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+uInt32 Thumbulator::flagsRead(Op op)
+{
+  // Instructions reading other flags always end a block
+  switch(op)
+  {
+    case Op::adc:
+    case Op::sbc:
+      return CPSR_C;
+
+    default:
+      return 0;
+  }
+}
+
+#ifndef UNSAFE_OPTIMIZATIONS
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool Thumbulator::writesMemory(Op op)
+{
+  switch(op)
+  {
+    case Op::push:
+    case Op::stmia:
+    case Op::str1: case Op::str2: case Op::str3:
+    case Op::strb1: case Op::strb2:
+    case Op::strh1: case Op::strh2:
+      return true;
+
+    default:
+      return false;
+  }
+}
+#endif
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+int Thumbulator::execute(Op decodedOp, uInt32 inst, uInt32 pc, uInt32 liveFlags)
+{
+  uInt32 sp, ra, rb, rc, rm, rd, rn, rs, op;
+
+  DO_DISS(statusMsg << Base::HEX8 << (pc-5) << ": " << Base::HEX4 << inst << " ");
+
   switch (decodedOp) {
     //ADC
     case Op::adc: {
@@ -852,8 +1126,9 @@ int Thumbulator::execute()
       write_register(rd, rc);
       do_nflag(rc);
       do_zflag(rc);
-      if(cpsr & CPSR_C) { do_cflag(ra, rb, 1); do_vflag(ra, rb, 1); }
-      else              { do_cflag(ra, rb, 0); do_vflag(ra, rb, 0); }
+      rs = (cpsr & CPSR_C) ? 1 : 0;
+      if(liveFlags & CPSR_C) do_cflag(ra, rb, rs);
+      if(liveFlags & CPSR_V) do_vflag(ra, rb, rs);
       return 0;
     }
 
@@ -872,8 +1147,8 @@ int Thumbulator::execute()
         write_register(rd, rc);
         do_nflag(rc);
         do_zflag(rc);
-        do_cflag(ra, rb, 0);
-        do_vflag(ra, rb, 0);
+        if(liveFlags & CPSR_C) do_cflag(ra, rb, 0);
+        if(liveFlags & CPSR_V) do_vflag(ra, rb, 0);
         return 0;
       }
       else
@@ -894,8 +1169,8 @@ int Thumbulator::execute()
       write_register(rd, rc);
       do_nflag(rc);
       do_zflag(rc);
-      do_cflag(ra, rb, 0);
-      do_vflag(ra, rb, 0);
+      if(liveFlags & CPSR_C) do_cflag(ra, rb, 0);
+      if(liveFlags & CPSR_V) do_vflag(ra, rb, 0);
       return 0;
     }
 
@@ -911,8 +1186,8 @@ int Thumbulator::execute()
       write_register(rd, rc);
       do_nflag(rc);
       do_zflag(rc);
-      do_cflag(ra, rb, 0);
-      do_vflag(ra, rb, 0);
+      if(liveFlags & CPSR_C) do_cflag(ra, rb, 0);
+      if(liveFlags & CPSR_V) do_vflag(ra, rb, 0);
       return 0;
     }
 
@@ -1518,8 +1793,8 @@ int Thumbulator::execute()
       rc = ra + rb;
       do_nflag(rc);
       do_zflag(rc);
-      do_cflag(ra, rb, 0);
-      do_vflag(ra, rb, 0);
+      if(liveFlags & CPSR_C) do_cflag(ra, rb, 0);
+      if(liveFlags & CPSR_V) do_vflag(ra, rb, 0);
       return 0;
     }
 
@@ -1533,8 +1808,8 @@ int Thumbulator::execute()
       //fprintf(stderr,"0x%08X 0x%08X\n",ra,rb);
       do_nflag(rc);
       do_zflag(rc);
-      do_cflag(ra, ~rb, 1);
-      do_vflag(ra, ~rb, 1);
+      if(liveFlags & CPSR_C) do_cflag(ra, ~rb, 1);
+      if(liveFlags & CPSR_V) do_vflag(ra, ~rb, 1);
       return 0;
     }
 
@@ -1549,8 +1824,8 @@ int Thumbulator::execute()
       //fprintf(stderr,"0x%08X 0x%08X\n",ra,rb);
       do_nflag(rc);
       do_zflag(rc);
-      do_cflag(ra, ~rb, 1);
-      do_vflag(ra, ~rb, 1);
+      if(liveFlags & CPSR_C) do_cflag(ra, ~rb, 1);
+      if(liveFlags & CPSR_V) do_vflag(ra, ~rb, 1);
       return 0;
     }
 
@@ -1573,8 +1848,8 @@ int Thumbulator::execute()
       rc = ra - rb;
       do_nflag(rc);
       do_zflag(rc);
-      do_cflag(ra, ~rb, 1);
-      do_vflag(ra, ~rb, 1);
+      if(liveFlags & CPSR_C) do_cflag(ra, ~rb, 1);
+      if(liveFlags & CPSR_V) do_vflag(ra, ~rb, 1);
       return 0;
     }
 
@@ -2000,8 +2275,8 @@ int Thumbulator::execute()
       write_register(rd, rc);
       do_nflag(rc);
       do_zflag(rc);
-      do_cflag(0, ~ra, 1);
-      do_vflag(0, ~ra, 1);
+      if(liveFlags & CPSR_C) do_cflag(0, ~ra, 1);
+      if(liveFlags & CPSR_V) do_vflag(0, ~ra, 1);
       return 0;
     }
 
@@ -2203,13 +2478,13 @@ int Thumbulator::execute()
       do_zflag(rc);
       if(cpsr & CPSR_C)
       {
-        do_cflag(ra, ~rb, 1);
-        do_vflag(ra, ~rb, 1);
+        if(liveFlags & CPSR_C) do_cflag(ra, ~rb, 1);
+        if(liveFlags & CPSR_V) do_vflag(ra, ~rb, 1);
       }
       else
       {
-        do_cflag(ra, ~rb, 0);
-        do_vflag(ra, ~rb, 0);
+        if(liveFlags & CPSR_C) do_cflag(ra, ~rb, 0);
+        if(liveFlags & CPSR_V) do_vflag(ra, ~rb, 0);
       }
       return 0;
     }
@@ -2380,8 +2655,8 @@ int Thumbulator::execute()
       write_register(rd, rc);
       do_nflag(rc);
       do_zflag(rc);
-      do_cflag(ra, ~rb, 1);
-      do_vflag(ra, ~rb, 1);
+      if(liveFlags & CPSR_C) do_cflag(ra, ~rb, 1);
+      if(liveFlags & CPSR_V) do_vflag(ra, ~rb, 1);
       return 0;
     }
 
@@ -2395,8 +2670,8 @@ int Thumbulator::execute()
       write_register(rd, rc);
       do_nflag(rc);
       do_zflag(rc);
-      do_cflag(ra, ~rb, 1);
-      do_vflag(ra, ~rb, 1);
+      if(liveFlags & CPSR_C) do_cflag(ra, ~rb, 1);
+      if(liveFlags & CPSR_V) do_vflag(ra, ~rb, 1);
       return 0;
     }
 
@@ -2412,8 +2687,8 @@ int Thumbulator::execute()
       write_register(rd, rc);
       do_nflag(rc);
       do_zflag(rc);
-      do_cflag(ra, ~rb, 1);
-      do_vflag(ra, ~rb, 1);
+      if(liveFlags & CPSR_C) do_cflag(ra, ~rb, 1);
+      if(liveFlags & CPSR_V) do_vflag(ra, ~rb, 1);
       return 0;
     }
 
@@ -2551,8 +2826,3 @@ int Thumbulator::reset()
 
   return 0;
 }
-
-#ifndef UNSAFE_OPTIMIZATIONS
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool Thumbulator::trapOnFatal = true;
-#endif
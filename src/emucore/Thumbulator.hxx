@@ -26,6 +26,9 @@
 #define THUMBULATOR_HXX
 
 class Cartridge;
+#ifdef DEBUGGER_SUPPORT
+  class ThumbProfiler;
+#endif
 
 #include "bspf.hxx"
 #include "Console.hxx"
@@ -62,8 +65,8 @@ class Thumbulator
 
     Thumbulator(const uInt16* rom_ptr, uInt16* ram_ptr, uInt32 rom_size,
                 const uInt32 c_base, const uInt32 c_start, const uInt32 c_stack,
-                bool traponfatal, Thumbulator::ConfigureFor configurefor,
-                Cartridge* cartridge);
+                bool traponfatal, bool cacheblocks,
+                Thumbulator::ConfigureFor configurefor, Cartridge* cartridge);
 
     /**
       Run the ARM code, and return when finished.  A runtime_error exception is
@@ -89,9 +92,23 @@ class Thumbulator
 
       @param enable  Enable (the default) or disable exceptions on fatal errors
     */
-    static void trapFatalErrors(bool enable) { trapOnFatal = enable; }
+    void trapFatalErrors(bool enable) { trapOnFatal = enable; }
 #endif
 
+    /**
+      Normally the ARM code is executed in basic blocks: straight-line runs
+      of predecoded instructions, which are built the first time their start
+      address is reached and ending with the first instruction which may
+      change the PC.  Blocks built from RAM are dropped whenever that RAM is
+      written to (or may have been written to by the cartridge).
+
+      Disabling the cache fetches and decodes every instruction separately,
+      which is mainly useful to compare against.
+
+      @param enable  Enable (the default) or disable the block cache
+    */
+    void cacheBlocks(bool enable) { blockCache = enable; }
+
     /**
       Inform the Thumbulator class about the console currently in use,
       which is used to accurately determine how many 6507 cycles have
@@ -99,6 +116,16 @@ class Thumbulator
     */
     void setConsoleTiming(ConsoleTiming timing);
 
+#ifdef DEBUGGER_SUPPORT
+    /**
+      Count the instructions and memory cycles of the ARM code in the given
+      profiler, or stop profiling when it is the null pointer.  While
+      profiling, the instructions are executed one by one (without the
+      block cache).
+    */
+    void setProfiler(ThumbProfiler* prof) { profiler = prof; }
+#endif
+
   private:
 
     enum class Op : uInt8 {
@@ -151,7 +178,34 @@ class Thumbulator
       uxth
     };
 
+    // An instruction of a basic block; 'flags' contains the C and V flags
+    // (shifted down by 24 bits) which are still read after the instruction
+    // has executed, all others need not be computed
+    struct BlockOp {
+      Op op{Op::invalid};
+      uInt8 flags{0};
+      uInt16 inst{0};
+    };
+
+    struct Block {
+      uInt32 start{0};  // halfword index of the first instruction
+      uInt32 first{0};  // index of the first instruction in 'ops'
+      uInt32 size{0};   // number of instructions
+    };
+
+    struct BlockCache {
+      vector<uInt32> index;  // block number + 1 for each halfword, 0 if none
+      vector<Block> blocks;
+      vector<BlockOp> ops;
+    };
+
+    // The longest straight-line run of instructions put into a single block
+    static constexpr uInt32 MAX_BLOCK_SIZE = 256;
+
   private:
+    // Compares the block cache with the interpreter ('make check')
+    friend class ThumbulatorCheck;
+
     uInt32 read_register(uInt32 reg);
     void write_register(uInt32 reg, uInt32 data);
     uInt32 fetch16(uInt32 addr);
@@ -184,8 +238,25 @@ class Thumbulator
     void dump_regs();
 #endif
     int execute();
+    int execute(Op decodedOp, uInt32 inst, uInt32 pc, uInt32 liveFlags);
+    int executeBlock();
+#ifdef DEBUGGER_SUPPORT
+    int executeProfiled();
+#endif
+    uInt32 buildBlock(BlockCache& cache, const uInt16* code, uInt32 start,
+                      uInt32 end, bool predecoded);
+#ifndef UNSAFE_OPTIMIZATIONS
+    void clearRamBlocks();
+#endif
     int reset();
 
+    static bool endsBlock(Op op, uInt16 inst);
+    static uInt32 flagsWritten(Op op);
+    static uInt32 flagsRead(Op op);
+#ifndef UNSAFE_OPTIMIZATIONS
+    static bool writesMemory(Op op);
+#endif
+
   private:
     const uInt16* rom{nullptr};
     uInt32 romSize{0};
@@ -194,6 +265,13 @@ class Thumbulator
     uInt32 cStack{0};
     const unique_ptr<Op[]> decodedRom;  // NOLINT
     uInt16* ram{nullptr};
+    bool blockCache{true};
+    BlockCache romBlocks;
+#ifndef UNSAFE_OPTIMIZATIONS
+    BlockCache ramBlocks;
+    ByteArray ramCode;  // nonzero for each RAM halfword inside a cached block
+    bool ramCodeModified{false};
+#endif
     std::array<uInt32, 16> reg_norm; // normal execution mode, do not have a thread mode
     uInt32 cpsr{0}, mamcr{0};
     bool handler_mode{false};
@@ -215,13 +293,17 @@ class Thumbulator
 #ifndef UNSAFE_OPTIMIZATIONS
     ostringstream statusMsg;
 
-    static bool trapOnFatal;
+    bool trapOnFatal{true};
 #endif
 
     ConfigureFor configuration;
 
     Cartridge* myCartridge;
 
+#ifdef DEBUGGER_SUPPORT
+    ThumbProfiler* profiler{nullptr};
+#endif
+
   private:
     // Following constructors and assignment operators not supported
     Thumbulator() = delete;
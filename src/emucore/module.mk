@@ -81,6 +81,8 @@ MODULE_OBJS := \
         src/emucore/Props.o \
         src/emucore/PropsSet.o \
         src/emucore/QuadTari.o \
+        src/emucore/RomMetadataCache.o \
+        src/emucore/RomImage.o \
         src/emucore/SaveKey.o \
         src/emucore/Serializer.o \
         src/emucore/Settings.o \
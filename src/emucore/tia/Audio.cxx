@@ -61,23 +61,25 @@ void Audio::setAudioQueue(const shared_ptr<AudioQueue>& queue)
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-void Audio::tick()
+void Audio::tick(uInt32 clocks)
 {
-  switch (myCounter) {
-    case 9:
-    case 81:
-      myChannel0.phase0();
-      myChannel1.phase0();
-
-      break;
-
-    case 37:
-    case 149:
-      phase1();
-      break;
+  while (clocks > 0) {
+    // Clocks until the next counter value handled in tick()
+    const uInt32 idle =
+      myCounter <= 9   ? 9 - myCounter :
+      myCounter <= 37  ? 37 - myCounter :
+      myCounter <= 81  ? 81 - myCounter :
+      myCounter <= 149 ? 149 - myCounter : 228 + 9 - myCounter;
+    const uInt32 skip = std::min(clocks, idle);
+
+    myCounter = (myCounter + skip) % 228;
+    clocks -= skip;
+
+    if (clocks > 0) {
+      tick();
+      --clocks;
+    }
   }
-
-  if (++myCounter == 228) myCounter = 0;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -86,7 +88,7 @@ void Audio::phase1()
   uInt8 sample0 = myChannel0.phase1();
   uInt8 sample1 = myChannel1.phase1();
 
-  if (!myAudioQueue) return;
+  if (!myAudioQueue || mySuspended) return;
 
   if (myAudioQueue->isStereo()) {
     myCurrentFragment[2*mySampleIndex] = myMixingTableIndividual[sample0];
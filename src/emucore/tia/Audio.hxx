@@ -33,7 +33,19 @@ class Audio : public Serializable
 
     void setAudioQueue(const shared_ptr<AudioQueue>& queue);
 
-    void tick();
+    /**
+      Stop (or resume) passing samples to the audio queue.  The channels are
+      still clocked, so the emulated state is not affected.
+    */
+    void suspend(bool suspended) { mySuspended = suspended; }
+
+    inline void tick();
+
+    /**
+      Equivalent to the given number of calls to tick(), but skips ahead to
+      the counter values that actually do something.
+    */
+    void tick(uInt32 clocks);
 
     AudioChannel& channel0();
 
@@ -62,6 +74,8 @@ class Audio : public Serializable
     Int16* myCurrentFragment{nullptr};
     uInt32 mySampleIndex{0};
 
+    bool mySuspended{false};
+
   private:
     Audio(const Audio&) = delete;
     Audio(Audio&&) = delete;
@@ -69,4 +83,28 @@ class Audio : public Serializable
     Audio& operator=(Audio&&) = delete;
 };
 
+// ############################################################################
+// Implementation
+// ############################################################################
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void Audio::tick()
+{
+  switch (myCounter) {
+    case 9:
+    case 81:
+      myChannel0.phase0();
+      myChannel1.phase0();
+
+      break;
+
+    case 37:
+    case 149:
+      phase1();
+      break;
+  }
+
+  if (++myCounter == 228) myCounter = 0;
+}
+
 #endif // TIA_AUDIO_HXX
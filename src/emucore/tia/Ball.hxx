@@ -174,6 +174,17 @@ class Ball : public Serializable
      */
     inline void tick(bool isReceivingRegularClock = true);
 
+    /**
+      The number of clocks (up to maxClocks) during which the ball stays
+      invisible and tick() does nothing but advance the counter.
+     */
+    inline uInt32 idleClocks(uInt32 maxClocks) const;
+
+    /**
+      Equivalent to that many calls of tick() while idle (see above).
+     */
+    inline void skipClocks(uInt32 clocks);
+
   public:
 
     /**
@@ -412,4 +423,24 @@ void Ball::tick(bool isReceivingRegularClock)
       myCounter = 0;
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+uInt32 Ball::idleClocks(uInt32 maxClocks) const
+{
+  if (myIsRendering || isMoving || (myUseInvertedPhaseClock && myInvertedPhaseClock))
+    return 0;
+
+  // Rendering starts once the counter reaches its decode value
+  const uInt32 clocks = (156 + TIAConstants::H_PIXEL - myCounter) % TIAConstants::H_PIXEL;
+
+  return std::min(clocks, maxClocks);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void Ball::skipClocks(uInt32 clocks)
+{
+  mySignalActive = false;
+  collision = myCollisionMaskDisabled;
+  myCounter = (myCounter + clocks) % TIAConstants::H_PIXEL;
+}
+
 #endif // TIA_BALL
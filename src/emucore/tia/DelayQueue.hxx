@@ -43,6 +43,17 @@ class DelayQueue : public Serializable
 
     template<typename T> void execute(T executor);
 
+    /**
+      The number of clocks (up to maxClocks) for which execute() would be a
+      no-op, i.e. until the next queued write is due.
+     */
+    uInt32 idleClocks(uInt32 maxClocks) const;
+
+    /**
+      Advance by the given number of idle clocks (see above).
+     */
+    void skip(uInt32 clocks);
+
     /**
       Serializable methods (see that class for more information).
     */
@@ -118,6 +129,24 @@ void DelayQueue<length, capacity>::execute(T executor)
   myIndex = smartmod<length>(myIndex + 1);
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+template<unsigned length, unsigned capacity>
+uInt32 DelayQueue<length, capacity>::idleClocks(uInt32 maxClocks) const
+{
+  for (uInt32 i = 0; i < std::min<uInt32>(maxClocks, length); ++i)
+    if (myMembers[smartmod<length>(myIndex + i)].mySize) return i;
+
+  // Nothing is queued at all if we looked at all members
+  return maxClocks;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+template<unsigned length, unsigned capacity>
+void DelayQueue<length, capacity>::skip(uInt32 clocks)
+{
+  myIndex = (myIndex + clocks) % length;
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 template<unsigned length, unsigned capacity>
 bool DelayQueue<length, capacity>::save(Serializer& out) const
@@ -80,6 +80,17 @@ class Missile : public Serializable
 
     inline void tick(uInt8 hclock, bool isReceivingMclock = true);
 
+    /**
+      The number of clocks (up to maxClocks) during which the missile stays
+      invisible and tick() does nothing but advance the counter.
+     */
+    inline uInt32 idleClocks(uInt32 maxClocks) const;
+
+    /**
+      Equivalent to that many calls of tick() while idle (see above).
+     */
+    inline void skipClocks(uInt32 clocks);
+
   public:
 
     uInt32 collision{0};
@@ -198,4 +209,30 @@ void Missile::tick(uInt8 hclock, bool isReceivingMclock)
   if (++myCounter >= TIAConstants::H_PIXEL) myCounter = 0;
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+uInt32 Missile::idleClocks(uInt32 maxClocks) const
+{
+  if (myIsRendering || isMoving || (myUseInvertedPhaseClock && myInvertedPhaseClock))
+    return 0;
+
+  // While locked to the player, the missile never starts rendering
+  if (myResmp) return maxClocks;
+
+  // Copies can only start at these counter values (see DrawCounterDecodes)
+  uInt32 clocks = maxClocks;
+  for (uInt8 decode : {12, 28, 60, 156})
+    if (myDecodes[decode])
+      clocks = std::min<uInt32>(clocks, (decode + TIAConstants::H_PIXEL - myCounter) % TIAConstants::H_PIXEL);
+
+  return clocks;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void Missile::skipClocks(uInt32 clocks)
+{
+  myIsVisible = false;
+  collision = myCollisionMaskDisabled;
+  myCounter = (myCounter + clocks) % TIAConstants::H_PIXEL;
+}
+
 #endif // TIA_MISSILE
@@ -91,6 +91,17 @@ class Player : public Serializable
 
     inline void tick();
 
+    /**
+      The number of clocks (up to maxClocks) during which the player stays
+      invisible and tick() does nothing but advance the counter.
+     */
+    inline uInt32 idleClocks(uInt32 maxClocks) const;
+
+    /**
+      Equivalent to that many calls of tick() while idle (see above).
+     */
+    inline void skipClocks(uInt32 clocks);
+
   public:
 
     uInt32 collision{0};
@@ -215,4 +226,26 @@ void Player::tick()
   if (++myCounter >= TIAConstants::H_PIXEL) myCounter = 0;
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+uInt32 Player::idleClocks(uInt32 maxClocks) const
+{
+  if (myIsRendering || isMoving || (myUseInvertedPhaseClock && myInvertedPhaseClock))
+    return 0;
+
+  // Copies can only start at these counter values (see DrawCounterDecodes)
+  uInt32 clocks = maxClocks;
+  for (uInt8 decode : {12, 28, 60, 156})
+    if (myDecodes[decode])
+      clocks = std::min<uInt32>(clocks, (decode + TIAConstants::H_PIXEL - myCounter) % TIAConstants::H_PIXEL);
+
+  return clocks;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void Player::skipClocks(uInt32 clocks)
+{
+  collision = myCollisionMaskDisabled;
+  myCounter = (myCounter + clocks) % TIAConstants::H_PIXEL;
+}
+
 #endif // TIA_PLAYER
@@ -84,6 +84,7 @@ TIA::TIA(ConsoleIO& console, const ConsoleTimingProvider& timingProvider,
   myMissile1.setTIA(this);
   myBall.setTIA(this);
 
+  setupPixelLookup();
   initialize();
 }
 
@@ -158,6 +159,7 @@ void TIA::initialize()
   myAudio.reset();
 
   myTimestamp = 0;
+  mySpanTimestamp = 0;
   for (PaddleReader& paddleReader : myPaddleReaders)
     paddleReader.reset(myTimestamp);
 
@@ -179,6 +181,7 @@ void TIA::initialize()
   myBackBuffer.fill(0);
   myFrontBuffer.fill(0);
   myFramebuffer.fill(0);
+  invalidateFrameBuffer();
 
   applyDeveloperSettings();
 
@@ -350,10 +353,12 @@ bool TIA::load(Serializer& in)
 
     mySpriteEnabledBits = in.getByte();
     myCollisionsEnabledBits = in.getByte();
+    setupPixelLookup();
 
     myColorHBlank = in.getByte();
 
     myTimestamp = in.getLong();
+    mySpanTimestamp = 0;
 
     in.getByteArray(myShadowRegisters.data(), myShadowRegisters.size());
 
@@ -905,6 +910,7 @@ bool TIA::loadDisplay(Serializer& in)
     in.getByteArray(myBackBuffer.data(), myBackBuffer.size());
     in.getByteArray(myFrontBuffer.data(), myFrontBuffer.size());
     myFramesSinceLastRender = in.getInt();
+    invalidateFrameBuffer();
   }
   catch(...)
   {
@@ -980,16 +986,57 @@ void TIA::renderToFrameBuffer()
 
   myFramesSinceLastRender = 0;
 
-  myFramebuffer = myFrontBuffer;
+  copyToFrameBuffer(myFrontBuffer.data());
 
   myFrameBufferScanlines = myFrontBufferScanlines;
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void TIA::renderToFrameBuffer(const TIA& source)
+{
+  myFramesSinceLastRender = 0;
+
+  copyToFrameBuffer(source.myFrontBuffer.data());
+
+  myFrameBufferScanlines = source.myFrontBufferScanlines;
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void TIA::clearFrameBuffer()
 {
   myFramebuffer.fill(0);
   myFrontBuffer.fill(0);
+  invalidateFrameBuffer();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void TIA::copyToFrameBuffer(const uInt8* frame)
+{
+  // Most games redraw the same image (or most of it) every frame, so
+  // comparing the lines while copying lets the consumers of the
+  // framebuffer skip the unchanged ones
+  uInt8* line = myFramebuffer.data();
+
+  for(uInt32 y = 0; y < TIAConstants::frameBufferHeight; ++y)
+  {
+    const bool changed = std::memcmp(line, frame, TIAConstants::H_PIXEL) != 0;
+
+    if(changed)
+      std::copy_n(frame, TIAConstants::H_PIXEL, line);
+
+    myDirtyScanlines[y] = changed;
+    line += TIAConstants::H_PIXEL;
+    frame += TIAConstants::H_PIXEL;
+  }
+
+  ++myFrameBufferRevision;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void TIA::invalidateFrameBuffer()
+{
+  myDirtyScanlines.set();
+  ++myFrameBufferRevision;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -1114,6 +1161,8 @@ bool TIA::toggleCollision(TIABit b, uInt8 mode)
   myBall.toggleCollisions(myCollisionsEnabledBits & TIABit::BLBit);
   myPlayfield.toggleCollisions(myCollisionsEnabledBits & TIABit::PFBit);
 
+  setupPixelLookup();
+
   return mask;
 }
 
@@ -1297,6 +1346,8 @@ uInt8 TIA::registerValue(uInt8 reg) const
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void TIA::updateEmulation()
 {
+  SubsystemTimer::Scope timing(mySystem->subsystemTimer(), SubsystemTimer::Subsystem::tia);
+
   const uInt64 systemCycles = mySystem->cycles();
 
   if (mySubClock > TIAConstants::CYCLE_CLOCKS - 1)
@@ -1378,6 +1429,17 @@ void TIA::cycle(uInt32 colorClocks)
 {
   for (uInt32 i = 0; i < colorClocks; ++i)
   {
+    if (myHstate == HState::frame && myLinesSinceChange < 2 && !myMovementInProgress &&
+        myTimestamp >= mySpanTimestamp)
+    {
+      const uInt32 clocks = renderSpan(colorClocks - i);
+
+      if (clocks > 0) {
+        i += clocks - 1;
+        continue;
+      }
+    }
+
     myDelayQueue.execute(
       [this] (uInt8 address, uInt8 value) {delayedWrite(address, value);}
     );
@@ -1388,12 +1450,13 @@ void TIA::cycle(uInt32 colorClocks)
     if (myLinesSinceChange < 2) {
       tickMovement();
 
-      if (myHstate == HState::blank)
+      if (myHstate == HState::blank) {
         tickHblank();
+
+        if (myCollisionUpdateRequired && !myFrameManager->vblank()) updateCollision();
+      }
       else
         tickHframe();
-
-      if (myCollisionUpdateRequired && !myFrameManager->vblank()) updateCollision();
     }
 
     if (++myHctr >= TIAConstants::H_CLOCKS)
@@ -1470,8 +1533,86 @@ void TIA::tickHframe()
   myPlayer1.tick();
   myBall.tick();
 
+  // Collisions and priority are resolved by the same lookup
+  const PixelLookup& pixel = myPixelLookup[static_cast<uInt8>(myPriority)][visibleObjects()];
+
+  if (!myFrameManager->vblank()) myCollisionMask |= pixel.collision;
+
   if (myFrameManager->isRendering())
-    renderPixel(x, y);
+    renderPixel(x, y, pixel.color);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+uInt32 TIA::renderSpan(uInt32 maxClocks)
+{
+  // The last clock of the line is left to cycle(), as it starts a new line.
+  // After RSYNC, x is off by myHctrDelta, so we leave that line alone, too.
+  uInt32 clocks = myHctrDelta == 0 ?
+    std::min<uInt32>(maxClocks, TIAConstants::H_CLOCKS - 1 - myHctr) : 0;
+
+  if (clocks > 0) clocks = myBall.idleClocks(clocks);
+  if (clocks > 0) clocks = myMissile0.idleClocks(clocks);
+  if (clocks > 0) clocks = myMissile1.idleClocks(clocks);
+  if (clocks > 0) clocks = myPlayer0.idleClocks(clocks);
+  if (clocks > 0) clocks = myPlayer1.idleClocks(clocks);
+  if (clocks == 0) {
+    // Visible objects usually stay visible for a couple of clocks, so there
+    // is no point in checking again right away
+    mySpanTimestamp = myTimestamp + 4;
+    return 0;
+  }
+
+  clocks = myDelayQueue.idleClocks(clocks);
+  if (clocks == 0) return 0;
+
+  myMissile0.skipClocks(clocks);
+  myMissile1.skipClocks(clocks);
+  myPlayer0.skipClocks(clocks);
+  myPlayer1.skipClocks(clocks);
+  myBall.skipClocks(clocks);
+
+  // Without any sprites, the pixels are determined by the playfield and the
+  // background. The playfield changes every four pixels at most.
+  const uInt32 xStart = myHctr - TIAConstants::H_BLANK_CLOCKS;
+  const uInt32 xEnd = xStart + clocks;
+  const bool vblank = myFrameManager->vblank();
+  const bool rendering = myFrameManager->isRendering();
+  uInt8* line = rendering ?
+    myBackBuffer.data() + myFrameManager->getY() * TIAConstants::H_PIXEL : nullptr;
+  uInt32 runStart = xStart;
+  uInt8 runColor = 0;
+
+  for (uInt32 x = xStart; x < xEnd; x = (x | 0x03) + 1)
+  {
+    myPlayfield.tick(x);
+    if (!vblank) updateCollision();
+
+    const uInt8 color = vblank ? 0 :
+      myPlayfield.isOn() ? myPlayfield.getColor() : myBackground.getColor();
+
+    if (color != runColor) {
+      if (rendering) std::fill(line + runStart, line + x, runColor);
+      runStart = x;
+      runColor = color;
+    }
+  }
+  if (rendering) std::fill(line + runStart, line + xEnd, runColor);
+
+  // Only updates the position within the current four pixels
+  myPlayfield.tick(xEnd - 1);
+
+  myDelayQueue.skip(clocks);
+  myCollisionUpdateRequired = true;
+  myCollisionUpdateScheduled = false;
+  myHctr += clocks;
+
+  #ifdef SOUND_SUPPORT
+    myAudio.tick(clocks);
+  #endif
+
+  myTimestamp += clocks;
+
+  return clocks;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -1533,70 +1674,101 @@ void TIA::scheduleCollisionUpdate()
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void TIA::updateCollision()
 {
-  myCollisionMask |= (
-    myPlayer0.collision &
-    myPlayer1.collision &
-    myMissile0.collision &
-    myMissile1.collision &
-    myBall.collision &
-    myPlayfield.collision
-  );
+  // The collision bits are the same for all priority modes
+  myCollisionMask |= myPixelLookup[0][visibleObjects()].collision;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-void TIA::renderPixel(uInt32 x, uInt32 y)
+uInt8 TIA::visibleObjects() const
 {
-  if (x >= TIAConstants::H_PIXEL) return;
+  return
+    (myPlayer0.isOn()   ? TIABit::P0Bit : 0) |
+    (myMissile0.isOn()  ? TIABit::M0Bit : 0) |
+    (myPlayer1.isOn()   ? TIABit::P1Bit : 0) |
+    (myMissile1.isOn()  ? TIABit::M1Bit : 0) |
+    (myBall.isOn()      ? TIABit::BLBit : 0) |
+    (myPlayfield.isOn() ? TIABit::PFBit : 0);
+}
 
-  uInt8 color = 0;
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void TIA::setupPixelLookup()
+{
+  // The objects in the order of their TIABit
+  static constexpr std::array<uInt32, 6> collisionMasks = {
+    CollisionMask::player0, CollisionMask::missile0, CollisionMask::player1,
+    CollisionMask::missile1, CollisionMask::ball, CollisionMask::playfield
+  };
 
-  if (!myFrameManager->vblank())
+  // Indexed by TIAColor
+  static constexpr std::array<uInt8, 7> colorBits = {
+    0, TIABit::PFBit, TIABit::P0Bit, TIABit::P1Bit, TIABit::M0Bit, TIABit::M1Bit, TIABit::BLBit
+  };
+
+  // The objects in the order of their priority, from highest to lowest:
+  //  - pfp (CTRLPF D2=1, D1=ignored):
+  //      BL/PF => P0/M0 => P1/M1 => BK
+  //    Playfield has priority so ScoreBit isn't used
+  //  - score (CTRLPF D2=0, D1=1):
+  //      PF/P0/M0 => P1/M1 => BL => BK
+  //    for the first half and
+  //      P0/M0 => PF/P1/M1 => BL => BK
+  //    for the second half. However, the first ordering is equivalent to the
+  //    second (PF has the same color as P0/M0), so we can just use the latter.
+  //  - normal (CTRLPF D2=0, D1=0):
+  //      P0/M0 => P1/M1 => BL/PF => BK
+  static constexpr BSPF::array2D<uInt8, 3, 6> priorities = {{
+    { PFColor, BLColor, P0Color, M0Color, P1Color, M1Color },
+    { P0Color, M0Color, PFColor, P1Color, M1Color, BLColor },
+    { P0Color, M0Color, P1Color, M1Color, PFColor, BLColor }
+  }};
+
+  for (uInt32 objects = 0; objects < 64; ++objects)
   {
-    switch (myPriority)
+    // Visible objects whose collisions are turned off (see toggleCollision)
+    // only contribute their visibility bit
+    uInt32 collision = 0xFFFF;
+    for (uInt32 i = 0; i < 6; ++i)
     {
-      case Priority::pfp:  // CTRLPF D2=1, D1=ignored
-        // Playfield has priority so ScoreBit isn't used
-        // Priority from highest to lowest:
-        //   BL/PF => P0/M0 => P1/M1 => BK
-        if (myPlayfield.isOn())       color = myPlayfield.getColor();
-        else if (myBall.isOn())       color = myBall.getColor();
-        else if (myPlayer0.isOn())    color = myPlayer0.getColor();
-        else if (myMissile0.isOn())   color = myMissile0.getColor();
-        else if (myPlayer1.isOn())    color = myPlayer1.getColor();
-        else if (myMissile1.isOn())   color = myMissile1.getColor();
-        else                          color = myBackground.getColor();
-        break;
+      const uInt32 disabled = ~collisionMasks[i] & 0x7FFF;
+      const uInt32 enabled = (myCollisionsEnabledBits & (1 << i)) ? 0xFFFF : (0x8000 | disabled);
 
-      case Priority::score:  // CTRLPF D2=0, D1=1
-        // Formally we have (priority from highest to lowest)
-        //   PF/P0/M0 => P1/M1 => BL => BK
-        // for the first half and
-        //   P0/M0 => PF/P1/M1 => BL => BK
-        // for the second half. However, the first ordering is equivalent
-        // to the second (PF has the same color as P0/M0), so we can just
-        // write
-        if (myPlayer0.isOn())         color = myPlayer0.getColor();
-        else if (myMissile0.isOn())   color = myMissile0.getColor();
-        else if (myPlayfield.isOn())  color = myPlayfield.getColor();
-        else if (myPlayer1.isOn())    color = myPlayer1.getColor();
-        else if (myMissile1.isOn())   color = myMissile1.getColor();
-        else if (myBall.isOn())       color = myBall.getColor();
-        else                          color = myBackground.getColor();
-        break;
+      collision &= (objects & (1 << i)) ? enabled : disabled;
+    }
 
-      case Priority::normal:  // CTRLPF D2=0, D1=0
-        // Priority from highest to lowest:
-        //   P0/M0 => P1/M1 => BL/PF => BK
-        if (myPlayer0.isOn())         color = myPlayer0.getColor();
-        else if (myMissile0.isOn())   color = myMissile0.getColor();
-        else if (myPlayer1.isOn())    color = myPlayer1.getColor();
-        else if (myMissile1.isOn())   color = myMissile1.getColor();
-        else if (myPlayfield.isOn())  color = myPlayfield.getColor();
-        else if (myBall.isOn())       color = myBall.getColor();
-        else                          color = myBackground.getColor();
-        break;
+    for (uInt32 priority = 0; priority < 3; ++priority)
+    {
+      uInt8 color = BKColor;
+      for (uInt8 object : priorities[priority])
+        if (objects & colorBits[object])
+        {
+          color = object;
+          break;
+        }
+
+      myPixelLookup[priority][objects] = { collision, color };
     }
   }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void TIA::renderPixel(uInt32 x, uInt32 y, uInt8 object)
+{
+  if (x >= TIAConstants::H_PIXEL) return;
+
+  uInt8 color = 0;
+
+  if (!myFrameManager->vblank())
+  {
+    // Indexed by TIAColor
+    const std::array<uInt8, 7> colors = {
+      myBackground.getColor(), myPlayfield.getColor(),
+      myPlayer0.getColor(), myPlayer1.getColor(),
+      myMissile0.getColor(), myMissile1.getColor(),
+      myBall.getColor()
+    };
+
+    color = colors[object];
+  }
 
   myBackBuffer[y * TIAConstants::H_PIXEL + x] = color;
 }
@@ -18,6 +18,7 @@
 #ifndef TIA_TIA
 #define TIA_TIA
 
+#include <bitset>
 #include <functional>
 
 #include "bspf.hxx"
@@ -62,6 +63,11 @@ class DispatchResult;
 class TIA : public Device
 {
   public:
+    /**
+     * One bit per framebuffer scanline, see dirtyScanlines().
+     */
+    using ScanlineMask = std::bitset<TIAConstants::frameBufferHeight>;
+
     /**
      * These dummy register addresses are used to represent the delayed
      * old / new register swap on writing GRPx and ENABL in the DelayQueue (see below).
@@ -131,6 +137,12 @@ class TIA : public Device
     */
     void setAudioQueue(const shared_ptr<AudioQueue>& audioQueue);
 
+    /**
+      Stop (or resume) generating audio samples, e.g. while emulating frames
+      that will be rolled back again.
+    */
+    void suspendAudio(bool suspended) { myAudio.suspend(suspended); }
+
     /**
       Clear the configured frame manager and deteach the lifecycle callbacks.
      */
@@ -233,6 +245,12 @@ class TIA : public Device
      */
     void renderToFrameBuffer();
 
+    /**
+      Render the last complete frame of another TIA to the framebuffer and
+      clear the pending frame flag (used by the run-ahead second instance).
+    */
+    void renderToFrameBuffer(const TIA& source);
+
     /**
       Return the buffer that holds the currently drawing TIA frame
       (the TIA output widget needs this).
@@ -244,6 +262,20 @@ class TIA : public Device
     */
     uInt8* frameBuffer() { return myFramebuffer.data(); }
 
+    /**
+      Answers a counter that is increased whenever the framebuffer changes.
+      A consumer that is up to date with revision n can catch up with
+      revision n + 1 by redrawing the dirty scanlines only; after any other
+      change of the revision it has to redraw everything.
+    */
+    uInt32 frameBufferRevision() const { return myFrameBufferRevision; }
+
+    /**
+      Answers which scanlines of the framebuffer differ between the current
+      and the previous revision.
+    */
+    const ScanlineMask& dirtyScanlines() const { return myDirtyScanlines; }
+
     void clearFrameBuffer();
 
     /**
@@ -571,11 +603,20 @@ class TIA : public Device
     enum class HState {blank, frame};
 
     /**
-     * The three different modes of the priority encoder. Check TIA::renderPixel
-     * for a precise definition.
+     * The three different modes of the priority encoder. Check
+     * TIA::setupPixelLookup for a precise definition.
      */
     enum class Priority {pfp, score, normal};
 
+    /**
+     * The outcome of the priority encoder and the collision detection for a
+     * combination of visible objects.
+     */
+    struct PixelLookup {
+      uInt32 collision;  // the bits to set in myCollisionMask
+      uInt8 color;       // the TIAColor of the object that is displayed
+    };
+
     /**
      * Palette and indices for fixed debug colors.
      */
@@ -589,6 +630,16 @@ class TIA : public Device
      */
     void initialize();
 
+    /**
+     * Copy a frame to the framebuffer, marking the scanlines that change.
+     */
+    void copyToFrameBuffer(const uInt8* frame);
+
+    /**
+     * Mark the whole framebuffer as changed.
+     */
+    void invalidateFrameBuffer();
+
     /**
      * This callback is invoked by FrameManager when a new frame starts.
      */
@@ -626,20 +677,40 @@ class TIA : public Device
      */
     void tickHframe();
 
+    /**
+     * Advance over a run of clocks (up to maxClocks) of the visible part of
+     * the scanline during which no sprite is visible, nothing is moving and no
+     * write is pending, and render the pixels in one go. Returns the number of
+     * clocks processed; zero means that the next clock must be processed as
+     * usual.
+     */
+    uInt32 renderSpan(uInt32 maxClocks);
+
     /**
      * Update the collision bitfield.
      */
     void updateCollision();
 
+    /**
+     * The TIABit flags of all objects that are currently visible.
+     */
+    uInt8 visibleObjects() const;
+
+    /**
+     * Set up myPixelLookup (depends on the enabled collisions).
+     */
+    void setupPixelLookup();
+
     /**
      * Execute a RSYNC.
      */
     void applyRsync();
 
     /**
-     * Render the current pixel into the framebuffer.
+     * Render the current pixel into the framebuffer, using the color of the
+     * given object (a TIAColor).
      */
-    void renderPixel(uInt32 x, uInt32 y);
+    void renderPixel(uInt32 x, uInt32 y, uInt8 object);
 
     /**
      * Clear the first 8 pixels of a scanline with black if we are in hblank
@@ -819,6 +890,11 @@ class TIA : public Device
     // Frames since the last time a frame was rendered to the render buffer
     uInt32 myFramesSinceLastRender{0};
 
+    // Increased on every change of the framebuffer, which affects the
+    // scanlines in myDirtyScanlines (see frameBufferRevision())
+    uInt32 myFrameBufferRevision{0};
+    ScanlineMask myDirtyScanlines;
+
     /**
      * Setting this to true injects random values into undefined reads.
      */
@@ -890,6 +966,12 @@ class TIA : public Device
      */
     Priority myPriority{Priority::normal};
 
+    /**
+     * Pixel color and collisions for each priority mode and each combination
+     * of visible objects (see visibleObjects()).
+     */
+    BSPF::array2D<PixelLookup, 3, 64> myPixelLookup;
+
     /**
      * The index of the last CPU cycle that was included in the simulation.
      */
@@ -917,6 +999,12 @@ class TIA : public Device
      */
     uInt64 myTimestamp{0};
 
+    /**
+     * The timestamp before which renderSpan() is not tried again (it failed
+     * recently because of a visible object).
+     */
+    uInt64 mySpanTimestamp{0};
+
     /**
      * The number of CPU clocks since the last dump ports state change.
      */
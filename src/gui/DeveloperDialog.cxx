@@ -477,7 +477,7 @@ void DeveloperDialog::addTimeMachineTab(const GUI::Font& font)
 
   int xpos = HBORDER,
       ypos = VBORDER,
-      lwidth = fontWidth * 11;
+      lwidth = fontWidth * 12;
   WidgetArray wid;
   VariantList items;
   int tabID = myTab->addTab(" Time Machine ", TabWidget::AUTO_WIDTH);
@@ -507,7 +507,7 @@ void DeveloperDialog::addTimeMachineTab(const GUI::Font& font)
 #ifdef RETRON77
   myStateSizeWidget->setMaxValue(100);
 #else
-  myStateSizeWidget->setMaxValue(1000);
+  myStateSizeWidget->setMaxValue(RewindManager::MAX_BUF_SIZE);
 #endif
   myStateSizeWidget->setStepValue(20);
   myStateSizeWidget->setTickmarkIntervals(5);
@@ -521,7 +521,7 @@ void DeveloperDialog::addTimeMachineTab(const GUI::Font& font)
 #ifdef RETRON77
   myUncompressedWidget->setMaxValue(100);
 #else
-  myUncompressedWidget->setMaxValue(1000);
+  myUncompressedWidget->setMaxValue(RewindManager::MAX_BUF_SIZE);
 #endif
   myUncompressedWidget->setStepValue(20);
   myUncompressedWidget->setTickmarkIntervals(5);
@@ -83,6 +83,7 @@ void FileListWidget::setLocation(const FilesystemNode& node,
 
   // Read in the data from the file system (start with an empty list)
   _fileList.clear();
+  ++_listingCount;
 
   if(_includeSubDirs)
   {
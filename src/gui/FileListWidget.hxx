@@ -88,6 +88,11 @@ class FileListWidget : public StringListWidget
     }
     const FilesystemNode& currentDir() const { return _node; }
 
+    /** Gets all nodes of the current listing, and a counter which is
+        incremented each time the listing is read again */
+    const FSList& fileList() const { return _fileList; }
+    uInt32 listingCount() const { return _listingCount; }
+
     static void setQuickSelectDelay(uInt64 time) { _QUICK_SELECT_DELAY = time; }
     uInt64 getQuickSelectDelay() { return _QUICK_SELECT_DELAY; }
 
@@ -112,6 +117,7 @@ class FileListWidget : public StringListWidget
     FilesystemNode::NameFilter _filter;
     FilesystemNode _node;
     FSList _fileList;
+    uInt32 _listingCount{0};
     bool _includeSubDirs{false};
 
     StringList _dirList;
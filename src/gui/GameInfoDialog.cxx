@@ -706,7 +706,7 @@ void GameInfoDialog::loadEmulationProperties(const Properties& props)
     else
     {
       const FilesystemNode& node = FilesystemNode(instance().launcher().selectedRom());
-      ByteBuffer image;
+      RomImage image;
       string md5 = props.get(PropType::Cart_MD5);
       size_t size = 0;
 
@@ -1090,7 +1090,7 @@ void GameInfoDialog::updateControllerStates()
 {
   bool swapPorts = mySwapPorts->getState();
   bool autoDetect = false;
-  ByteBuffer image;
+  RomImage image;
   string md5 = myGameProperties.get(PropType::Cart_MD5);
   size_t size = 0;
 
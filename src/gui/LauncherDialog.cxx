@@ -24,7 +24,6 @@
 #include "EditTextWidget.hxx"
 #include "FileListWidget.hxx"
 #include "FSNode.hxx"
-#include "MD5.hxx"
 #include "OptionsDialog.hxx"
 #include "HighScoresDialog.hxx"
 #include "HighScoresManager.hxx"
@@ -42,7 +41,9 @@
 #include "StellaKeys.hxx"
 #include "Props.hxx"
 #include "PropsSet.hxx"
+#include "RomMetadataCache.hxx"
 #include "RomInfoWidget.hxx"
+#include "RomScanner.hxx"
 #include "TIAConstants.hxx"
 #include "Settings.hxx"
 #include "Widget.hxx"
@@ -304,6 +305,8 @@ LauncherDialog::LauncherDialog(OSystem& osystem, DialogContainer& parent,
   myGlobalProps = make_unique<GlobalPropsDialog>(this,
     myUseMinimalUI ? osystem.frameBuffer().launcherFont() : osystem.frameBuffer().font());
 
+  myRomScanner = make_unique<RomScanner>(osystem);
+
   // since we cannot know how many files there are, use are really high value here
   myList->progress().setRange(0, 50000, 5);
   myList->progress().setMessage("        Filtering files" + ELLIPSIS + "        ");
@@ -332,9 +335,10 @@ const string& LauncherDialog::selectedRomMD5()
     myMD5List.clear();
 
   // Lookup MD5, and if not present, cache it
+  // The persistent ROM cache avoids rehashing files seen in earlier sessions
   auto iter = myMD5List.find(currentNode().getPath());
   if(iter == myMD5List.end())
-    myMD5List[currentNode().getPath()] = MD5::hash(currentNode());
+    myMD5List[currentNode().getPath()] = instance().romCache().md5(currentNode());
 
   return myMD5List[currentNode().getPath()];
 }
@@ -365,6 +369,20 @@ void LauncherDialog::tick()
   if(myPendingReload && myReloadTime < TimerManager::getTicks() / 1000)
     reload();
 
+  // Scan all ROMs of a new listing in the background (using half of the
+  // cores), so that their information is cached once they are selected
+  if(myScannedListing != myList->listingCount())
+  {
+    myScannedListing = myList->listingCount();
+    myRomScanner->start(myList->fileList(),
+                        std::max(1U, std::thread::hardware_concurrency() / 2));
+  }
+  if(!myRomScanner->finished())
+  {
+    vector<RomScanner::Result> results;
+    myRomScanner->fetchResults(results);
+  }
+
   Dialog::tick();
 }
 
@@ -838,6 +856,10 @@ void LauncherDialog::handleCommand(CommandSender* sender, int cmd,
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void LauncherDialog::loadRom()
 {
+  // Don't compete with the emulation; the scan is restarted on return
+  myRomScanner->cancel();
+  myScannedListing = 0;
+
   const string& result = instance().createConsole(currentNode(), selectedRomMD5());
   if(result == EmptyString)
   {
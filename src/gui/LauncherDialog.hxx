@@ -33,6 +33,7 @@ class Properties;
 class EditTextWidget;
 class FileListWidget;
 class RomInfoWidget;
+class RomScanner;
 class StaticTextWidget;
 namespace Common {
   struct Size;
@@ -192,6 +193,10 @@ class LauncherDialog : public Dialog
     RomInfoWidget*    myRomInfoWidget{nullptr};
     std::unordered_map<string,string> myMD5List;
 
+    // Caches the information of all ROMs in the listing in the background
+    unique_ptr<RomScanner> myRomScanner;
+    uInt32 myScannedListing{0};
+
     int mySelectedItem{0};
 
     bool myShowOnlyROMs{false};
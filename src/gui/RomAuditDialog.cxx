@@ -27,9 +27,9 @@
 #include "MessageBox.hxx"
 #include "OSystem.hxx"
 #include "FrameBuffer.hxx"
-#include "MD5.hxx"
 #include "Props.hxx"
 #include "PropsSet.hxx"
+#include "RomScanner.hxx"
 #include "Settings.hxx"
 #include "RomAuditDialog.hxx"
 
@@ -117,6 +117,11 @@ void RomAuditDialog::auditRoms()
   files.reserve(2048);
   node.getChildren(files, FilesystemNode::ListMode::FilesOnly);
 
+  // Hash the ROMs on all cores in the background; the results are processed
+  // (and the files renamed) here as they come in
+  RomScanner scanner(instance());
+  scanner.start(files);
+
   // Create a progress dialog box to show the progress of processing
   // the ROMs, since this is usually a time-consuming operation
   ostringstream buf;
@@ -124,32 +129,36 @@ void RomAuditDialog::auditRoms()
 
   buf << "Auditing ROM files" << ELLIPSIS;
   progress.setMessage(buf.str());
-  progress.setRange(0, int(files.size()) - 1, 5);
+  progress.setRange(0, int(scanner.numFiles()) - 1, 5);
   progress.open();
 
   Properties props;
   uInt32 renamed = 0, notfound = 0;
-  for(uInt32 idx = 0; idx < files.size() && !progress.isCancelled(); ++idx)
+  vector<RomScanner::Result> results;
+  while(!scanner.finished() && !progress.isCancelled())
   {
-    string extension;
-    if(files[idx].isFile() &&
-       Bankswitch::isValidRomName(files[idx], extension))
+    results.clear();
+    scanner.fetchResults(results, 50);
+
+    for(const auto& result: results)
     {
       bool renameSucceeded = false;
+      string extension;
 
-      // Calculate the MD5 so we can get the rest of the info
-      // from the PropertiesSet (stella.pro)
-      const string& md5 = MD5::hash(files[idx]);
-      if(instance().propSet().getMD5(md5, props))
+      // Use the MD5 to get the rest of the info from the PropertiesSet
+      // (stella.pro)
+      if(result.valid && Bankswitch::isValidRomName(result.node, extension) &&
+         instance().propSet().getMD5(result.data.md5, props))
       {
         const string& name = props.get(PropType::Cart_Name);
 
         // Only rename the file if we found a valid properties entry
-        if(name != "" && name != files[idx].getName())
+        if(name != "" && name != result.node.getName())
         {
           string newfile = node.getPath();
           newfile.append(name).append(".").append(extension);
-          if(files[idx].getPath() != newfile && files[idx].rename(newfile))
+          FilesystemNode file = result.node;
+          if(file.getPath() != newfile && file.rename(newfile))
             renameSucceeded = true;
         }
       }
@@ -159,9 +168,10 @@ void RomAuditDialog::auditRoms()
         ++notfound;
     }
 
-    // Update the progress bar, indicating one more ROM has been processed
-    progress.incProgress();
+    // Update the progress bar, indicating how many ROMs have been processed
+    progress.setProgress(int(scanner.numScanned()));
   }
+  scanner.cancel();
   progress.close();
 
   myResults1->setText(std::to_string(renamed));
@@ -28,6 +28,7 @@
 #include "Props.hxx"
 #include "PNGLibrary.hxx"
 #include "PropsSet.hxx"
+#include "RomMetadataCache.hxx"
 #include "Rect.hxx"
 #include "Widget.hxx"
 #include "RomInfoWidget.hxx"
@@ -137,7 +138,8 @@ void RomInfoWidget::parseProperties(const FilesystemNode& node)
   myRomInfo.push_back("Note: " + myProperties.get(PropType::Cart_Note));
   bool swappedPorts = myProperties.get(PropType::Console_SwapPorts) == "YES";
 
-  // Load the image for controller and bankswitch type auto detection
+  // Load the image for controller and bankswitch type auto detection,
+  // unless the results for this file have been cached before
   string left = myProperties.get(PropType::Controller_Left);
   string right = myProperties.get(PropType::Controller_Right);
   Controller::Type leftType = Controller::getType(left);
@@ -145,21 +147,56 @@ void RomInfoWidget::parseProperties(const FilesystemNode& node)
   string bsDetected = myProperties.get(PropType::Cart_Type);
   try
   {
-    ByteBuffer image;
-    string md5 = "";  size_t size = 0;
-
-    if(node.exists() && !node.isDirectory() &&
-      (image = instance().openROM(node, md5, size)) != nullptr)
+    if(node.exists() && !node.isDirectory())
     {
-      Logger::debug(myProperties.get(PropType::Cart_Name) + ":");
-      left = ControllerDetector::detectName(image, size, leftType,
-          !swappedPorts ? Controller::Jack::Left : Controller::Jack::Right,
-          instance().settings());
-      right = ControllerDetector::detectName(image, size, rightType,
-          !swappedPorts ? Controller::Jack::Right : Controller::Jack::Left,
-          instance().settings());
-      if (bsDetected == "AUTO")
-        bsDetected = Bankswitch::typeToName(CartDetector::autodetectType(image, size));
+      RomMetadataCache& cache = instance().romCache();
+      RomMetadataCache::Metadata data;
+      bool detected = false;
+
+      if(cache.get(node, data) && data.md5 != "" && data.bsType != "" &&
+         data.leftController != "" && data.rightController != "")
+      {
+        // This is the documented side-effect of openROM, which we skip here
+        instance().propSet().loadPerROM(node, data.md5);
+        detected = true;
+      }
+      else
+      {
+        RomImage image;
+        string md5 = "";  size_t size = 0;
+
+        if((image = instance().openROM(node, md5, size)) != nullptr)
+        {
+          // openROM has cached the MD5, so we have to refetch the entry
+          cache.get(node, data);
+          data.md5 = md5;
+
+          Logger::debug(myProperties.get(PropType::Cart_Name) + ":");
+          data.leftController = Controller::getName(
+              ControllerDetector::detectType(image, size, Controller::Type::Unknown,
+                                             Controller::Jack::Left, instance().settings()));
+          data.rightController = Controller::getName(
+              ControllerDetector::detectType(image, size, Controller::Type::Unknown,
+                                             Controller::Jack::Right, instance().settings()));
+          data.bsType = Bankswitch::typeToName(CartDetector::autodetectType(image, size));
+          cache.put(node, data);
+          detected = true;
+        }
+      }
+
+      if(detected)
+      {
+        if(leftType == Controller::Type::Unknown)
+          left = !swappedPorts ? data.leftController : data.rightController;
+        else
+          left = Controller::getName(leftType);
+        if(rightType == Controller::Type::Unknown)
+          right = !swappedPorts ? data.rightController : data.leftController;
+        else
+          right = Controller::getName(rightType);
+        if(bsDetected == "AUTO")
+          bsDetected = data.bsType;
+      }
     }
   }
   catch(const runtime_error&)
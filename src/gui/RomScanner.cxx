@@ -0,0 +1,138 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2020 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+#include <chrono>
+
+#include "Bankswitch.hxx"
+#include "CartDetector.hxx"
+#include "Control.hxx"
+#include "ControllerDetector.hxx"
+#include "MD5.hxx"
+#include "OSystem.hxx"
+#include "RomScanner.hxx"
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void RomScanner::start(const FSList& files, uInt32 numThreads)
+{
+  cancel();
+
+  for(const auto& file: files)
+    if(file.isFile() && Bankswitch::isValidRomName(file))
+      myFiles.push_back(file);
+
+  if(numThreads == 0)
+    numThreads = std::max(1U, std::thread::hardware_concurrency());
+  numThreads = uInt32(std::min(size_t(numThreads), myFiles.size()));
+
+  myNext = 0;
+  myCancelled = false;
+  for(uInt32 i = 0; i < numThreads; ++i)
+    myWorkers.emplace_back(&RomScanner::threadMain, this);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void RomScanner::cancel()
+{
+  myCancelled = true;
+  for(auto& worker: myWorkers)
+    worker.join();
+  myWorkers.clear();
+
+  myFiles.clear();
+  myResults.clear();
+  myFetched = 0;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+size_t RomScanner::fetchResults(vector<Result>& results, uInt32 timeout)
+{
+  vector<Result> fetched;
+  {
+    std::unique_lock<std::mutex> lock(myMutex);
+
+    if(myResults.empty() && timeout > 0 && !finished())
+      myResultCondition.wait_for(lock, std::chrono::milliseconds(timeout),
+                                 [this]() { return !myResults.empty(); });
+    fetched.swap(myResults);
+  }
+  myFetched += fetched.size();
+
+  vector<std::pair<FilesystemNode, RomMetadataCache::Metadata>> newData;
+  for(auto& result: fetched)
+  {
+    if(result.valid && !result.cached)
+      newData.emplace_back(result.node, result.data);
+    results.push_back(std::move(result));
+  }
+  if(!newData.empty())
+    myOSystem.romCache().put(newData);
+
+  return fetched.size();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void RomScanner::threadMain()
+{
+  for(size_t idx = myNext++; idx < myFiles.size() && !myCancelled; idx = myNext++)
+  {
+    Result result;
+    result.node = myFiles[idx];
+    scan(result);
+
+    {
+      std::lock_guard<std::mutex> lock(myMutex);
+      myResults.push_back(std::move(result));
+    }
+    myResultCondition.notify_one();
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void RomScanner::scan(Result& result) const
+{
+  RomMetadataCache::Metadata& data = result.data;
+
+  if(myOSystem.romCache().get(result.node, data) && data.md5 != "" &&
+     data.bsType != "" && data.leftController != "" && data.rightController != "")
+  {
+    result.valid = result.cached = true;
+    return;
+  }
+
+  try
+  {
+    const RomImage image = RomImage::map(result.node);
+    const size_t size = image.size();
+    if(size == 0)
+      return;
+
+    if(data.md5 == "")
+      data.md5 = MD5::hash(image.get(), size);
+    data.bsType = Bankswitch::typeToName(CartDetector::autodetectType(image, size));
+    data.leftController = Controller::getName(
+        ControllerDetector::detectType(image, size, Controller::Type::Unknown,
+                                       Controller::Jack::Left, myOSystem.settings()));
+    data.rightController = Controller::getName(
+        ControllerDetector::detectType(image, size, Controller::Type::Unknown,
+                                       Controller::Jack::Right, myOSystem.settings()));
+    result.valid = true;
+  }
+  catch(const runtime_error&)
+  {
+    // Do nothing; the file simply isn't valid
+  }
+}
@@ -0,0 +1,121 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2020 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+#ifndef ROM_SCANNER_HXX
+#define ROM_SCANNER_HXX
+
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+class OSystem;
+
+#include "bspf.hxx"
+#include "FSNode.hxx"
+#include "RomMetadataCache.hxx"
+
+/**
+  Hashes and classifies (bankswitch type, controllers) a list of ROM files
+  on a pool of background threads, so that the UI stays responsive even
+  for thousands of files on slow media.
+
+  Files which are already complete in the ROM metadata cache are not read
+  again.  The results are collected by the main thread, which is also the
+  only one updating the cache.  A scan can be cancelled at any time.
+*/
+class RomScanner
+{
+  public:
+    struct Result
+    {
+      FilesystemNode node;
+      RomMetadataCache::Metadata data;
+      bool valid{false};   // the file could be read (or was cached)
+      bool cached{false};  // the data was taken from the cache
+    };
+
+  public:
+    explicit RomScanner(OSystem& osystem) : myOSystem(osystem) { }
+    ~RomScanner() { cancel(); }
+
+    /**
+      Start scanning the given files, cancelling any scan in progress.
+
+      @param files       The files to scan; directories and files which
+                         aren't ROMs are skipped
+      @param numThreads  The number of threads to use, 0 for all cores
+    */
+    void start(const FSList& files, uInt32 numThreads = 0);
+
+    /**
+      Stop a running scan; results not fetched yet are discarded.
+    */
+    void cancel();
+
+    /**
+      Move the results which are available so far into the given list,
+      waiting up to 'timeout' milliseconds for the first one.  Newly
+      determined data is added to the cache.
+
+      @return  The number of results added
+    */
+    size_t fetchResults(vector<Result>& results, uInt32 timeout = 0);
+
+    /**
+      Answers whether all files have been scanned and fetched.
+    */
+    bool finished() const { return myFetched == myFiles.size(); }
+
+    /**
+      The number of files scanned so far, and in total.
+    */
+    size_t numScanned() const { return myFetched; }
+    size_t numFiles() const { return myFiles.size(); }
+
+  private:
+    void threadMain();
+
+    // Determine the data for one file (runs on the worker threads)
+    void scan(Result& result) const;
+
+  private:
+    OSystem& myOSystem;
+
+    FSList myFiles;
+    vector<std::thread> myWorkers;
+
+    // Index of the next file to be scanned
+    std::atomic<size_t> myNext{0};
+    std::atomic<bool> myCancelled{false};
+
+    // Results not fetched by the main thread yet
+    vector<Result> myResults;
+    std::mutex myMutex;
+    std::condition_variable myResultCondition;
+    size_t myFetched{0};
+
+  private:
+    // Following constructors and assignment operators not supported
+    RomScanner() = delete;
+    RomScanner(const RomScanner&) = delete;
+    RomScanner(RomScanner&&) = delete;
+    RomScanner& operator=(const RomScanner&) = delete;
+    RomScanner& operator=(RomScanner&&) = delete;
+};
+
+#endif
@@ -523,7 +523,7 @@ void StellaSettingsDialog::openHelp()
 void StellaSettingsDialog::updateControllerStates()
 {
   bool autoDetect = false;
-  ByteBuffer image;
+  RomImage image;
   string md5 = myGameProperties.get(PropType::Cart_MD5);
   size_t size = 0;
 
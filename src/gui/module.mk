@@ -43,6 +43,7 @@ MODULE_OBJS := \
 	src/gui/RadioButtonWidget.o \
 	src/gui/RomAuditDialog.o \
 	src/gui/RomInfoWidget.o \
+	src/gui/RomScanner.o \
 	src/gui/ScrollBarWidget.o \
 	src/gui/SnapshotDialog.o \
 	src/gui/StellaSettingsDialog.o \
@@ -23,6 +23,7 @@
 
 #include "AtariNTSC.hxx"
 #include "AudioSettings.hxx"
+#include "RunAheadManager.hxx"
 #include "Serializer.hxx"
 #include "StateManager.hxx"
 #include "Switches.hxx"
@@ -93,6 +94,9 @@ bool StellaLIBRETRO::create(bool logging)
   settings.setValue(AudioSettings::SETTING_VOLUME, 100);
   settings.setValue(AudioSettings::SETTING_STEREO, audio_mode);
 
+  settings.setValue("runahead", run_ahead_frames);
+  settings.setValue("runahead.second", run_ahead_second);
+
   FilesystemNode rom(rom_path);
 
   if(myOSystem->createConsole(rom) != EmptyString)
@@ -174,7 +178,8 @@ void StellaLIBRETRO::updateVideo()
   {
     FrameBuffer& frame = myOSystem->frameBuffer();
 
-    tia.renderToFrameBuffer();
+    if(!myOSystem->runAhead().renderFrame())
+      tia.renderToFrameBuffer();
     frame.updateInEmulationMode(0);
   }
 }
@@ -406,3 +411,17 @@ void StellaLIBRETRO::setAudioStereo(int mode)
     myOSystem->console().initializeAudio();
   }
 }
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void StellaLIBRETRO::setRunAhead(uInt32 frames, bool second)
+{
+  run_ahead_frames = frames;
+  run_ahead_second = second;
+
+  if (system_ready)
+  {
+    myOSystem->settings().setValue("runahead", run_ahead_frames);
+    myOSystem->settings().setValue("runahead.second", run_ahead_second);
+    myOSystem->runAhead().reset();
+  }
+}
@@ -122,6 +122,8 @@ class StellaLIBRETRO
 
     void   setAudioStereo(int mode);
 
+    void   setRunAhead(uInt32 frames, bool second);
+
     void   setInputEvent(Event::Type type, Int32 state) {
              myOSystem->eventHandler().handleEvent(type, state);
     }
@@ -187,6 +189,9 @@ class StellaLIBRETRO
 
     string audio_mode{"byrom"};
 
+    uInt32 run_ahead_frames{0};
+    bool run_ahead_second{false};
+
     bool phosphor_default{false};
 };
 
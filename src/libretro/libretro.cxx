@@ -34,6 +34,7 @@ static int setting_ntsc, setting_pal;
 static int setting_stereo;
 static int setting_phosphor, setting_console, setting_phosphor_blend;
 static int stella_paddle_joypad_sensitivity;
+static int setting_runahead, setting_runahead_second;
 static int setting_crop_hoverscan, crop_left;
 static NTSCFilter::Preset setting_filter;
 static const char* setting_palette;
@@ -366,6 +367,34 @@ static void update_variables(bool init = false)
     }
   }
 
+  RETRO_GET("stella_runahead")
+  {
+    int value = 0;
+
+    value = atoi(var.value);
+
+    if(setting_runahead != value)
+    {
+      stella.setRunAhead(value, setting_runahead_second);
+
+      setting_runahead = value;
+    }
+  }
+
+  RETRO_GET("stella_runahead_second")
+  {
+    int value = 0;
+
+    if(!strcmp(var.value, "enabled")) value = 1;
+
+    if(setting_runahead_second != value)
+    {
+      stella.setRunAhead(setting_runahead, value);
+
+      setting_runahead_second = value;
+    }
+  }
+
   if(!init && !system_reset)
   {
     crop_left = setting_crop_hoverscan ? (stella.getVideoZoom() == 2 ? 26 : 8) : 0;
@@ -499,6 +528,8 @@ void retro_set_environment(retro_environment_t cb)
     { "stella_phosphor", "Phosphor mode; auto|off|on" },
     { "stella_phosphor_blend", "Phosphor blend %; 60|65|70|75|80|85|90|95|100|0|5|10|15|20|25|30|35|40|45|50|55" },
     { "stella_paddle_joypad_sensitivity", "Paddle joypad sensitivity; 3|4|5|6|7|8|9|10|11|12|13|14|15|16|17|18|19|20|1|2" },
+    { "stella_runahead", "Run-ahead frames; 0|1|2|3|4" },
+    { "stella_runahead_second", "Run-ahead second instance; disabled|enabled" },
     { NULL, NULL },
   };
 
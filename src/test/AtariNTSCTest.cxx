@@ -0,0 +1,227 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2020 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+#include <random>
+
+#include "AtariNTSC.hxx"
+#include "PhosphorHandler.hxx"
+#include "Check.hxx"
+
+/**
+  Check that the NTSC filter, which computes four output pixels at once
+  using SIMD instructions where available, renders exactly the same frames
+  as the plain per pixel code, with and without phosphor blending.  This
+  also covers the 4th pixel of the second half of each chunk, which is
+  garbage with SIMD and has to be overwritten by the next chunk.
+*/
+class AtariNTSCCheck : public AtariNTSC
+{
+  public:
+    static constexpr uInt32 WIDTH = 160, HEIGHT = 250;
+    static constexpr uInt32 OUT_WIDTH = outWidth(WIDTH);
+
+    /**
+      The rendering of renderThread (and renderWithPhosphorThread, if
+      'rgb_in' isn't the null pointer) done one pixel at a time.
+    */
+    void renderScalar(const uInt8* atari_in, uInt32* rgb_out, uInt32* rgb_in)
+    {
+      const uInt32 chunk_count = (WIDTH - 1) / PIXEL_in_chunk;
+
+      for(uInt32 y = 0; y < HEIGHT; ++y)
+      {
+        const uInt8* line_in = atari_in + y * WIDTH;
+        ATARI_NTSC_BEGIN_ROW(NTSC_black, line_in[0]);
+        uInt32* line_out = rgb_out + y * OUT_WIDTH;
+        ++line_in;
+
+        line_out[0] = line_out[1] = 0;
+        line_out += 2;
+
+        for(uInt32 n = chunk_count; n; --n)
+        {
+          ATARI_NTSC_COLOR_IN(0, line_in[0])
+          ATARI_NTSC_RGB_OUT_8888(0, line_out[0])
+          ATARI_NTSC_RGB_OUT_8888(1, line_out[1])
+          ATARI_NTSC_RGB_OUT_8888(2, line_out[2])
+          ATARI_NTSC_RGB_OUT_8888(3, line_out[3])
+
+          ATARI_NTSC_COLOR_IN(1, line_in[1])
+          ATARI_NTSC_RGB_OUT_8888(4, line_out[4])
+          ATARI_NTSC_RGB_OUT_8888(5, line_out[5])
+          ATARI_NTSC_RGB_OUT_8888(6, line_out[6])
+
+          line_in += 2;
+          line_out += 7;
+        }
+
+        // finish final pixels
+        ATARI_NTSC_COLOR_IN(0, line_in[0])
+        ATARI_NTSC_RGB_OUT_8888(0, line_out[0])
+        ATARI_NTSC_RGB_OUT_8888(1, line_out[1])
+        ATARI_NTSC_RGB_OUT_8888(2, line_out[2])
+        ATARI_NTSC_RGB_OUT_8888(3, line_out[3])
+
+        ATARI_NTSC_COLOR_IN(1, NTSC_black)
+        ATARI_NTSC_RGB_OUT_8888(4, line_out[4])
+        ATARI_NTSC_RGB_OUT_8888(5, line_out[5])
+        ATARI_NTSC_RGB_OUT_8888(6, line_out[6])
+
+        line_out += 7;
+
+        ATARI_NTSC_COLOR_IN(0, NTSC_black)
+        ATARI_NTSC_RGB_OUT_8888(0, line_out[0])
+        ATARI_NTSC_RGB_OUT_8888(1, line_out[1])
+        ATARI_NTSC_RGB_OUT_8888(2, line_out[2])
+        ATARI_NTSC_RGB_OUT_8888(3, line_out[3])
+
+        ATARI_NTSC_COLOR_IN(1, NTSC_black)
+        ATARI_NTSC_RGB_OUT_8888(4, line_out[4])
+
+        if(rgb_in != nullptr)
+        {
+          uInt32* row = rgb_out + y * OUT_WIDTH;
+          uInt32* prev = rgb_in + y * OUT_WIDTH;
+
+          for(uInt32 x = 0; x < OUT_WIDTH / 8 * 8; ++x)
+            prev[x] = PhosphorHandler::getPixel(row[x], prev[x]);
+        }
+      }
+
+      if(rgb_in != nullptr)
+        std::copy_n(rgb_in, HEIGHT * OUT_WIDTH, rgb_out);
+    }
+
+  #if defined(BSPF_SIMD_SSE2) || defined(BSPF_SIMD_NEON)
+    /**
+      Compare rgbOut4_8888 with ATARI_NTSC_RGB_OUT_8888 for random kernel
+      values, which also exercise the clamping of all color components.
+    */
+    static void checkRgbOut4(std::mt19937& random)
+    {
+      std::uniform_int_distribution<uInt32> value;
+      std::array<uInt32, entry_size> kernel0, kernel1;
+
+      for(int i = 0; i < 100000; ++i)
+      {
+        for(auto& v: kernel0) v = value(random);
+        for(auto& v: kernel1) v = value(random);
+
+        for(int index: {0, 4})
+        {
+          const uInt32* kernelx0 = kernel1.data();
+          const uInt32* kernelx1 = kernel0.data();
+          std::array<uInt32, 4> simd, scalar;
+
+          rgbOut4_8888(kernel0.data() + index, kernel1.data() + (index+10)%7+14,
+                       kernelx0 + (index+7)%14, kernelx1 + (index+3)%7+14+7,
+                       simd.data());
+          for(int j = 0; j < (index == 0 ? 4 : 3); ++j)
+            rgbOut(kernel0.data(), kernel1.data(), kernelx0, kernelx1,
+                   index + j, scalar[j]);
+
+          for(int j = 0; j < (index == 0 ? 4 : 3); ++j)
+            if(!Check::expect(simd[j] == scalar[j],
+                              "rgbOut4_8888 differs at pixel " +
+                              std::to_string(index + j)))
+              return;
+        }
+      }
+    }
+
+  private:
+    // ATARI_NTSC_RGB_OUT_8888 for a variable index
+    static void rgbOut(const uInt32* kernel0, const uInt32* kernel1,
+                       const uInt32* kernelx0, const uInt32* kernelx1,
+                       int index, uInt32& out)
+    {
+      ATARI_NTSC_RGB_OUT_8888(index, out)
+    }
+  #endif
+};
+
+namespace {
+  void checkRender(const string& name, const AtariNTSC::Setup& setup,
+                   std::mt19937& random)
+  {
+    constexpr uInt32 WIDTH = AtariNTSCCheck::WIDTH,
+                     HEIGHT = AtariNTSCCheck::HEIGHT,
+                     OUT_WIDTH = AtariNTSCCheck::OUT_WIDTH;
+    std::uniform_int_distribution<uInt32> value;
+
+    AtariNTSCCheck ntsc;
+    PaletteArray palette;
+    for(auto& color: palette)
+      color = value(random) & 0xffffff;
+    ntsc.initialize(setup);
+    ntsc.setPalette(palette);
+
+    // Random pixels, and rows of constant color for the artifacts of
+    // smooth areas
+    vector<uInt8> frame(WIDTH * HEIGHT);
+    for(uInt32 i = 0; i < frame.size(); ++i)
+      frame[i] = (i / WIDTH) % 4 ? uInt8(value(random)) : uInt8(i / WIDTH / 4);
+
+    PhosphorHandler phosphor;
+    phosphor.initialize(true, 60);
+
+    for(bool withPhosphor: {false, true})
+    {
+      vector<uInt32> simd(OUT_WIDTH * HEIGHT, 0xdeadbeef),
+                     scalar(OUT_WIDTH * HEIGHT, 0xdeadbeef),
+                     simdIn(OUT_WIDTH * HEIGHT), scalarIn;
+      for(auto& color: simdIn)
+        color = value(random) & 0xffffff;
+      scalarIn = simdIn;
+
+      ntsc.render(frame.data(), WIDTH, HEIGHT, simd.data(), OUT_WIDTH * 4,
+                  withPhosphor ? simdIn.data() : nullptr);
+      ntsc.renderScalar(frame.data(), scalar.data(),
+                        withPhosphor ? scalarIn.data() : nullptr);
+
+      for(uInt32 i = 0; i < simd.size(); ++i)
+        if(!Check::expect(simd[i] == scalar[i] &&
+                          (!withPhosphor || simdIn[i] == scalarIn[i]),
+                          name + (withPhosphor ? " with phosphor" : "") +
+                          ": difference at line " + std::to_string(i / OUT_WIDTH) +
+                          ", pixel " + std::to_string(i % OUT_WIDTH)))
+          break;
+    }
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+int main(int argc, char* argv[])
+{
+  std::mt19937 random(2020);
+
+#if defined(BSPF_SIMD_SSE2) || defined(BSPF_SIMD_NEON)
+  AtariNTSCCheck::checkRgbOut4(random);
+#endif
+
+  AtariNTSC::Setup extreme = AtariNTSC::TV_Bad;
+  extreme.sharpness = extreme.resolution = 1.F;
+  extreme.artifacts = extreme.fringing = 1.F;
+
+  checkRender("composite", AtariNTSC::TV_Composite, random);
+  checkRender("s-video", AtariNTSC::TV_SVideo, random);
+  checkRender("rgb", AtariNTSC::TV_RGB, random);
+  checkRender("bad", AtariNTSC::TV_Bad, random);
+  checkRender("extreme", extreme, random);
+
+  return Check::result("AtariNTSC");
+}
@@ -0,0 +1,132 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2020 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+#include <set>
+#include <thread>
+
+#include "AudioQueue.hxx"
+#include "Check.hxx"
+
+/**
+  Stress test of the AudioQueue: the producer fills fragments as fast as it
+  can, while the consumer takes them at varying speed, so the queue
+  overflows all the time.  Every fragment is stamped with a sequence
+  number, and the consumer checks that it receives increasing numbers only
+  and that nobody writes to a fragment while it holds it.
+*/
+namespace {
+  constexpr uInt32 FRAGMENT_SIZE = 32;
+  constexpr uInt32 FRAGMENTS = 200000;
+
+  void fill(Int16* fragment, uInt32 sequence)
+  {
+    fragment[0] = Int16(sequence & 0x7fff);
+    fragment[1] = Int16(sequence >> 15);
+    for(uInt32 i = 2; i < FRAGMENT_SIZE; ++i)
+      fragment[i] = Int16(sequence + i);
+  }
+
+  // Answer the sequence number of the fragment, or -1 if it is corrupted
+  Int64 stamp(const Int16* fragment)
+  {
+    const uInt32 sequence = uInt32(fragment[0]) | (uInt32(fragment[1]) << 15);
+    for(uInt32 i = 2; i < FRAGMENT_SIZE; ++i)
+      if(fragment[i] != Int16(sequence + i))
+        return -1;
+
+    return sequence;
+  }
+
+  void run(uInt32 capacity, uInt32 consumerDelay)
+  {
+    AudioQueue queue(FRAGMENT_SIZE, capacity, false);
+    std::atomic<bool> producerDone{false};
+    std::set<Int16*> producerFragments, consumerFragments;
+    const string context = "capacity " + std::to_string(capacity) +
+                           ", delay " + std::to_string(consumerDelay) + ": ";
+
+    std::thread producer([&] {
+      Int16* fragment = queue.enqueue();
+
+      for(uInt32 sequence = 1; sequence <= FRAGMENTS; ++sequence)
+      {
+        producerFragments.insert(fragment);
+        fill(fragment, sequence);
+        fragment = queue.enqueue(fragment);
+      }
+      producerDone = true;
+    });
+
+    std::thread consumer([&] {
+      Int16* fragment = nullptr;
+      Int64 last = 0;
+      uInt32 received = 0;
+
+      for(;;)
+      {
+        // The producer is done before the queue is drained for the last time
+        const bool done = producerDone;
+        Int16* next = queue.dequeue(fragment);
+
+        if(!next)
+        {
+          if(done) break;
+          std::this_thread::yield();
+          continue;
+        }
+        fragment = next;
+        consumerFragments.insert(fragment);
+        ++received;
+
+        const Int64 sequence = stamp(fragment);
+        Check::expect(sequence > last, context + "received fragment " +
+                      std::to_string(sequence) + " after " + std::to_string(last));
+
+        // Hold the fragment for a while, giving the producer the chance to
+        // overflow the queue, and make sure that it didn't touch it
+        for(uInt32 i = 0; i < (received % 4 ? 0 : consumerDelay); ++i)
+          std::this_thread::yield();
+        Check::expect(stamp(fragment) == sequence,
+                      context + "fragment " + std::to_string(sequence) +
+                      " modified while being played");
+        last = sequence;
+      }
+
+      Check::expect(last == FRAGMENTS, context + "last fragment received was " +
+                    std::to_string(last));
+      Check::expect(queue.size() == 0, context + "queue not empty after draining");
+    });
+
+    producer.join();
+    consumer.join();
+
+    std::set<Int16*> fragments(producerFragments);
+    fragments.insert(consumerFragments.begin(), consumerFragments.end());
+    Check::expect(fragments.size() <= capacity + 3,
+                  context + std::to_string(fragments.size()) + " fragments in use");
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+int main(int argc, char* argv[])
+{
+  for(uInt32 capacity: {1, 2, 3, 5, 20})
+    for(uInt32 delay: {0, 1, 20})
+      run(capacity, delay);
+
+  return Check::result("AudioQueue");
+}
@@ -0,0 +1,120 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2020 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+#include "Bankswitch.hxx"
+#include "CartDetector.hxx"
+#include "FSNode.hxx"
+#include "Logger.hxx"
+#include "RomImage.hxx"
+#include "Check.hxx"
+
+/**
+  Check that CartDetector::autodetectType recognizes the bankswitching type
+  of every ROM in 'bankswitching/<TYPE>/' of the test ROMs.
+*/
+namespace {
+  // The directories whose name isn't the type of their ROMs
+  Bankswitch::Type directoryType(const string& name)
+  {
+    if(name == "Sub2K")  return Bankswitch::Type::_2K;
+    if(name == "CDFJ+")  return Bankswitch::Type::_CDF;
+
+    return Bankswitch::nameToType(name);
+  }
+
+  // ROMs which are detected differently than their directory says: most
+  // are 4K or 16K images of 2K games, variants of the type, bad dumps or
+  // prototypes not using their final bankswitching yet; a few get their
+  // type from the properties database ("2IN1", "4A50", "CM", "MDM")
+  const std::map<string, string> KNOWN_EXCEPTIONS = {
+    { "2-in-1 - Freeway and Tennis [p1].a26",                     "4K" },
+    { "Air-Sea Battle (1977) (Atari) [o1][h1].a26",               "4K" },
+    { "Combat - Tank AI (19-04-2003) (Zach Matley).a26",          "4K" },
+    { "Combat AI (16-02-2003) (Zach Matley).a26",                 "4K" },
+    { "Combat Rock (PD) [a1].a26",                                "4K" },
+    { "Combat Rock (PD).a26",                                     "4K" },
+    { "Freeway (1981) (Activision) [o2].a26",                     "F6" },
+    { "Kaboom! (1981) (Activision) [o2].a26",                     "F6" },
+    { "Okie Dokie (4K) (PD).a26",                                 "4K" },
+    { "Stampede (1981) (Activision) [o2].a26",                    "F6" },
+    { "Tank Plus (1977) (Sears).a26",                             "4K" },
+    { "Tennis (1981) (Activision) [o2].a26",                      "F6" },
+    { "Tennis (Starsoft) (PAL) [!].a26",                          "4K" },
+    { "3E Bankswitch Test (TIA @ $00).bin",                       "SB" },
+    { "spin4a50.bin",                                             "F0" },
+    { "CompuMate (1983) (Spectravideo).bin",                      "F6" },
+    { "Bump 'n' Jump (1983) (M Network).bin",                     "E78K" },
+    { "Bump 'n' Jump (1988) (Telegames) (7045 A015) (PAL).bin",   "F8" },
+    { "208in1_MDMC_test_PAL-127games.bin",                        "3F" },
+    { "POP_MDMC_test_PAL_63gamees.bin",                           "3F" },
+    { "Pursuit of the Pink Panther (Probe) (Prototype) [bad dump].bin", "WDSW" },
+    { "Star Wars - The Arcade Game (01-03-1984) (Parker Bros) (Prototype).a26", "4K" },
+    { "Star Wars - The Arcade Game (12-05-1983) (Parker Bros) (Prototype).a26", "4K" },
+    { "Star Wars - The Arcade Game (12-15-1983) (Parker Bros) (Prototype).a26", "4K" },
+    { "Star Wars - The Arcade Game (12-23-1983) (Parker Bros) (Prototype).a26", "4K" }
+  };
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+int main(int argc, char* argv[])
+{
+  if(!Check::expect(argc > 1, "no ROM directory given"))
+    return Check::result("CartDetector");
+
+  // Don't report every detected type
+  Logger::instance().setLogParameters(Logger::Level::ERR, true);
+
+  FSList dirs;
+  FilesystemNode(string(argv[1]) + "/bankswitching").getChildren(
+      dirs, FilesystemNode::ListMode::DirectoriesOnly,
+      [](const FilesystemNode&) { return true; }, false, false);
+  Check::expect(!dirs.empty(), string("no bankswitching ROMs in ") + argv[1]);
+
+  for(const auto& dir: dirs)
+  {
+    // The name of a directory node is decorated for display, so use its path
+    string name = dir.getPath();
+    while(!name.empty() && (name.back() == '/' || name.back() == '\\'))
+      name.pop_back();
+    const Bankswitch::Type expected =
+        directoryType(name.substr(name.find_last_of("/\\") + 1));
+
+    // Directories like '_code' and 'odd_sized' don't have a single type
+    if(expected == Bankswitch::Type::_AUTO)
+      continue;
+
+    FSList roms;
+    dir.getChildren(roms, FilesystemNode::ListMode::FilesOnly,
+        [](const FilesystemNode& node) { return Bankswitch::isValidRomName(node); },
+        false, false);
+
+    for(const auto& rom: roms)
+    {
+      const RomImage image = RomImage::load(rom);
+      const string detected = Bankswitch::typeToName(
+          CartDetector::autodetectType(image, image.size()));
+      const auto exception = KNOWN_EXCEPTIONS.find(rom.getName());
+
+      Check::expect(exception != KNOWN_EXCEPTIONS.end()
+                      ? detected == exception->second
+                      : detected == Bankswitch::typeToName(expected),
+                    rom.getPath() + " detected as " + detected);
+    }
+  }
+
+  return Check::result("CartDetector");
+}
@@ -0,0 +1,62 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2020 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+#ifndef CHECK_HXX
+#define CHECK_HXX
+
+#include <atomic>
+
+#include "bspf.hxx"
+
+/**
+  Minimal support for the checks run by 'make check'.  Every check is a
+  separate program, which gets the directory of the test ROMs as its
+  argument, reports all failed expectations and returns non-zero if any
+  of them failed.
+*/
+namespace Check {
+
+  inline std::atomic<uInt32> failures{0};
+
+  /**
+    Report a failure if the given condition doesn't hold.  Only the first
+    few failures are printed, but all of them are counted.
+  */
+  inline bool expect(bool condition, const string& message)
+  {
+    if(!condition && failures++ < 20)
+      cerr << "  FAILED: " << message << endl;
+
+    return condition;
+  }
+
+  /**
+    Print the summary of the check, and answer its exit code.
+  */
+  inline int result(const string& name)
+  {
+    if(failures > 0)
+      cout << name << ": " << failures << " failure(s)" << endl;
+    else
+      cout << name << ": passed" << endl;
+
+    return failures > 0 ? 1 : 0;
+  }
+
+} // namespace Check
+
+#endif
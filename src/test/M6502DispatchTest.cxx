@@ -0,0 +1,216 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2020 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+#include "Bankswitch.hxx"
+#include "Cart.hxx"
+#include "CartCreator.hxx"
+#include "ConsoleIO.hxx"
+#include "ConsoleTiming.hxx"
+#include "Control.hxx"
+#include "DispatchResult.hxx"
+#include "Event.hxx"
+#include "FSNode.hxx"
+#include "FrameManager.hxx"
+#include "Joystick.hxx"
+#include "Logger.hxx"
+#include "M6502.hxx"
+#include "M6532.hxx"
+#include "MD5.hxx"
+#include "Props.hxx"
+#include "Random.hxx"
+#include "Serializer.hxx"
+#include "Settings.hxx"
+#include "Switches.hxx"
+#include "System.hxx"
+#include "TIA.hxx"
+#include "Check.hxx"
+
+/**
+  Lockstep check of the threaded against the switch based dispatch of the
+  6502 instructions: every test ROM is run on two consoles, one using each
+  dispatch, and the CPU registers and the system cycles are compared after
+  every timeslice.  The timeslices vary in length, so that they also end in
+  the middle of instruction sequences.
+
+  This check only does something in builds configured with
+  '--enable-threadedcpu', since only these contain both dispatchers.
+*/
+namespace {
+  constexpr uInt32 TIMESLICES = 200;
+
+#ifdef M6502_THREADED_DISPATCH
+  struct IO: public ConsoleIO {
+    Controller& leftController() const override { return *myLeftControl; }
+    Controller& rightController() const override { return *myRightControl; }
+    Switches& switches() const override { return *mySwitches; }
+
+    unique_ptr<Controller> myLeftControl;
+    unique_ptr<Controller> myRightControl;
+    unique_ptr<Switches> mySwitches;
+  };
+
+  class Machine
+  {
+    public:
+      Machine(unique_ptr<Cartridge> cartridge, bool threaded)
+        : myCartridge(std::move(cartridge)),
+          myCpu(mySettings),
+          myRiot(myIO, mySettings),
+          myTia(myIO, []() { return ConsoleTiming::ntsc; }, mySettings),
+          mySystem(myRandom, myCpu, myRiot, myTia, *myCartridge)
+      {
+        myIO.myLeftControl = make_unique<Joystick>(Controller::Jack::Left, myEvent, mySystem);
+        myIO.myRightControl = make_unique<Joystick>(Controller::Jack::Right, myEvent, mySystem);
+        myIO.mySwitches = make_unique<Switches>(myEvent, myProps, mySettings);
+
+        myCpu.setThreadedDispatch(threaded);
+        myTia.bindToControllers();
+        myCartridge->setStartBankFromPropsFunc([]() { return -1; });
+        mySystem.initialize();
+        myTia.setFrameManager(&myFrameManager);
+        mySystem.reset();
+      }
+
+      // Run for the given number of cycles, and answer the emulation error,
+      // if there is one
+      string run(uInt64 cycles)
+      {
+        try
+        {
+          DispatchResult result;
+          myTia.update(result, cycles);
+
+          if(result.getStatus() == DispatchResult::Status::fatal)
+            return result.getMessage();
+        }
+        catch(const std::exception& e)
+        {
+          return e.what();
+        }
+
+        return "";
+      }
+
+      // Answer the CPU registers and the system cycles as a string, which is
+      // only meant to be compared and printed
+      string state() const
+      {
+        Serializer out;
+        myCpu.save(out);
+        out.rewind();
+
+        ostringstream buf;
+        buf << "A=" << int(out.getByte()) << " X=" << int(out.getByte())
+            << " Y=" << int(out.getByte()) << " SP=" << int(out.getByte())
+            << " IR=" << int(out.getByte()) << " PC=" << out.getShort() << " P=";
+        for(int flag = 0; flag < 7; ++flag)
+          buf << out.getBool();
+        buf << " status=" << int(out.getByte())
+            << " cycles=" << mySystem.cycles();
+
+        return buf.str();
+      }
+
+    private:
+      Settings mySettings;
+      Properties myProps;
+      Event myEvent;
+      IO myIO;
+      Random myRandom{0};
+
+      unique_ptr<Cartridge> myCartridge;
+      M6502 myCpu;
+      M6532 myRiot;
+      TIA myTia;
+      System mySystem;
+      FrameManager myFrameManager;
+  };
+
+  unique_ptr<Cartridge> createCartridge(const FilesystemNode& file)
+  {
+    Settings settings;
+    RomImage image = RomImage::load(file);
+    string md5 = MD5::hash(image.get(), image.size());
+
+    return CartCreator::create(file, image, image.size(), md5, "AUTO", settings);
+  }
+
+  void check(const FilesystemNode& file)
+  {
+    unique_ptr<Cartridge> threadedCart, switchCart;
+    try
+    {
+      threadedCart = createCartridge(file);
+      switchCart = createCartridge(file);
+    }
+    catch(const std::exception&)
+    {
+      // ROMs which aren't supported at all are the business of other checks
+      return;
+    }
+    if(!threadedCart || !switchCart)
+      return;
+
+    Machine threaded(std::move(threadedCart), true);
+    Machine switched(std::move(switchCart), false);
+
+    for(uInt32 i = 0; i < TIMESLICES; ++i)
+    {
+      const uInt64 cycles = 1 + (i * 7919) % 30000;
+      const string threadedError = threaded.run(cycles);
+      const string switchError = switched.run(cycles);
+      const string threadedState = threaded.state(), switchState = switched.state();
+
+      if(!Check::expect(threadedError == switchError && threadedState == switchState,
+                        file.getPath() + ", timeslice " + std::to_string(i) +
+                        ":\n    threaded: " + threadedState + " " + threadedError +
+                        "\n    switch:   " + switchState + " " + switchError))
+        return;
+
+      // Both have failed the same way
+      if(!threadedError.empty())
+        return;
+    }
+  }
+#endif
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+int main(int argc, char* argv[])
+{
+#ifdef M6502_THREADED_DISPATCH
+  if(!Check::expect(argc > 1, "no ROM directory given"))
+    return Check::result("M6502 dispatch");
+
+  // Don't report every detected type
+  Logger::instance().setLogParameters(Logger::Level::ERR, true);
+
+  FSList roms;
+  FilesystemNode(argv[1]).getChildren(roms, FilesystemNode::ListMode::All,
+      [](const FilesystemNode& node) { return Bankswitch::isValidRomName(node); },
+      true, false);
+  Check::expect(!roms.empty(), string("no ROMs found in ") + argv[1]);
+
+  for(const auto& rom: roms)
+    check(rom);
+
+  return Check::result("M6502 dispatch");
+#else
+  cout << "M6502 dispatch: skipped (no threaded dispatch)" << endl;
+  return 0;
+#endif
+}
@@ -0,0 +1,75 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2020 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+#include <random>
+
+#include "PhosphorHandler.hxx"
+#include "Check.hxx"
+
+/**
+  Check that PhosphorHandler::getPixels, which blends whole rows using SIMD
+  instructions and a fixed point decay factor where available, yields
+  exactly the same colors as PhosphorHandler::getPixel for every blend.
+*/
+int main(int argc, char* argv[])
+{
+  std::mt19937 random(2020);
+  std::uniform_int_distribution<uInt32> color;
+
+  for(int blend = 0; blend <= 100; ++blend)
+  {
+    PhosphorHandler handler;
+    handler.initialize(true, blend);
+
+    // Odd sizes and offsets, so that the scalar tail and unaligned
+    // accesses are covered as well
+    for(size_t n: {1, 3, 4, 7, 160, 565, 1023})
+    {
+      const size_t offset = n % 3;
+      vector<uInt32> cur(n + offset), prev(n + offset), expected(n);
+
+      for(size_t i = 0; i < n + offset; ++i)
+      {
+        cur[i] = color(random);
+        prev[i] = color(random);
+      }
+      // Make sure that the whole range of each component is covered
+      for(size_t i = 0; i < std::min<size_t>(n, 256); ++i)
+        prev[offset + i] = (prev[offset + i] & 0xff000000) | (i * 0x010101);
+
+      for(size_t i = 0; i < n; ++i)
+        expected[i] = PhosphorHandler::getPixel(cur[offset + i], prev[offset + i]);
+
+      PhosphorHandler::getPixels(cur.data() + offset, prev.data() + offset, n);
+
+      for(size_t i = 0; i < n; ++i)
+      {
+        if(prev[offset + i] == expected[i])
+          continue;
+
+        ostringstream msg;
+        msg << "blend " << blend << ", " << n << " pixels: pixel " << i
+            << " is " << std::hex << prev[offset + i] << " instead of "
+            << expected[i];
+        Check::expect(false, msg.str());
+        break;
+      }
+    }
+  }
+
+  return Check::result("PhosphorHandler");
+}
@@ -0,0 +1,299 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2020 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+
+#include "Cart4K.hxx"
+#include "ConsoleIO.hxx"
+#include "ConsoleTiming.hxx"
+#include "Event.hxx"
+#include "FSNode.hxx"
+#include "FrameManager.hxx"
+#include "Joystick.hxx"
+#include "M6502.hxx"
+#include "M6532.hxx"
+#include "MD5.hxx"
+#include "Props.hxx"
+#include "Random.hxx"
+#include "RunAheadInstance.hxx"
+#include "RunAheadManager.hxx"
+#include "SaveKey.hxx"
+#include "Serializer.hxx"
+#include "Settings.hxx"
+#include "Switches.hxx"
+#include "System.hxx"
+#include "TIA.hxx"
+#include "Check.hxx"
+
+/**
+  Check that running ahead on a second instance doesn't change the console:
+  a ROM using a SaveKey is run with and without run-ahead, and the states of
+  the systems and controllers, including the EEPROM, are compared after
+  every frame.
+*/
+namespace {
+  constexpr uInt32 FRAMES = 120;
+
+  // On even frames, the ROM writes the frame counter ($80) to the EEPROM at
+  // $3000 + (frame / 2 & 15).  On odd frames, it reads the byte the next
+  // frame overwrites into $81, which is the counter of 31 frames earlier.
+  // The I2C lines SDA and SCL are pulled low by setting bits 2 and 3 of
+  // SWACNT ($281).
+  const std::array<uInt8, 245> CODE = {
+    0x78,                 // Reset:    sei
+    0xd8,                 //           cld
+    0xa2, 0xff,           //           ldx #$ff
+    0x9a,                 //           txs
+    0xa9, 0x00,           //           lda #0
+    0x95, 0x00,           // Clear:    sta $00,x
+    0xca,                 //           dex
+    0xd0, 0xfb,           //           bne Clear
+    0x8d, 0x80, 0x02,     //           sta SWCHA
+    0x8d, 0x81, 0x02,     //           sta SWACNT
+    0xa9, 0x02,           // Frame:    lda #2
+    0x85, 0x00,           //           sta VSYNC
+    0x85, 0x02,           //           sta WSYNC
+    0x85, 0x02,           //           sta WSYNC
+    0x85, 0x02,           //           sta WSYNC
+    0xa9, 0x00,           //           lda #0
+    0x85, 0x00,           //           sta VSYNC
+    0xa9, 0x13,           //           lda #19
+    0x8d, 0x96, 0x02,     //           sta T1024T
+    0xe6, 0x80,           //           inc frame
+    0xa5, 0x80,           //           lda frame
+    0x4a,                 //           lsr
+    0xb0, 0x21,           //           bcs Read
+    0x29, 0x0f,           //           and #$0f
+    0x85, 0x83,           //           sta addr
+    0x20, 0x7d, 0xf0,     //           jsr Start
+    0xa9, 0xa0,           //           lda #$a0
+    0x20, 0xa2, 0xf0,     //           jsr Send
+    0xa9, 0x30,           //           lda #$30
+    0x20, 0xa2, 0xf0,     //           jsr Send
+    0xa5, 0x83,           //           lda addr
+    0x20, 0xa2, 0xf0,     //           jsr Send
+    0xa5, 0x80,           //           lda frame
+    0x20, 0xa2, 0xf0,     //           jsr Send
+    0x20, 0x92, 0xf0,     //           jsr Stop
+    0x4c, 0x73, 0xf0,     //           jmp Wait
+    0x69, 0x00,           // Read:     adc #0
+    0x29, 0x0f,           //           and #$0f
+    0x85, 0x83,           //           sta addr
+    0x20, 0x7d, 0xf0,     //           jsr Start
+    0xa9, 0xa0,           //           lda #$a0
+    0x20, 0xa2, 0xf0,     //           jsr Send
+    0xa9, 0x30,           //           lda #$30
+    0x20, 0xa2, 0xf0,     //           jsr Send
+    0xa5, 0x83,           //           lda addr
+    0x20, 0xa2, 0xf0,     //           jsr Send
+    0x20, 0x7d, 0xf0,     //           jsr Start
+    0xa9, 0xa1,           //           lda #$a1
+    0x20, 0xa2, 0xf0,     //           jsr Send
+    0x20, 0xce, 0xf0,     //           jsr Receive
+    0x20, 0x92, 0xf0,     //           jsr Stop
+    0xad, 0x84, 0x02,     // Wait:     lda INTIM
+    0xd0, 0xfb,           //           bne Wait
+    0x85, 0x02,           //           sta WSYNC
+    0x4c, 0x12, 0xf0,     //           jmp Frame
+    0xa9, 0x08,           // Start:    lda #$08
+    0x8d, 0x81, 0x02,     //           sta SWACNT
+    0xa9, 0x00,           //           lda #$00
+    0x8d, 0x81, 0x02,     //           sta SWACNT
+    0xa9, 0x04,           //           lda #$04
+    0x8d, 0x81, 0x02,     //           sta SWACNT
+    0xa9, 0x0c,           //           lda #$0c
+    0x8d, 0x81, 0x02,     //           sta SWACNT
+    0x60,                 //           rts
+    0xa9, 0x0c,           // Stop:     lda #$0c
+    0x8d, 0x81, 0x02,     //           sta SWACNT
+    0xa9, 0x04,           //           lda #$04
+    0x8d, 0x81, 0x02,     //           sta SWACNT
+    0xa9, 0x00,           //           lda #$00
+    0x8d, 0x81, 0x02,     //           sta SWACNT
+    0x60,                 //           rts
+    0x85, 0x82,           // Send:     sta byte
+    0xa2, 0x08,           //           ldx #8
+    0x06, 0x82,           // SendBit:  asl byte
+    0xa9, 0x0c,           //           lda #$0c
+    0x90, 0x02,           //           bcc SendLow
+    0xa9, 0x08,           //           lda #$08
+    0x8d, 0x81, 0x02,     // SendLow:  sta SWACNT
+    0x29, 0x07,           //           and #$07
+    0x8d, 0x81, 0x02,     //           sta SWACNT
+    0x09, 0x08,           //           ora #$08
+    0x8d, 0x81, 0x02,     //           sta SWACNT
+    0xca,                 //           dex
+    0xd0, 0xe8,           //           bne SendBit
+    0xa9, 0x08,           //           lda #$08
+    0x8d, 0x81, 0x02,     //           sta SWACNT
+    0xa9, 0x00,           //           lda #$00
+    0x8d, 0x81, 0x02,     //           sta SWACNT
+    0xa9, 0x08,           //           lda #$08
+    0x8d, 0x81, 0x02,     //           sta SWACNT
+    0x60,                 //           rts
+    0xa2, 0x08,           // Receive:  ldx #8
+    0xa9, 0x08,           // RecvBit:  lda #$08
+    0x8d, 0x81, 0x02,     //           sta SWACNT
+    0xa9, 0x00,           //           lda #$00
+    0x8d, 0x81, 0x02,     //           sta SWACNT
+    0xad, 0x80, 0x02,     //           lda SWCHA
+    0x4a,                 //           lsr
+    0x4a,                 //           lsr
+    0x4a,                 //           lsr
+    0x26, 0x81,           //           rol value
+    0xca,                 //           dex
+    0xd0, 0xeb,           //           bne RecvBit
+    0xa9, 0x08,           //           lda #$08
+    0x8d, 0x81, 0x02,     //           sta SWACNT
+    0xa9, 0x00,           //           lda #$00
+    0x8d, 0x81, 0x02,     //           sta SWACNT
+    0xa9, 0x08,           //           lda #$08
+    0x8d, 0x81, 0x02,     //           sta SWACNT
+    0x60,                 //           rts
+  };
+
+  struct IO: public ConsoleIO {
+    Controller& leftController() const override { return *myLeftControl; }
+    Controller& rightController() const override { return *myRightControl; }
+    Switches& switches() const override { return *mySwitches; }
+
+    unique_ptr<Controller> myLeftControl;
+    unique_ptr<Controller> myRightControl;
+    unique_ptr<Switches> mySwitches;
+  };
+
+  unique_ptr<Cartridge> createCartridge(const Settings& settings)
+  {
+    ByteBuffer buffer = make_unique<uInt8[]>(4_KB);
+    std::fill_n(buffer.get(), 4_KB, 0);
+    std::copy(CODE.begin(), CODE.end(), buffer.get());
+    // Reset and break vectors
+    buffer[0xffc] = buffer[0xffe] = 0x00;
+    buffer[0xffd] = buffer[0xfff] = 0xf0;
+
+    const RomImage image(std::move(buffer), 4_KB);
+
+    return make_unique<Cartridge4K>(image, 4_KB, MD5::hash(image.get(), 4_KB),
+                                    settings);
+  }
+
+  class Machine
+  {
+    public:
+      Machine()
+        : myCartridge(createCartridge(mySettings)),
+          myCpu(mySettings),
+          myRiot(myIO, mySettings),
+          myTia(myIO, []() { return ConsoleTiming::ntsc; }, mySettings),
+          mySystem(myRandom, myCpu, myRiot, myTia, *myCartridge)
+      {
+        // The EEPROM data is neither loaded from nor saved to a real file
+        myIO.myLeftControl = make_unique<Joystick>(Controller::Jack::Left, myEvent, mySystem);
+        myIO.myRightControl = make_unique<SaveKey>(Controller::Jack::Right, myEvent, mySystem,
+            FilesystemNode("/dev/null"), [](const string&) { });
+        myIO.mySwitches = make_unique<Switches>(myEvent, myProps, mySettings);
+
+        myTia.bindToControllers();
+        myCartridge->setStartBankFromPropsFunc([]() { return -1; });
+        mySystem.initialize();
+        myTia.setFrameManager(&myFrameManager);
+        mySystem.reset();
+      }
+
+      bool emulateFrame() { return RunAheadManager::emulateFrames(myTia, 1); }
+
+      // Run the given number of frames ahead on a second instance
+      bool runAhead(uInt32 frames)
+      {
+        if(!myInstance)
+        {
+          unique_ptr<Cartridge> cart = createCartridge(mySettings);
+          myInstance = make_unique<RunAheadInstance>(myIO,
+              []() { return ConsoleTiming::ntsc; }, mySettings, cart);
+        }
+
+        return myInstance->runAhead(mySystem, frames);
+      }
+
+      // Answer the state of the system, the controllers and the switches
+      vector<uInt8> state() const
+      {
+        Serializer out;
+        mySystem.save(out);
+        myIO.leftController().save(out);
+        myIO.rightController().save(out);
+        myIO.switches().save(out);
+
+        return vector<uInt8>(out.data(), out.data() + out.size());
+      }
+
+      uInt8 ram(uInt16 address) const { return myRiot.getRAM()[address & 0x7f]; }
+
+    private:
+      Settings mySettings;
+      Properties myProps;
+      Event myEvent;
+      IO myIO;
+      Random myRandom{0};
+
+      unique_ptr<Cartridge> myCartridge;
+      M6502 myCpu;
+      M6532 myRiot;
+      TIA myTia;
+      System mySystem;
+      FrameManager myFrameManager;
+
+      unique_ptr<RunAheadInstance> myInstance;
+  };
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+int main(int, char*[])
+{
+  vector<vector<uInt8>> expected;
+  {
+    Machine machine;
+    for(uInt32 frame = 1; frame <= FRAMES; ++frame)
+    {
+      Check::expect(machine.emulateFrame(), "no frame without run-ahead");
+      expected.push_back(machine.state());
+
+      // Make sure the ROM really uses the EEPROM
+      const uInt8 counter = machine.ram(0x80);
+      if(counter > 32 && counter % 2 == 1)
+        Check::expect(machine.ram(0x81) == uInt8(counter - 31),
+                      "EEPROM not read back at frame " + std::to_string(frame));
+    }
+  }
+
+  for(uInt32 frames = 1; frames <= RunAheadManager::MAX_FRAMES; ++frames)
+  {
+    Machine machine;
+    for(uInt32 frame = 0; frame < FRAMES; ++frame)
+    {
+      const string name = std::to_string(frames) + " frame(s) ahead, frame " +
+                          std::to_string(frame + 1);
+
+      Check::expect(machine.emulateFrame(), name + ": no frame");
+      if(!Check::expect(machine.state() == expected[frame],
+                        name + ": state differs from running without run-ahead"))
+        break;
+      Check::expect(machine.runAhead(frames), name + ": run-ahead failed");
+    }
+  }
+
+  return Check::result("RunAhead");
+}
@@ -0,0 +1,102 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2020 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+#include "Thumbulator.hxx"
+#include "Check.hxx"
+
+/**
+  Check that the block cache of the Thumbulator executes ARM code exactly
+  like the interpreter: after every block, the interpreter is advanced by
+  the same number of instructions, and the registers, flags and RAM of both
+  are compared.
+*/
+class ThumbulatorCheck
+{
+  public:
+    static void compare(const string& name, const vector<uInt16>& code)
+    {
+#ifndef UNSAFE_OPTIMIZATIONS
+      std::array<uInt16, 64> rom;
+      rom.fill(0);
+      vector<uInt16> blockRam(RAMSIZE / 2), stepRam(RAMSIZE / 2);
+      std::copy(code.begin(), code.end(), blockRam.begin());
+      std::copy(code.begin(), code.end(), stepRam.begin());
+
+      // The code runs from the start of the RAM, and ends by returning to
+      // ARM code at the base address
+      Thumbulator blocks(rom.data(), blockRam.data(), uInt32(rom.size() * 2),
+                         0, 0x40000000, 0x40007ff0, true, true,
+                         Thumbulator::ConfigureFor::DPCplus, nullptr);
+      Thumbulator steps(rom.data(), stepRam.data(), uInt32(rom.size() * 2),
+                        0, 0x40000000, 0x40007ff0, true, false,
+                        Thumbulator::ConfigureFor::DPCplus, nullptr);
+
+      for(uInt32 block = 0; block < 100; ++block)
+      {
+        const bool done = blocks.executeBlock();
+        bool stepsDone = false;
+        while(!stepsDone && steps.instructions < blocks.instructions)
+          stepsDone = steps.execute();
+
+        const string where = name + ", block " + std::to_string(block) +
+                             " ending at instruction " +
+                             std::to_string(blocks.instructions);
+        if(!(Check::expect(done == stepsDone, where + ": end of run differs") &&
+             Check::expect(blocks.reg_norm == steps.reg_norm, where + ": registers differ") &&
+             Check::expect(blocks.cpsr == steps.cpsr, where + ": flags differ") &&
+             Check::expect(blockRam == stepRam, where + ": RAM differs")) || done)
+          return;
+      }
+      Check::expect(false, name + ": code doesn't end");
+#endif
+    }
+};
+
+namespace {
+  // Overwrites an instruction of its own block after computing the carry,
+  // which is then overwritten by a later instruction of the block
+  const vector<uInt16> SELF_MODIFYING = {
+    0x2000,  // 00: movs r0, #0
+    0x43c0,  //     mvns r0, r0
+    0x2101,  //     movs r1, #1
+    0x2401,  //     movs r4, #1
+    0x07a4,  // 08: lsls r4, r4, #30      ; start of the RAM
+    0x8ba5,  //     ldrh r5, [r4, #0x1c]
+    0x1842,  //     adds r2, r0, r1       ; sets C
+    0x8265,  //     strh r5, [r4, #0x12]  ; ends the block
+    0x2600,  // 10: movs r6, #0
+    0x2700,  //     movs r7, #0           ; replaced by 'movs r7, #7'
+    0x4281,  //     cmp r1, r0            ; clears C
+    0x4770,  //     bx lr
+    0x0000,  // 18:
+    0x0000,  //
+    0x2707   // 1c: movs r7, #7
+  };
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+int main(int, char*[])
+{
+#ifndef UNSAFE_OPTIMIZATIONS
+  ThumbulatorCheck::compare("self-modifying code", SELF_MODIFYING);
+
+  return Check::result("Thumbulator");
+#else
+  cout << "Thumbulator: skipped (no block cache checks)" << endl;
+  return 0;
+#endif
+}
@@ -0,0 +1,232 @@
+/**
+  Decodes instruction traces saved by the 'tracelog' debugger command,
+  and compares two of them, showing where they start to differ.
+
+  The file format is described in 'src/debugger/TraceRecorder.hxx'.
+*/
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <fstream>
+#include <iostream>
+#include <string>
+using namespace std;
+
+using uInt8 = unsigned char;
+using uInt16 = unsigned short;
+using uInt32 = unsigned int;
+using uInt64 = unsigned long long;
+
+static constexpr size_t HEADER_SIZE = 24;
+static constexpr size_t RECORD_SIZE = 16;
+
+struct Record
+{
+  uInt64 cycles;
+  uInt16 pc, address;
+  uInt8 opcode, a, x, y, sp, ps, bank, data;
+};
+
+static uInt16 getShort(const uInt8* p)
+{
+  return uInt16(p[0] | (p[1] << 8));
+}
+
+static uInt32 getInt(const uInt8* p)
+{
+  return getShort(p) | (uInt32(getShort(p + 2)) << 16);
+}
+
+class TraceReader
+{
+  public:
+    bool open(const char* filename)
+    {
+      uInt8 header[HEADER_SIZE];
+
+      myName = filename;
+      myIn.open(filename, ios::binary);
+      if(!myIn.read(reinterpret_cast<char*>(header), HEADER_SIZE) ||
+         memcmp(header, "STLTRACE", 8) != 0)
+      {
+        cerr << filename << ": not a trace file" << endl;
+        return false;
+      }
+      if(getShort(header + 8) != 1 || getShort(header + 10) != RECORD_SIZE)
+      {
+        cerr << filename << ": unsupported trace version" << endl;
+        return false;
+      }
+      myCycles = getInt(header + 16) | (uInt64(getInt(header + 20)) << 32);
+
+      return true;
+    }
+
+    bool next(Record& r)
+    {
+      uInt8 p[RECORD_SIZE];
+
+      if(!myIn.read(reinterpret_cast<char*>(p), RECORD_SIZE))
+        return false;
+
+      // Only the low 32 bits of the cycle counter are stored
+      myCycles += uInt32(getInt(p) - uInt32(myCycles));
+      r.cycles = myCycles;
+      r.pc = getShort(p + 4);
+      r.opcode = p[6];
+      r.a = p[7];  r.x = p[8];  r.y = p[9];  r.sp = p[10];  r.ps = p[11];
+      r.bank = p[12];
+      r.data = p[13];
+      r.address = getShort(p + 14);
+
+      return true;
+    }
+
+    const string& name() const { return myName; }
+
+  private:
+    string myName;
+    ifstream myIn;
+    uInt64 myCycles{0};
+};
+
+static string format(const Record& r)
+{
+  char flags[9];
+  for(int i = 0; i < 8; ++i)
+    flags[i] = (r.ps & (0x80 >> i)) ? "NV-BDIZC"[i] : "nv-bdizc"[i];
+  flags[8] = 0;
+
+  char line[100];
+  snprintf(line, sizeof(line),
+           "%12llu  %04x  %3u  %02x  %02x %02x %02x %02x %s  %04x:%02x",
+           r.cycles, r.pc, r.bank, r.opcode, r.a, r.x, r.y, r.sp, flags,
+           r.address, r.data);
+
+  return line;
+}
+
+static const char* const HEADING =
+  "       cycle    PC bank  op   A  X  Y SP flags     bus";
+
+static string differences(const Record& r1, const Record& r2, bool cycles)
+{
+  string fields;
+  auto check = [&](bool differs, const char* name) {
+    if(differs)
+      fields += fields.empty() ? name : string(", ") + name;
+  };
+
+  check(cycles && r1.cycles != r2.cycles, "cycle");
+  check(r1.pc != r2.pc, "PC");
+  check(r1.bank != r2.bank, "bank");
+  check(r1.opcode != r2.opcode, "opcode");
+  check(r1.a != r2.a, "A");
+  check(r1.x != r2.x, "X");
+  check(r1.y != r2.y, "Y");
+  check(r1.sp != r2.sp, "SP");
+  check(r1.ps != r2.ps, "P");
+  check(r1.address != r2.address || r1.data != r2.data, "bus");
+
+  return fields;
+}
+
+static int decode(TraceReader& trace)
+{
+  Record r;
+
+  cout << HEADING << endl;
+  while(trace.next(r))
+    cout << format(r) << endl;
+
+  return 0;
+}
+
+static int compare(TraceReader& trace1, TraceReader& trace2,
+                   bool cycles, size_t context)
+{
+  deque<Record> previous;
+  Record r1, r2;
+  uInt64 count = 0;
+
+  for(;; ++count)
+  {
+    bool more1 = trace1.next(r1), more2 = trace2.next(r2);
+
+    if(!more1 && !more2)
+    {
+      cout << "traces are identical (" << count << " instructions)" << endl;
+      return 0;
+    }
+    if(!more1 || !more2)
+    {
+      cout << (more1 ? trace2 : trace1).name() << " ends after "
+           << count << " instructions" << endl;
+      return 1;
+    }
+
+    const string fields = differences(r1, r2, cycles);
+    if(!fields.empty())
+    {
+      cout << "traces differ at instruction " << count
+           << " (" << fields << ")" << endl << endl
+           << "  " << HEADING << endl;
+      for(const auto& r: previous)
+        cout << "  " << format(r) << endl;
+      cout << "< " << format(r1) << endl
+           << "> " << format(r2) << endl;
+      return 1;
+    }
+
+    if(context > 0)
+    {
+      if(previous.size() == context)
+        previous.pop_front();
+      previous.push_back(r1);
+    }
+  }
+}
+
+int main(int ac, char* av[])
+{
+  bool cycles = true;
+  size_t context = 10;
+  int arg = 1;
+
+  for(; arg < ac && av[arg][0] == '-'; ++arg)
+  {
+    if(strcmp(av[arg], "-c") == 0)
+      cycles = false;
+    else if(strcmp(av[arg], "-n") == 0 && arg + 1 < ac)
+      context = strtoul(av[++arg], nullptr, 10);
+    else
+      break;
+  }
+
+  const int files = ac - arg;
+  if(files < 1 || files > 2)
+  {
+    cout << av[0] << " [-c] [-n LINES] <TRACE_FILE> [OTHER_TRACE_FILE]" << endl
+         << endl
+         << "  Decode TRACE_FILE (saved by the debugger 'tracelog' command)" << endl
+         << "  to standard output, or compare it to OTHER_TRACE_FILE and show" << endl
+         << "  the first instruction at which they differ." << endl
+         << endl
+         << "  -c        ignore the cycle counters when comparing" << endl
+         << "  -n LINES  number of preceding instructions shown (default 10)" << endl
+         << endl;
+    return 0;
+  }
+
+  TraceReader trace1, trace2;
+  if(!trace1.open(av[arg]))
+    return 2;
+  if(files == 1)
+    return decode(trace1);
+
+  if(!trace2.open(av[arg + 1]))
+    return 2;
+  return compare(trace1, trace2, cycles, context);
+}
@@ -21,8 +21,26 @@
   #define ROOT_DIR "/"
 #endif
 
+#include <fcntl.h>
+#include <sys/mman.h>
+
 #include "FSNodePOSIX.hxx"
 
+namespace {
+  // A file mapped into memory with mmap()
+  class FileMappingPOSIX : public FileMapping
+  {
+    public:
+      FileMappingPOSIX(void* data, size_t size) {
+        myData = static_cast<const uInt8*>(data);
+        mySize = size;
+      }
+      ~FileMappingPOSIX() override {
+        munmap(const_cast<uInt8*>(myData), mySize);
+      }
+  };
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 FilesystemNodePOSIX::FilesystemNodePOSIX()
   : _path(ROOT_DIR),
@@ -203,6 +221,44 @@ bool FilesystemNodePOSIX::makeDir()
     return false;
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool FilesystemNodePOSIX::getSizeAndTime(size_t& size, uInt64& mtime) const
+{
+  struct stat st;
+  if(stat(_path.c_str(), &st) != 0)
+    return false;
+
+  // Use the full resolution of the timestamp, so that a file rewritten
+  // within the same second still counts as changed
+  size = st.st_size;
+#if defined(__APPLE__)
+  mtime = uInt64(st.st_mtimespec.tv_sec) * 1000000000 + st.st_mtimespec.tv_nsec;
+#else
+  mtime = uInt64(st.st_mtim.tv_sec) * 1000000000 + st.st_mtim.tv_nsec;
+#endif
+  return true;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+FileMappingPtr FilesystemNodePOSIX::map() const
+{
+  const int fd = open(_path.c_str(), O_RDONLY);
+  if(fd < 0)
+    return nullptr;
+
+  // The mapping stays valid after the file is closed
+  struct stat st;
+  void* data = MAP_FAILED;
+  if(fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0)
+    data = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+
+  if(data == MAP_FAILED)
+    return nullptr;
+
+  return make_shared<FileMappingPOSIX>(data, st.st_size);
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 bool FilesystemNodePOSIX::rename(const string& newfile)
 {
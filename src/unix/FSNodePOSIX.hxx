@@ -72,6 +72,8 @@ class FilesystemNodePOSIX : public AbstractFSNode
     bool isWritable() const override  { return access(_path.c_str(), W_OK) == 0; }
     bool makeDir() override;
     bool rename(const string& newfile) override;
+    bool getSizeAndTime(size_t& size, uInt64& mtime) const override;
+    FileMappingPtr map() const override;
 
     bool getChildren(AbstractFSList& list, ListMode mode) const override;
     AbstractFSNodePtr getParent() const override;
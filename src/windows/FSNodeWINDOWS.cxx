@@ -39,6 +39,21 @@
 #include "Windows.hxx"
 #include "FSNodeWINDOWS.hxx"
 
+namespace {
+  // A file mapped into memory with MapViewOfFile()
+  class FileMappingWINDOWS : public FileMapping
+  {
+    public:
+      FileMappingWINDOWS(const void* data, size_t size) {
+        myData = static_cast<const uInt8*>(data);
+        mySize = size;
+      }
+      ~FileMappingWINDOWS() override {
+        UnmapViewOfFile(myData);
+      }
+  };
+}
+
 /**
  * Returns the last component of a given path.
  *
@@ -267,6 +282,51 @@ bool FilesystemNodeWINDOWS::makeDir()
     return false;
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool FilesystemNodeWINDOWS::getSizeAndTime(size_t& size, uInt64& mtime) const
+{
+  WIN32_FILE_ATTRIBUTE_DATA data;
+  if(_isPseudoRoot ||
+     !GetFileAttributesEx(toUnicode(_path.c_str()), GetFileExInfoStandard, &data))
+    return false;
+
+  size = (static_cast<uInt64>(data.nFileSizeHigh) << 32) | data.nFileSizeLow;
+  mtime = (static_cast<uInt64>(data.ftLastWriteTime.dwHighDateTime) << 32) |
+          data.ftLastWriteTime.dwLowDateTime;
+  return true;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+FileMappingPtr FilesystemNodeWINDOWS::map() const
+{
+  if(_isPseudoRoot)
+    return nullptr;
+
+  HANDLE file = CreateFileA(_path.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL,
+                            OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+  if(file == INVALID_HANDLE_VALUE)
+    return nullptr;
+
+  // The view stays valid after both handles are closed
+  LARGE_INTEGER size;
+  const void* data = nullptr;
+  if(GetFileSizeEx(file, &size) && size.QuadPart > 0)
+  {
+    HANDLE mapping = CreateFileMapping(file, NULL, PAGE_READONLY, 0, 0, NULL);
+    if(mapping != NULL)
+    {
+      data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+      CloseHandle(mapping);
+    }
+  }
+  CloseHandle(file);
+
+  if(data == nullptr)
+    return nullptr;
+
+  return make_shared<FileMappingWINDOWS>(data, size_t(size.QuadPart));
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 bool FilesystemNodeWINDOWS::rename(const string& newfile)
 {
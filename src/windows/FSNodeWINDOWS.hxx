@@ -69,6 +69,8 @@ class FilesystemNodeWINDOWS : public AbstractFSNode
     bool isWritable() const override;
     bool makeDir() override;
     bool rename(const string& newfile) override;
+    bool getSizeAndTime(size_t& size, uInt64& mtime) const override;
+    FileMappingPtr map() const override;
 
     bool getChildren(AbstractFSList& list, ListMode mode) const override;
     AbstractFSNodePtr getParent() const override;